@@ -0,0 +1,333 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//==============================================================================
+// QuantumPerfCompare
+//
+// Compares the median results of a QuantumBenchmarks run written in CSV format
+// against a baseline and prints the deltas. Throughput is compared when the
+// benchmark reports items per second, and real time otherwise.
+//
+// Usage: QuantumPerfCompare --results <csv> --baseline <csv> --suite <name>
+//                           [--tolerance <percent>] [--gate] [--update]
+//
+// Baseline files have one 'suite,name,metric,value[,tolerance]' line per
+// benchmark, where the optional tolerance in percent overrides the default.
+// With --update, the rows of the suite are replaced with the results instead.
+//==============================================================================
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* medianSuffix = "_median";
+
+struct Entry
+{
+    std::string _suite;
+    std::string _name;
+    std::string _metric;    // "items/s" (higher is better) or "ns" (lower is better)
+    double      _value{0};
+    double      _tolerance{-1}; // percent, negative for the default
+};
+
+std::vector<std::string> splitCsv(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    bool isQuoted = false;
+    for (char c : line)
+    {
+        if (c == '"')
+        {
+            isQuoted = !isQuoted;
+        }
+        else if ((c == ',') && !isQuoted)
+        {
+            fields.emplace_back();
+        }
+        else if ((c != '\r') && (c != '\n'))
+        {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+double toNanoseconds(double value, const std::string& unit)
+{
+    if (unit == "us") return value * 1e3;
+    if (unit == "ms") return value * 1e6;
+    if (unit == "s") return value * 1e9;
+    return value;
+}
+
+/// @brief Reads the median rows of a Google Benchmark CSV output, skipping the context lines before the header.
+std::vector<Entry> readResults(const std::string& fileName, const std::string& suite)
+{
+    std::ifstream file(fileName);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open results file '" + fileName + "'");
+    }
+    std::vector<Entry> results;
+    std::map<std::string, size_t> columns;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> fields = splitCsv(line);
+        if (columns.empty())
+        {
+            if (fields[0] == "name")
+            {
+                for (size_t i = 0; i < fields.size(); ++i)
+                {
+                    columns[fields[i]] = i;
+                }
+            }
+            continue;
+        }
+        auto field = [&fields, &columns](const char* column)->std::string
+        {
+            auto it = columns.find(column);
+            return ((it != columns.end()) && (it->second < fields.size())) ? fields[it->second] : std::string();
+        };
+        const std::string& name = fields[0];
+        size_t suffixPos = name.size() - std::min(name.size(), std::string(medianSuffix).size());
+        if ((name.compare(suffixPos, std::string::npos, medianSuffix) != 0) || !field("error_occurred").empty())
+        {
+            continue;
+        }
+        Entry entry;
+        entry._suite = suite;
+        entry._name = name.substr(0, suffixPos);
+        if (!field("items_per_second").empty())
+        {
+            entry._metric = "items/s";
+            entry._value = std::stod(field("items_per_second"));
+        }
+        else
+        {
+            entry._metric = "ns";
+            entry._value = toNanoseconds(std::stod(field("real_time")), field("time_unit"));
+        }
+        results.push_back(entry);
+    }
+    if (columns.empty())
+    {
+        throw std::runtime_error("No benchmark results found in '" + fileName + "'");
+    }
+    return results;
+}
+
+std::vector<Entry> readBaseline(const std::string& fileName)
+{
+    std::vector<Entry> baseline;
+    std::ifstream file(fileName);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || (line[0] == '#'))
+        {
+            continue;
+        }
+        std::vector<std::string> fields = splitCsv(line);
+        if (fields.size() < 4)
+        {
+            throw std::runtime_error("Invalid baseline line '" + line + "'");
+        }
+        Entry entry;
+        entry._suite = fields[0];
+        entry._name = fields[1];
+        entry._metric = fields[2];
+        entry._value = std::stod(fields[3]);
+        if ((fields.size() > 4) && !fields[4].empty())
+        {
+            entry._tolerance = std::stod(fields[4]);
+        }
+        baseline.push_back(entry);
+    }
+    return baseline;
+}
+
+void writeBaseline(const std::string& fileName, const std::vector<Entry>& baseline)
+{
+    std::ofstream file(fileName);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot write baseline file '" + fileName + "'");
+    }
+    file << "# Generated by the update_perf_baseline target. Columns: suite,name,metric,value[,tolerance percent]"
+         << std::endl;
+    file << std::setprecision(6);
+    for (const Entry& entry : baseline)
+    {
+        file << entry._suite << ",\"" << entry._name << "\"," << entry._metric << "," << entry._value << ",";
+        if (entry._tolerance >= 0)
+        {
+            file << entry._tolerance;
+        }
+        file << std::endl;
+    }
+}
+
+int update(const std::string& baselineFile, const std::string& suite, const std::vector<Entry>& results)
+{
+    std::vector<Entry> baseline;
+    std::map<std::string, double> tolerances;
+    for (const Entry& entry : readBaseline(baselineFile))
+    {
+        if (entry._suite != suite)
+        {
+            baseline.push_back(entry);
+        }
+        else
+        {
+            tolerances[entry._name] = entry._tolerance;
+        }
+    }
+    for (Entry entry : results)
+    {
+        auto it = tolerances.find(entry._name);
+        entry._tolerance = (it != tolerances.end()) ? it->second : -1; //keep hand-tuned tolerances
+        baseline.push_back(entry);
+    }
+    writeBaseline(baselineFile, baseline);
+    std::cout << "Updated " << results.size() << " '" << suite << "' entries in " << baselineFile << std::endl;
+    return 0;
+}
+
+int compare(const std::string& baselineFile,
+            const std::string& suite,
+            const std::vector<Entry>& results,
+            double defaultTolerance,
+            bool isGating)
+{
+    std::map<std::string, const Entry*> current;
+    for (const Entry& entry : results)
+    {
+        current[entry._name] = &entry;
+    }
+    std::vector<Entry> baseline = readBaseline(baselineFile);
+    std::map<std::string, int> counts;
+    std::ostream& out = std::cout;
+    out << "Performance suite '" << suite << "' against " << baselineFile
+        << " (default tolerance " << defaultTolerance << "%"
+        << (isGating ? ", gating" : ", not gating") << ")" << std::endl;
+    out << std::left << std::setw(48) << "benchmark" << std::right
+        << std::setw(9) << "metric" << std::setw(14) << "baseline" << std::setw(14) << "current"
+        << std::setw(10) << "delta" << std::setw(11) << "tolerance" << "  status" << std::endl;
+    out << std::fixed;
+    for (const Entry& expected : baseline)
+    {
+        if (expected._suite != suite)
+        {
+            continue;
+        }
+        out << std::left << std::setw(48) << expected._name << std::right << std::setw(9) << expected._metric
+            << std::setprecision(1) << std::setw(14) << expected._value;
+        auto it = current.find(expected._name);
+        if ((it == current.end()) || (it->second->_metric != expected._metric))
+        {
+            out << std::setw(14) << "-" << std::setw(10) << "-" << std::setw(11) << "-" << "  MISSING" << std::endl;
+            ++counts["missing"];
+            continue;
+        }
+        const Entry& actual = *it->second;
+        current.erase(it);
+        double tolerance = (expected._tolerance >= 0) ? expected._tolerance : defaultTolerance;
+        double delta = (expected._value != 0) ? 100 * (actual._value - expected._value) / expected._value : 0;
+        //positive when better
+        double gain = (expected._metric == "ns") ? -delta : delta;
+        const char* status = (gain < -tolerance) ? "REGRESSED" : (gain > tolerance) ? "improved" : "ok";
+        ++counts[status];
+        out << std::setw(14) << actual._value
+            << std::setw(9) << std::showpos << delta << std::noshowpos << "%"
+            << std::setprecision(0) << std::setw(10) << tolerance << "%"
+            << "  " << status << std::endl;
+    }
+    for (auto&& entry : current)
+    {
+        out << std::left << std::setw(48) << entry.first << std::right << std::setw(9) << entry.second->_metric
+            << std::setw(14) << "-" << std::setprecision(1) << std::setw(14) << entry.second->_value
+            << std::setw(10) << "-" << std::setw(11) << "-" << "  new" << std::endl;
+        ++counts["new"];
+    }
+    out << "Summary: " << counts["ok"] << " ok, " << counts["improved"] << " improved, "
+        << counts["REGRESSED"] << " regressed, " << counts["missing"] << " missing, "
+        << counts["new"] << " new" << std::endl;
+    if (counts["improved"] > 0)
+    {
+        out << "Consider refreshing the baseline with 'make update_perf_baseline'." << std::endl;
+    }
+    return (isGating && ((counts["REGRESSED"] > 0) || (counts["missing"] > 0))) ? 1 : 0;
+}
+
+void usage(std::ostream& out)
+{
+    out << "Usage: QuantumPerfCompare --results <csv> --baseline <csv> --suite <name> "
+           "[--tolerance <percent>] [--gate] [--update]" << std::endl;
+}
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+    std::string resultsFile, baselineFile, suite;
+    double tolerance = 30;
+    bool isGating = false;
+    bool isUpdate = false;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto value = [&]()->std::string
+            {
+                if (++i >= argc)
+                {
+                    throw std::invalid_argument("Missing value for " + arg);
+                }
+                return argv[i];
+            };
+            if (arg == "--results") resultsFile = value();
+            else if (arg == "--baseline") baselineFile = value();
+            else if (arg == "--suite") suite = value();
+            else if (arg == "--tolerance") tolerance = std::stod(value());
+            else if (arg == "--gate") isGating = true;
+            else if (arg == "--update") isUpdate = true;
+            else throw std::invalid_argument("Unknown argument " + arg);
+        }
+        if (resultsFile.empty() || baselineFile.empty() || suite.empty())
+        {
+            throw std::invalid_argument("Missing arguments");
+        }
+        std::vector<Entry> results = readResults(resultsFile, suite);
+        return isUpdate ? update(baselineFile, suite, results) :
+                          compare(baselineFile, suite, results, tolerance, isGating);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        usage(std::cerr);
+        return 2;
+    }
+}
@@ -0,0 +1,42 @@
+# Runs a subset of QuantumBenchmarks and compares the medians against the baseline.
+# Invoked by ctest (label 'perf') and by the update_perf_baseline target with:
+#   -DBENCHMARK=<QuantumBenchmarks executable>
+#   -DCOMPARE=<QuantumPerfCompare executable>
+#   -DSUITE=<suite name>
+#   -DFILTER=<benchmark filter regex>
+#   -DOUTPUT=<results csv file>
+#   -DBASELINE=<baseline csv file>
+#   -DTOLERANCE=<default tolerance in percent>
+#   -DGATE=<ON|OFF>
+#   -DUPDATE=<ON|OFF>
+foreach(var BENCHMARK COMPARE SUITE FILTER OUTPUT BASELINE TOLERANCE)
+    if (NOT DEFINED ${var})
+        message(FATAL_ERROR "${var} is not defined")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${BENCHMARK}
+            --benchmark_filter=${FILTER}
+            --benchmark_min_time=0.1
+            --benchmark_repetitions=3
+            --benchmark_report_aggregates_only=true
+            --benchmark_out=${OUTPUT}
+            --benchmark_out_format=csv
+    OUTPUT_QUIET
+    RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${BENCHMARK} failed: ${result}")
+endif()
+
+set(options --results ${OUTPUT} --baseline ${BASELINE} --suite ${SUITE} --tolerance ${TOLERANCE})
+if (GATE)
+    list(APPEND options --gate)
+endif()
+if (UPDATE)
+    list(APPEND options --update)
+endif()
+execute_process(COMMAND ${COMPARE} ${options} RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "Performance suite '${SUITE}' is outside of the baseline tolerance")
+endif()
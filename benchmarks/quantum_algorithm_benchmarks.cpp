@@ -0,0 +1,169 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#include <quantum_benchmark_fixture.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace quantum;
+
+//==============================================================================
+// FOREACH
+//==============================================================================
+
+// Scaling of forEach() and parallelFor() with the number of coroutine threads. forEach() posts one coroutine
+// per element hence the smaller input.
+static void BM_ForEach(benchmark::State& state)
+{
+    const size_t num = 1 << 12;
+    auto dispatcher = makeDispatcher((int)state.range(0));
+    std::vector<double> input(num);
+    std::iota(input.begin(), input.end(), 0.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dispatcher->forEach(input.cbegin(), input.cend(),
+            [](VoidContextPtr, double value)->double {
+            return std::sqrt(value);
+        })->get());
+    }
+    state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_ForEach)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+static void BM_ParallelFor(benchmark::State& state)
+{
+    const size_t num = 1 << 16;
+    auto dispatcher = makeDispatcher((int)state.range(0));
+    std::vector<double> input(num);
+    std::iota(input.begin(), input.end(), 0.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dispatcher->parallelFor(input.cbegin(), input.cend(),
+            [](VoidContextPtr, double value)->double {
+            return std::sqrt(value);
+        })->get());
+    }
+    state.SetItemsProcessed(state.iterations() * num);
+}
+BENCHMARK(BM_ParallelFor)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+//==============================================================================
+// PARALLEL FOR 2D
+//==============================================================================
+
+// Out-of-place transpose of a size x size matrix. Reading rows while writing columns misses the cache on every
+// write once a column no longer fits, which is what tiling is meant to avoid.
+static void transposeTile(const std::vector<float>& in, std::vector<float>& out, size_t size, const Tile2D& tile)
+{
+    for (size_t row = tile.rowBegin; row < tile.rowEnd; ++row) {
+        for (size_t col = tile.colBegin; col < tile.colEnd; ++col) {
+            out[col * size + row] = in[row * size + col];
+        }
+    }
+}
+
+// Baseline for BM_ParallelFor2D: forEachBatch() over the rows, i.e. one untiled band of rows per coroutine thread
+static void BM_TransposeRows(benchmark::State& state)
+{
+    const size_t size = (size_t)state.range(0);
+    auto dispatcher = makeDispatcher(4);
+    std::vector<float> in(size * size, 1.0f), out(size * size);
+    std::vector<size_t> rows(size);
+    std::iota(rows.begin(), rows.end(), 0);
+    for (auto _ : state) {
+        dispatcher->forEachBatch(rows.cbegin(), rows.cend(), [&](VoidContextPtr, size_t row)->int {
+            transposeTile(in, out, size, Tile2D{row, row + 1, 0, size});
+            return 0;
+        })->get();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_TransposeRows)
+    ->ArgNames({"size"})
+    ->RangeMultiplier(4)->Range(256, 4096)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// parallelFor2D() on 4 coroutine threads across grid sizes and square tile sizes
+static void BM_ParallelFor2D(benchmark::State& state)
+{
+    const size_t size = (size_t)state.range(0);
+    const size_t tileSize = (size_t)state.range(1);
+    auto dispatcher = makeDispatcher(4);
+    std::vector<float> in(size * size, 1.0f), out(size * size);
+    for (auto _ : state) {
+        dispatcher->parallelFor2D(size, size, tileSize, tileSize, [&](VoidContextPtr, const Tile2D& tile) {
+            transposeTile(in, out, size, tile);
+        })->get();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_ParallelFor2D)
+    ->ArgNames({"size", "tile"})
+    ->ArgsProduct({{256, 1024, 4096}, {16, 32, 64, 128}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//==============================================================================
+// SORT
+//==============================================================================
+
+static std::vector<int> makeSortInput(size_t num)
+{
+    std::mt19937 generator(12345);
+    std::vector<int> input(num);
+    for (auto&& value : input) {
+        value = (int)generator();
+    }
+    return input;
+}
+
+// Baseline for BM_Sort
+static void BM_StdSort(benchmark::State& state)
+{
+    const std::vector<int> input = makeSortInput((size_t)state.range(0));
+    std::vector<int> data;
+    for (auto _ : state) {
+        state.PauseTiming();
+        data = input;
+        state.ResumeTiming();
+        std::sort(data.begin(), data.end());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdSort)->Arg(1 << 20)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Dispatcher::sort() on 1 to 64 coroutine threads
+static void BM_Sort(benchmark::State& state)
+{
+    const std::vector<int> input = makeSortInput((size_t)state.range(0));
+    auto dispatcher = makeDispatcher((int)state.range(1));
+    std::vector<int> data;
+    for (auto _ : state) {
+        state.PauseTiming();
+        data = input;
+        state.ResumeTiming();
+        dispatcher->sort(data.begin(), data.end())->get();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Sort)
+    ->ArgNames({"size", "threads"})
+    ->ArgsProduct({{1 << 20}, {1, 2, 4, 8, 16, 32, 64}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,38 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_BENCHMARK_FIXTURE_H
+#define BLOOMBERG_QUANTUM_BENCHMARK_FIXTURE_H
+
+#include <benchmark/benchmark.h>
+#include <quantum/quantum.h>
+#include <memory>
+
+namespace quantum = Bloomberg::quantum;
+
+/// @brief Creates a dispatcher for a single benchmark run. Each benchmark owns its dispatcher so that thread
+///        counts can vary between runs and all threads are joined before the next benchmark starts.
+/// @param[in] numCoro The number of coroutine threads. All of them are covered by IQueue::QueueId::Any.
+/// @param[in] numIo The number of IO threads.
+inline
+std::unique_ptr<quantum::Dispatcher> makeDispatcher(int numCoro, int numIo = 1)
+{
+    quantum::Configuration config;
+    config.setNumCoroutineThreads(numCoro);
+    config.setNumIoThreads(numIo);
+    return std::unique_ptr<quantum::Dispatcher>(new quantum::Dispatcher(config));
+}
+
+#endif //BLOOMBERG_QUANTUM_BENCHMARK_FIXTURE_H
@@ -0,0 +1,273 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#include <quantum_benchmark_fixture.h>
+#include <atomic>
+#include <vector>
+
+using namespace quantum;
+
+//==============================================================================
+// DISPATCH
+//==============================================================================
+
+static std::unique_ptr<Dispatcher> sharedDispatcher;
+constexpr size_t postBatch = 256;
+
+// Posting throughput from one or more producer threads into 4 coroutine threads
+static void BM_PostThroughput(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        sharedDispatcher = makeDispatcher(4);
+    }
+    std::vector<ThreadContextPtr<int>> contexts;
+    contexts.reserve(postBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < postBatch; ++i) {
+            contexts.emplace_back(sharedDispatcher->post([](VoidContextPtr)->int { return 0; }));
+        }
+        for (auto&& ctx : contexts) {
+            ctx->wait();
+        }
+        contexts.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * postBatch);
+    if (state.thread_index() == 0) {
+        sharedDispatcher.reset();
+    }
+}
+BENCHMARK(BM_PostThroughput)->ThreadRange(1, 8)->UseRealTime();
+
+// Round trip of a single task: post, run, set the shared state and wake up the waiting thread
+static void BM_PostLatency(benchmark::State& state)
+{
+    auto dispatcher = makeDispatcher(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dispatcher->post([](VoidContextPtr)->int { return 0; })->get());
+    }
+}
+BENCHMARK(BM_PostLatency)->UseRealTime();
+
+// Same as BM_PostThroughput from a single producer with run-to-completion tasks which need no coroutine stack
+static void BM_PostLiteThroughput(benchmark::State& state)
+{
+    auto dispatcher = makeDispatcher(4);
+    std::vector<ThreadFuturePtr<int>> futures;
+    futures.reserve(postBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < postBatch; ++i) {
+            futures.emplace_back(dispatcher->postLite2([]()->int { return 0; }));
+        }
+        for (auto&& future : futures) {
+            future->wait();
+        }
+        futures.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * postBatch);
+}
+BENCHMARK(BM_PostLiteThroughput)->UseRealTime();
+
+// Same as BM_PostThroughput into a single coroutine thread with a new coroutine per task (0) or pooled coroutines (1)
+static void BM_CoroutineReuse(benchmark::State& state)
+{
+    quantum::Configuration config;
+    config.setNumCoroutineThreads(1);
+    config.setNumIoThreads(1);
+    config.setReuseCoroutines(state.range(0) != 0);
+    Dispatcher dispatcher(config);
+    std::vector<ThreadContextPtr<int>> contexts;
+    contexts.reserve(postBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < postBatch; ++i) {
+            contexts.emplace_back(dispatcher.post([](VoidContextPtr)->int { return 0; }));
+        }
+        for (auto&& ctx : contexts) {
+            ctx->wait();
+        }
+        contexts.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * postBatch);
+}
+BENCHMARK(BM_CoroutineReuse)->Arg(0)->Arg(1)->UseRealTime();
+
+// IO task dispatch at varying number of IO threads
+static void BM_PostAsyncIo(benchmark::State& state)
+{
+    auto dispatcher = makeDispatcher(1, (int)state.range(0));
+    std::vector<ThreadFuturePtr<int>> futures;
+    futures.reserve(postBatch);
+    for (auto _ : state) {
+        for (size_t i = 0; i < postBatch; ++i) {
+            futures.emplace_back(dispatcher->postAsyncIo([]()->int { return 0; }));
+        }
+        for (auto&& future : futures) {
+            future->wait();
+        }
+        futures.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * postBatch);
+}
+BENCHMARK(BM_PostAsyncIo)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+//==============================================================================
+// COROUTINES
+//==============================================================================
+
+// Cost of suspending a coroutine and resuming it from the scheduler
+static void BM_YieldResume(benchmark::State& state)
+{
+    const int numYields = 1000;
+    auto dispatcher = makeDispatcher(1);
+    for (auto _ : state) {
+        dispatcher->post([numYields](VoidContextPtr ctx)->int {
+            for (int i = 0; i < numYields; ++i) {
+                ctx->yield();
+            }
+            return 0;
+        })->get();
+    }
+    state.SetItemsProcessed(state.iterations() * numYields);
+}
+BENCHMARK(BM_YieldResume)->UseRealTime();
+
+//==============================================================================
+// SHARED STATE
+//==============================================================================
+
+// Uncontended set/get of a promise from the same thread
+static void BM_PromiseSetGet(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto promise = PromisePtr<int>(new Promise<int>(), Promise<int>::deleter);
+        auto future = promise->getIThreadFuture();
+        promise->set(1);
+        benchmark::DoNotOptimize(future->get());
+    }
+}
+BENCHMARK(BM_PromiseSetGet);
+
+// Value handoff between coroutines on different threads through a buffered promise
+static void BM_FutureHandoff(benchmark::State& state)
+{
+    const int numValues = 1000;
+    auto dispatcher = makeDispatcher(2);
+    for (auto _ : state) {
+        auto promise = std::make_shared<Promise<Buffer<int>>>();
+        auto consumer = dispatcher->post(0, false, [promise](VoidContextPtr ctx)->int {
+            auto future = promise->getICoroFuture();
+            bool isBufferClosed = false;
+            int sum = 0;
+            while (true) {
+                int value = future->pull(ctx, isBufferClosed);
+                if (isBufferClosed) {
+                    break;
+                }
+                sum += value;
+            }
+            return sum;
+        });
+        dispatcher->post(1, false, [promise, numValues](VoidContextPtr ctx)->int {
+            for (int i = 0; i < numValues; ++i) {
+                promise->push(ctx, i);
+            }
+            return promise->closeBuffer();
+        });
+        benchmark::DoNotOptimize(consumer->get());
+    }
+    state.SetItemsProcessed(state.iterations() * numValues);
+}
+BENCHMARK(BM_FutureHandoff)->UseRealTime();
+
+// Same value stream as BM_FutureHandoff produced by a generator and consumed on the same thread
+static void BM_GeneratorStream(benchmark::State& state)
+{
+    const int numValues = 1000;
+    for (auto _ : state) {
+        Generator<int> generator([numValues](Generator<int>::Yield& yield) {
+            for (int i = 0; i < numValues; ++i) {
+                yield(i);
+            }
+        });
+        int sum = 0;
+        for (int value : generator) {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numValues);
+}
+BENCHMARK(BM_GeneratorStream);
+
+//==============================================================================
+// MUTEX
+//==============================================================================
+
+// Coroutines contending on a single quantum::Mutex across 4 coroutine threads
+static void BM_MutexContention(benchmark::State& state)
+{
+    const int numLocks = 1000;
+    const int numCoroutines = (int)state.range(0);
+    auto dispatcher = makeDispatcher(4);
+    Mutex mutex;
+    long counter = 0;
+    std::vector<ThreadContextPtr<int>> contexts;
+    for (auto _ : state) {
+        for (int c = 0; c < numCoroutines; ++c) {
+            contexts.emplace_back(dispatcher->post([&](VoidContextPtr ctx)->int {
+                for (int i = 0; i < numLocks; ++i) {
+                    Mutex::Guard guard(ctx, mutex);
+                    ++counter;
+                }
+                return 0;
+            }));
+        }
+        for (auto&& ctx : contexts) {
+            ctx->wait();
+        }
+        contexts.clear();
+    }
+    benchmark::DoNotOptimize(counter);
+    state.SetItemsProcessed(state.iterations() * numCoroutines * numLocks);
+}
+BENCHMARK(BM_MutexContention)->RangeMultiplier(4)->Range(1, 64)->UseRealTime();
+
+//==============================================================================
+// CORO-LOCAL STORAGE
+//==============================================================================
+
+// Reading a coro-local-variable by name, the key being built from a literal on each access
+static void BM_LocalVariableByName(benchmark::State& state)
+{
+    int value = 0;
+    local::variable<int>("benchmarkVariable") = &value;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(local::variable<int>("benchmarkVariable"));
+    }
+    local::variable<int>("benchmarkVariable") = nullptr;
+}
+BENCHMARK(BM_LocalVariableByName);
+
+// Reading a coro-local-variable through a slot registered once
+static void BM_LocalVariableBySlot(benchmark::State& state)
+{
+    static const local::Slot slot = local::registerSlot("benchmarkVariable");
+    int value = 0;
+    local::set(slot, &value);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(local::get<int>(slot));
+    }
+    local::set<int>(slot, nullptr);
+}
+BENCHMARK(BM_LocalVariableBySlot);
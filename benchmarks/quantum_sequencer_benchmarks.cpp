@@ -0,0 +1,49 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#include <quantum_benchmark_fixture.h>
+#include <atomic>
+#include <thread>
+
+using namespace quantum;
+
+//==============================================================================
+// SEQUENCER
+//==============================================================================
+
+// Enqueue and completion throughput at varying number of distinct sequence keys. A single key serializes all
+// tasks while a large number of keys lets them run concurrently but grows the sequencer bookkeeping.
+static void BM_SequencerEnqueue(benchmark::State& state)
+{
+    const int numTasks = 1024;
+    const int numKeys = (int)state.range(0);
+    auto dispatcher = makeDispatcher(4);
+    Sequencer<int> sequencer(*dispatcher);
+    std::atomic<int> completed{0};
+    for (auto _ : state) {
+        completed = 0;
+        for (int i = 0; i < numTasks; ++i) {
+            sequencer.enqueue(i % numKeys, [&completed](VoidContextPtr)->int {
+                ++completed;
+                return 0;
+            });
+        }
+        while (completed < numTasks) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numTasks);
+}
+BENCHMARK(BM_SequencerEnqueue)->RangeMultiplier(16)->Range(1, 4096)->UseRealTime();
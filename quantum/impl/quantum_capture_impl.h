@@ -81,11 +81,12 @@ Function<RET(ARGS...)>::operator=(Function<RET(ARGS...)>&& other)
         _invoker = other._invoker;
         _destructor = other._destructor;
         _deleter = other._deleter;
+        _mover = other._mover;
         if (other._callable == other._storage.data()) {
-            //copy byte-wise data
-            //Note that in this case the destructor will be called on a seemingly different object than the constructor
-            //however this is valid.
-            _storage = other._storage;
+            //move the functor into the local buffer since it may not be trivially relocatable
+            //(e.g. it captures a std::string using the small string optimization)
+            _mover(_storage.data(), other._callable);
+            other._destructor(other._callable);
             _callable = _storage.data();
         }
         else {
@@ -134,6 +135,9 @@ void Function<RET(ARGS...)>::initFunctor(FUNCTOR&& functor, std::false_type)
     if (sizeof(FUNCTOR) <= size) {
         new (_storage.data()) FUNCTOR(std::forward<FUNCTOR>(functor));
         _callable = _storage.data();
+        _mover = [](void* dest, void* src){
+            new (dest) FUNCTOR(std::move(*reinterpret_cast<FUNCTOR*>(src)));
+        };
     }
     else {
         _callable = new char[sizeof(FUNCTOR)];
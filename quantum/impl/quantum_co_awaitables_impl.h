@@ -0,0 +1,364 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+namespace co {
+
+//==============================================================================================
+//                                     class Awaitable
+//==============================================================================================
+template <class PROMISE>
+void Awaitable::await_suspend(std::coroutine_handle<PROMISE> handle)
+{
+    static_assert(std::is_base_of<TaskPromiseBase, PROMISE>::value, "Awaitable only supported inside a co::Task");
+    handle.promise().getDriver()->suspend(handle, this);
+}
+
+//==============================================================================================
+//                                    class FutureAwaiter
+//==============================================================================================
+template <class FUTURE>
+FutureAwaiter<FUTURE>::FutureAwaiter(FUTURE future) :
+    _future(std::move(future))
+{
+    if (!_future)
+    {
+        throw std::runtime_error("Awaiting a null future");
+    }
+}
+
+template <class FUTURE>
+bool FutureAwaiter<FUTURE>::poll()
+{
+    if constexpr (std::is_same<typename FUTURE::element_type::ContextTag, ThreadContextTag>::value)
+    {
+        return _future->waitFor(std::chrono::milliseconds(0)) == std::future_status::ready;
+    }
+    else
+    {
+        return _future->waitFor(nullptr, std::chrono::milliseconds(0)) == std::future_status::ready;
+    }
+}
+
+template <class FUTURE>
+auto FutureAwaiter<FUTURE>::await_resume()
+{
+    if constexpr (std::is_same<typename FUTURE::element_type::ContextTag, ThreadContextTag>::value)
+    {
+        return _future->get();
+    }
+    else
+    {
+        return _future->get(nullptr); //the value is ready so this never waits
+    }
+}
+
+//==============================================================================================
+//                                      class LockGuard
+//==============================================================================================
+inline
+LockGuard::LockGuard(Mutex& mutex) :
+    _mutex(&mutex)
+{}
+
+inline
+LockGuard::LockGuard(LockGuard&& other) noexcept :
+    _mutex(std::exchange(other._mutex, nullptr))
+{}
+
+inline
+LockGuard& LockGuard::operator=(LockGuard&& other) noexcept
+{
+    if (this != &other)
+    {
+        unlock();
+        _mutex = std::exchange(other._mutex, nullptr);
+    }
+    return *this;
+}
+
+inline
+LockGuard::~LockGuard()
+{
+    unlock();
+}
+
+inline
+void LockGuard::unlock()
+{
+    if (_mutex)
+    {
+        std::exchange(_mutex, nullptr)->unlock();
+    }
+}
+
+inline
+bool LockGuard::ownsLock() const
+{
+    return _mutex != nullptr;
+}
+
+//==============================================================================================
+//                                     class LockAwaiter
+//==============================================================================================
+inline
+LockAwaiter::LockAwaiter(Mutex& mutex) :
+    _mutex(mutex)
+{}
+
+inline
+bool LockAwaiter::poll()
+{
+    return _mutex.tryLock();
+}
+
+inline
+LockGuard LockAwaiter::await_resume() const
+{
+    return LockGuard(_mutex); //the mutex was acquired by poll()
+}
+
+//==============================================================================================
+//                                class ConditionVariableWaiter
+//==============================================================================================
+inline
+ConditionVariableWaiter::ConditionVariableWaiter(ConditionVariable& cond,
+                                                 Mutex& mutex,
+                                                 std::function<bool()> predicate) :
+    _cond(cond),
+    _mutex(mutex),
+    _predicate(std::move(predicate))
+{}
+
+inline
+ConditionVariableWaiter::~ConditionVariableWaiter()
+{
+    if (_signal == 0)
+    {
+        //The coroutine frame is destroyed while waiting (e.g. on terminate) so the condition variable must
+        //not notify this signal anymore. If it was notified in the meantime, it is no longer in the list.
+        Mutex::Guard lock(_cond._thisLock);
+        _cond._waiters.remove(&_signal);
+    }
+}
+
+inline
+bool ConditionVariableWaiter::await_ready()
+{
+    if (_predicate && _predicate())
+    {
+        return true;
+    }
+    return !enqueue();
+}
+
+inline
+bool ConditionVariableWaiter::enqueue()
+{
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(_cond._thisLock);
+        if (_cond._destroyed)
+        {
+            return false; //don't release the mutex
+        }
+        _signal = 0; //clear signal flag
+        _cond._waiters.push_back(&_signal);
+    }
+    _mutex.unlock();
+    return true;
+}
+
+inline
+bool ConditionVariableWaiter::poll()
+{
+    if ((_signal == 0) && !_cond._destroyed)
+    {
+        return false; //not notified yet
+    }
+    if (!_mutex.tryLock())
+    {
+        return false;
+    }
+    _signal = -1; //reset
+    if (_predicate && !_cond._destroyed && !_predicate())
+    {
+        return !enqueue(); //spurious wake-up
+    }
+    return true;
+}
+
+//==============================================================================================
+//                                     class SleepAwaiter
+//==============================================================================================
+inline
+SleepAwaiter::SleepAwaiter(std::chrono::steady_clock::duration duration) :
+    _deadline(std::chrono::steady_clock::now() + duration)
+{}
+
+inline
+bool SleepAwaiter::poll()
+{
+    return std::chrono::steady_clock::now() >= _deadline;
+}
+
+inline
+int SleepAwaiter::pendingCode() const
+{
+    return (int)ITask::RetCode::Sleeping;
+}
+
+//==============================================================================================
+//                                     class YieldAwaiter
+//==============================================================================================
+template <class PROMISE>
+void YieldAwaiter::await_suspend(std::coroutine_handle<PROMISE> handle)
+{
+    static_assert(std::is_base_of<TaskPromiseBase, PROMISE>::value, "Awaitable only supported inside a co::Task");
+    handle.promise().getDriver()->suspend(handle);
+}
+
+//==============================================================================================
+//                                      class IoAwaiter
+//==============================================================================================
+template <class FUNC>
+IoAwaiter<FUNC>::IoAwaiter(int queueId, bool isHighPriority, FUNC&& func) :
+    _queueId(queueId),
+    _isHighPriority(isHighPriority),
+    _func(std::move(func))
+{}
+
+template <class FUNC>
+template <class PROMISE>
+void IoAwaiter<FUNC>::await_suspend(std::coroutine_handle<PROMISE> handle)
+{
+    static_assert(std::is_base_of<TaskPromiseBase, PROMISE>::value, "Awaitable only supported inside a co::Task");
+    Driver* driver = handle.promise().getDriver();
+    if constexpr (std::is_void_v<Result>)
+    {
+        _future = driver->dispatcher().postAsyncIo2(_queueId, _isHighPriority, [func = std::move(_func)]() mutable->Void
+        {
+            func();
+            return Void{};
+        });
+    }
+    else
+    {
+        _future = driver->dispatcher().postAsyncIo2(_queueId, _isHighPriority, std::move(_func));
+    }
+    driver->suspend(handle, this);
+}
+
+template <class FUNC>
+bool IoAwaiter<FUNC>::poll()
+{
+    return _future->waitFor(std::chrono::milliseconds(0)) == std::future_status::ready;
+}
+
+template <class FUNC>
+typename IoAwaiter<FUNC>::Result IoAwaiter<FUNC>::await_resume()
+{
+    if constexpr (std::is_void_v<Result>)
+    {
+        _future->get();
+    }
+    else
+    {
+        return _future->get();
+    }
+}
+
+//==============================================================================================
+//                                      functions
+//==============================================================================================
+inline
+LockAwaiter lock(Mutex& mutex)
+{
+    return LockAwaiter(mutex);
+}
+
+inline
+ConditionVariableWaiter wait(ConditionVariable& cond, Mutex& mutex)
+{
+    return ConditionVariableWaiter(cond, mutex);
+}
+
+template <class PREDICATE>
+ConditionVariableWaiter wait(ConditionVariable& cond, Mutex& mutex, PREDICATE predicate)
+{
+    return ConditionVariableWaiter(cond, mutex, std::move(predicate));
+}
+
+template <class REP, class PERIOD>
+SleepAwaiter sleep(const std::chrono::duration<REP, PERIOD>& duration)
+{
+    return SleepAwaiter(std::chrono::duration_cast<std::chrono::steady_clock::duration>(duration));
+}
+
+inline
+YieldAwaiter yield()
+{
+    return YieldAwaiter();
+}
+
+template <class FUNC, class ... ARGS>
+auto postAsyncIo(FUNC&& func, ARGS&&... args)
+{
+    return postAsyncIo((int)IQueue::QueueId::Any, false, std::forward<FUNC>(func), std::forward<ARGS>(args)...);
+}
+
+template <class FUNC, class ... ARGS>
+auto postAsyncIo(int queueId, bool isHighPriority, FUNC&& func, ARGS&&... args)
+{
+    auto call = [func = std::forward<FUNC>(func), ...args = std::forward<ARGS>(args)]() mutable
+    {
+        return func(args...);
+    };
+    return IoAwaiter<decltype(call)>(queueId, isHighPriority, std::move(call));
+}
+
+} //namespace co
+
+template <class T>
+co::FutureAwaiter<ThreadFuturePtr<T>> operator co_await(std::shared_ptr<IThreadFuture<T>> future)
+{
+    return co::FutureAwaiter<ThreadFuturePtr<T>>(std::move(future));
+}
+
+template <class T>
+co::FutureAwaiter<CoroFuturePtr<T>> operator co_await(std::shared_ptr<ICoroFuture<T>> future)
+{
+    return co::FutureAwaiter<CoroFuturePtr<T>>(std::move(future));
+}
+
+template <class T>
+co::FutureAwaiter<ThreadContextPtr<T>> operator co_await(std::shared_ptr<IThreadContext<T>> context)
+{
+    return co::FutureAwaiter<ThreadContextPtr<T>>(std::move(context));
+}
+
+template <class T>
+co::FutureAwaiter<CoroContextPtr<T>> operator co_await(std::shared_ptr<ICoroContext<T>> context)
+{
+    return co::FutureAwaiter<CoroContextPtr<T>>(std::move(context));
+}
+
+}}
@@ -0,0 +1,213 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+namespace co {
+
+//==============================================================================================
+//                                  class GeneratorPromise
+//==============================================================================================
+template <class T>
+void* GeneratorPromise<T>::operator new(size_t size)
+{
+    return allocateFrame(size);
+}
+
+template <class T>
+void GeneratorPromise<T>::operator delete(void* p, size_t size)
+{
+    deallocateFrame(p, size);
+}
+
+template <class T>
+Generator<T> GeneratorPromise<T>::get_return_object() noexcept
+{
+    return Generator<T>(Generator<T>::Handle::from_promise(*this));
+}
+
+template <class T>
+std::suspend_always GeneratorPromise<T>::yield_value(T& value) noexcept
+{
+    _value = std::addressof(value); //the consumer reads the value in place while the generator is suspended
+    return {};
+}
+
+template <class T>
+std::suspend_always GeneratorPromise<T>::yield_value(T&& value) noexcept
+{
+    _value = std::addressof(value); //the temporary lives until the generator resumes
+    return {};
+}
+
+template <class T>
+typename GeneratorPromise<T>::CopyAwaiter GeneratorPromise<T>::yield_value(const T& value)
+{
+    return CopyAwaiter{this, value};
+}
+
+template <class T>
+void GeneratorPromise<T>::unhandled_exception() noexcept
+{
+    _exception = std::current_exception();
+}
+
+template <class T>
+T* GeneratorPromise<T>::getValue() const
+{
+    return _value;
+}
+
+template <class T>
+void GeneratorPromise<T>::rethrowIfFailed() const
+{
+    if (_exception)
+    {
+        std::rethrow_exception(_exception);
+    }
+}
+
+//==============================================================================================
+//                                  class Generator::Iterator
+//==============================================================================================
+template <class T>
+Generator<T>::Iterator::Iterator(Generator<T>* generator) :
+    _generator(generator)
+{}
+
+template <class T>
+typename Generator<T>::Iterator::reference Generator<T>::Iterator::operator*() const
+{
+    return _generator->value();
+}
+
+template <class T>
+typename Generator<T>::Iterator::pointer Generator<T>::Iterator::operator->() const
+{
+    return std::addressof(_generator->value());
+}
+
+template <class T>
+typename Generator<T>::Iterator& Generator<T>::Iterator::operator++()
+{
+    if (!_generator->next())
+    {
+        _generator = nullptr; //reached the end
+    }
+    return *this;
+}
+
+template <class T>
+void Generator<T>::Iterator::operator++(int)
+{
+    ++(*this);
+}
+
+template <class T>
+bool Generator<T>::Iterator::operator==(const Iterator& other) const
+{
+    return _generator == other._generator;
+}
+
+template <class T>
+bool Generator<T>::Iterator::operator!=(const Iterator& other) const
+{
+    return _generator != other._generator;
+}
+
+//==============================================================================================
+//                                     class Generator
+//==============================================================================================
+template <class T>
+Generator<T>::Generator(Handle handle) :
+    _handle(handle)
+{}
+
+template <class T>
+Generator<T>::Generator(Generator&& other) noexcept :
+    _handle(std::exchange(other._handle, nullptr))
+{}
+
+template <class T>
+Generator<T>& Generator<T>::operator=(Generator&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_handle)
+        {
+            _handle.destroy();
+        }
+        _handle = std::exchange(other._handle, nullptr);
+    }
+    return *this;
+}
+
+template <class T>
+Generator<T>::~Generator()
+{
+    if (_handle)
+    {
+        _handle.destroy(); //destroys the locals of a suspended generator
+    }
+}
+
+template <class T>
+bool Generator<T>::next()
+{
+    if (!_handle || _handle.done())
+    {
+        return false;
+    }
+    _handle.resume();
+    if (_handle.done())
+    {
+        _handle.promise().rethrowIfFailed();
+        return false;
+    }
+    return true;
+}
+
+template <class T>
+T& Generator<T>::value() const
+{
+    assert(_handle && !_handle.done());
+    return *_handle.promise().getValue();
+}
+
+template <class T>
+bool Generator<T>::done() const
+{
+    return !_handle || _handle.done();
+}
+
+template <class T>
+typename Generator<T>::Iterator Generator<T>::begin()
+{
+    return next() ? Iterator(this) : Iterator();
+}
+
+template <class T>
+typename Generator<T>::Iterator Generator<T>::end()
+{
+    return Iterator();
+}
+
+}}}
@@ -0,0 +1,394 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+#include <stdexcept>
+
+namespace Bloomberg {
+namespace quantum {
+namespace co {
+
+//Coroutine frames are pooled in a few size classes. Larger frames come from the default heap.
+template <size_t SIZE>
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) FrameBlock
+{
+    char _data[SIZE];
+};
+
+#ifndef __QUANTUM_USE_DEFAULT_ALLOCATOR
+    #ifdef __QUANTUM_ALLOCATE_POOL_FROM_HEAP
+        template <size_t SIZE>
+        using FrameAllocator = HeapAllocator<FrameBlock<SIZE>>;
+    #else
+        template <size_t SIZE>
+        using FrameAllocator = StackAllocator<FrameBlock<SIZE>, __QUANTUM_CORO_FRAME_ALLOC_SIZE>;
+    #endif
+#endif
+
+inline
+void* allocateFrame(size_t size)
+{
+#ifndef __QUANTUM_USE_DEFAULT_ALLOCATOR
+    if (size <= sizeof(FrameBlock<256>))
+    {
+        return Allocator<FrameAllocator<256>>::instance(AllocatorTraits::coroFrameAllocSize()).allocate();
+    }
+    if (size <= sizeof(FrameBlock<512>))
+    {
+        return Allocator<FrameAllocator<512>>::instance(AllocatorTraits::coroFrameAllocSize()).allocate();
+    }
+    if (size <= sizeof(FrameBlock<1024>))
+    {
+        return Allocator<FrameAllocator<1024>>::instance(AllocatorTraits::coroFrameAllocSize()).allocate();
+    }
+#endif
+    return ::operator new(size);
+}
+
+inline
+void deallocateFrame(void* p, size_t size)
+{
+#ifndef __QUANTUM_USE_DEFAULT_ALLOCATOR
+    if (size <= sizeof(FrameBlock<256>))
+    {
+        return Allocator<FrameAllocator<256>>::instance(AllocatorTraits::coroFrameAllocSize()).
+            deallocate(static_cast<FrameBlock<256>*>(p));
+    }
+    if (size <= sizeof(FrameBlock<512>))
+    {
+        return Allocator<FrameAllocator<512>>::instance(AllocatorTraits::coroFrameAllocSize()).
+            deallocate(static_cast<FrameBlock<512>*>(p));
+    }
+    if (size <= sizeof(FrameBlock<1024>))
+    {
+        return Allocator<FrameAllocator<1024>>::instance(AllocatorTraits::coroFrameAllocSize()).
+            deallocate(static_cast<FrameBlock<1024>*>(p));
+    }
+#endif
+    ::operator delete(p);
+}
+
+//==============================================================================================
+//                                     class Driver
+//==============================================================================================
+inline
+Driver::Driver(Dispatcher& dispatcher) :
+    _dispatcher(dispatcher)
+{}
+
+inline
+Dispatcher& Driver::dispatcher() const
+{
+    return _dispatcher;
+}
+
+inline
+void Driver::suspend(std::coroutine_handle<> handle, Waiter* waiter)
+{
+    _handle = handle;
+    _waiter = waiter;
+}
+
+inline
+int Driver::step()
+{
+    if (_waiter)
+    {
+        if (!_waiter->poll())
+        {
+            return _waiter->pendingCode();
+        }
+        _waiter = nullptr;
+    }
+    if (_handle)
+    {
+        std::exchange(_handle, nullptr).resume();
+    }
+    if (!_handle)
+    {
+        return (int)ITask::RetCode::Success; //coroutine chain ran to completion
+    }
+    //Awaitables only suspend when they are not ready, so there is no point polling again right away
+    return _waiter ? _waiter->pendingCode() : (int)ITask::RetCode::Running;
+}
+
+//==============================================================================================
+//                                   class TaskPromiseBase
+//==============================================================================================
+template <class PROMISE>
+std::coroutine_handle<> TaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<PROMISE> handle) const noexcept
+{
+    //Resume the awaiting coroutine if any, otherwise return control to the driver
+    std::coroutine_handle<> continuation = handle.promise()._continuation;
+    return continuation ? continuation : std::noop_coroutine();
+}
+
+inline
+void* TaskPromiseBase::operator new(size_t size)
+{
+    return allocateFrame(size);
+}
+
+inline
+void TaskPromiseBase::operator delete(void* p, size_t size)
+{
+    deallocateFrame(p, size);
+}
+
+inline
+void TaskPromiseBase::unhandled_exception() noexcept
+{
+    _exception = std::current_exception();
+}
+
+inline
+void TaskPromiseBase::setDriver(Driver* driver)
+{
+    _driver = driver;
+}
+
+inline
+Driver* TaskPromiseBase::getDriver() const
+{
+    return _driver;
+}
+
+inline
+void TaskPromiseBase::setContinuation(std::coroutine_handle<> continuation)
+{
+    _continuation = continuation;
+}
+
+inline
+void TaskPromiseBase::rethrowIfFailed() const
+{
+    if (_exception)
+    {
+        std::rethrow_exception(_exception);
+    }
+}
+
+//==============================================================================================
+//                                     class TaskPromise
+//==============================================================================================
+template <class T>
+Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+    return Task<T>(Task<T>::Handle::from_promise(*this));
+}
+
+template <class T>
+template <class V>
+void TaskPromise<T>::return_value(V&& value)
+{
+    _value.emplace(std::forward<V>(value));
+}
+
+template <class T>
+T TaskPromise<T>::getResult()
+{
+    rethrowIfFailed();
+    return std::move(*_value);
+}
+
+inline
+Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+    return Task<void>(Task<void>::Handle::from_promise(*this));
+}
+
+inline
+void TaskPromise<void>::getResult()
+{
+    rethrowIfFailed();
+}
+
+//==============================================================================================
+//                                        class Task
+//==============================================================================================
+template <class T>
+Task<T>::Task(Handle handle) :
+    _handle(handle)
+{}
+
+template <class T>
+Task<T>::Task(Task&& other) noexcept :
+    _handle(std::exchange(other._handle, nullptr))
+{}
+
+template <class T>
+Task<T>& Task<T>::operator=(Task&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_handle) _handle.destroy();
+        _handle = std::exchange(other._handle, nullptr);
+    }
+    return *this;
+}
+
+template <class T>
+Task<T>::~Task()
+{
+    if (_handle) _handle.destroy();
+}
+
+template <class T>
+bool Task<T>::valid() const
+{
+    return (bool)_handle;
+}
+
+template <class T>
+bool Task<T>::done() const
+{
+    return _handle && _handle.done();
+}
+
+template <class T>
+typename Task<T>::Awaiter Task<T>::operator co_await() const noexcept
+{
+    return Awaiter{_handle};
+}
+
+template <class T>
+bool Task<T>::Awaiter::await_ready() const noexcept
+{
+    return !_handle || _handle.done();
+}
+
+template <class T>
+template <class PROMISE>
+std::coroutine_handle<> Task<T>::Awaiter::await_suspend(std::coroutine_handle<PROMISE> parent) noexcept
+{
+    static_assert(std::is_base_of<TaskPromiseBase, PROMISE>::value, "Awaiter only supported inside a co::Task");
+    //The child runs on the parent's driver and resumes the parent when it completes (symmetric transfer)
+    _handle.promise().setDriver(parent.promise().getDriver());
+    _handle.promise().setContinuation(parent);
+    return _handle;
+}
+
+template <class T>
+T Task<T>::Awaiter::await_resume()
+{
+    if (!_handle)
+    {
+        throw std::runtime_error("Awaiting an invalid co::Task");
+    }
+    return _handle.promise().getResult();
+}
+
+//==============================================================================================
+//                                        class Runner
+//==============================================================================================
+template <class T>
+Runner<T>::Runner(Dispatcher& dispatcher, Task<T>&& task) :
+    _driver(dispatcher),
+    _task(std::move(task)),
+    _promise(new Promise<Result>(), Promise<Result>::deleter)
+{
+    if (!_task.valid())
+    {
+        throw std::runtime_error("Spawning an invalid co::Task");
+    }
+    _task._handle.promise().setDriver(&_driver);
+    _driver.suspend(_task._handle);
+}
+
+template <class T>
+int Runner<T>::step()
+{
+    int rc = _driver.step();
+    if (rc != (int)ITask::RetCode::Success)
+    {
+        return rc;
+    }
+    setResult();
+    return 0;
+}
+
+template <class T>
+const PromisePtr<typename Runner<T>::Result>& Runner<T>::getPromise() const
+{
+    return _promise;
+}
+
+template <class T>
+void Runner<T>::setResult()
+{
+    try
+    {
+        if (!_task.done())
+        {
+            throw std::runtime_error("co::Task suspended on an awaitable which is not supported by quantum");
+        }
+        if constexpr (std::is_void_v<T>)
+        {
+            _task._handle.promise().getResult();
+            _promise->set(Void{});
+        }
+        else
+        {
+            _promise->set(_task._handle.promise().getResult());
+        }
+    }
+    catch (...)
+    {
+        _promise->setException(std::current_exception());
+    }
+}
+
+template <class T>
+PromisePtr<SpawnResult<T>> spawnImpl(Dispatcher& dispatcher,
+                                     Task<T>&& task,
+                                     int queueId,
+                                     bool isHighPriority)
+{
+    auto runner = std::make_shared<Runner<T>>(dispatcher, std::move(task));
+    //The callable keeps returning Running/Blocked/Sleeping until the coroutine chain completes and is
+    //therefore re-queued in between (see Dispatcher::postLite()). The lite task's own promise is unused.
+    dispatcher.postLite(queueId, isHighPriority, [runner](ThreadPromisePtr<int>)->int
+    {
+        return runner->step();
+    });
+    return runner->getPromise();
+}
+
+template <class T>
+ThreadFuturePtr<SpawnResult<T>>
+spawn(Dispatcher& dispatcher,
+      Task<T> task,
+      int queueId,
+      bool isHighPriority)
+{
+    return spawnImpl(dispatcher, std::move(task), queueId, isHighPriority)->getIThreadFuture();
+}
+
+template <class T>
+CoroFuturePtr<SpawnResult<T>>
+spawn(VoidContextPtr,
+      Dispatcher& dispatcher,
+      Task<T> task,
+      int queueId,
+      bool isHighPriority)
+{
+    return spawnImpl(dispatcher, std::move(task), queueId, isHighPriority)->getICoroFuture();
+}
+
+}}}
@@ -163,6 +163,7 @@ void ConditionVariable::waitImpl(ICoroSync::Ptr sync,
     }
     //========= UNLOCKED SCOPE =========
     Mutex::ReverseGuard unlock(sync, mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::ConditionVariable, this);
     while ((signal == 0) && !_destroyed)
     {
         yield(sync);
@@ -202,6 +203,7 @@ bool ConditionVariable::waitForImpl(ICoroSync::Ptr sync,
     }
     //========= UNLOCKED SCOPE =========
     Mutex::ReverseGuard unlock(sync, mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::ConditionVariable, this);
     auto start = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration<REP, PERIOD>::zero();
     bool timeout = false;
@@ -76,6 +76,18 @@ const std::string& Configuration::getJsonSchema()
             "coroSharingForAny": {
                 "type": "boolean",
                 "default": false
+            },
+            "watchdogThresholdMs": {
+                "type": "number",
+                "default": 0
+            },
+            "reuseCoroutines": {
+                "type": "boolean",
+                "default": false
+            },
+            "maxIdleCoroutines": {
+                "type": "number",
+                "default": 200
             }
         },
         "additionalProperties": false,
@@ -146,6 +158,30 @@ void Configuration::setCoroutineSharingForAny(bool sharing)
      _coroutineSharingForAny = sharing;
 }
 
+inline
+void Configuration::setWatchdogThreshold(std::chrono::milliseconds threshold)
+{
+    _watchdogThreshold = threshold;
+}
+
+inline
+void Configuration::setWatchdogCallback(WatchdogCallback callback)
+{
+    _watchdogCallback = std::move(callback);
+}
+
+inline
+void Configuration::setReuseCoroutines(bool value)
+{
+    _reuseCoroutines = value;
+}
+
+inline
+void Configuration::setMaxIdleCoroutines(size_t num)
+{
+    _maxIdleCoroutines = num;
+}
+
 inline
 int Configuration::getNumCoroutineThreads() const
 {
@@ -199,6 +235,30 @@ bool Configuration::getCoroutineSharingForAny() const
 {
     return _coroutineSharingForAny;
 }
+
+inline
+std::chrono::milliseconds Configuration::getWatchdogThreshold() const
+{
+    return _watchdogThreshold;
+}
+
+inline
+const Configuration::WatchdogCallback& Configuration::getWatchdogCallback() const
+{
+    return _watchdogCallback;
+}
+
+inline
+bool Configuration::getReuseCoroutines() const
+{
+    return _reuseCoroutines;
+}
+
+inline
+size_t Configuration::getMaxIdleCoroutines() const
+{
+    return _maxIdleCoroutines;
+}
     
 }
 }
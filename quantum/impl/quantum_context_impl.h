@@ -521,6 +521,135 @@ ICoroContext<RET>::forEachBatch(INPUT_IT first,
     return static_cast<Impl*>(this)->template forEachBatch<Ret>(first, num, std::forward<FUNC>(func));
 }
 
+template <class RET>
+template <class INPUT_IT, class FUNC, class>
+auto
+ICoroContext<RET>::forEachChunk(INPUT_IT first,
+                                INPUT_IT last,
+                                size_t chunkSize,
+                                FUNC&& func)->CoroContextPtr<typename Traits::ChunkResults<decltype(coroResult(func))>::Type>
+{
+    using Ret = decltype(coroResult(func));
+    return static_cast<Impl*>(this)->template forEachChunk<Ret>(first, last, chunkSize, std::forward<FUNC>(func));
+}
+
+template <class RET>
+template <class INPUT_IT, class OUTPUT_IT, class FUNC, class>
+CoroContextPtr<int>
+ICoroContext<RET>::forEachChunk(INPUT_IT first,
+                                INPUT_IT last,
+                                size_t chunkSize,
+                                OUTPUT_IT outFirst,
+                                FUNC&& func)
+{
+    return static_cast<Impl*>(this)->forEachChunk(first, last, chunkSize, outFirst, std::forward<FUNC>(func));
+}
+
+template <class RET>
+template <class INPUT_IT, class FUNC, class>
+auto
+ICoroContext<RET>::forEachAsyncIo(INPUT_IT first,
+                                  INPUT_IT last,
+                                  FUNC&& func,
+                                  size_t chunkSize)->CoroContextPtr<typename Traits::ChunkResults<decltype(resultOf2(func))>::Type>
+{
+    using Ret = decltype(resultOf2(func));
+    return static_cast<Impl*>(this)->template forEachAsyncIo<Ret>(first, last, std::forward<FUNC>(func), chunkSize);
+}
+
+template <class RET>
+template <class INPUT_IT, class FUNC, class>
+auto
+ICoroContext<RET>::parallelFor(INPUT_IT first,
+                               INPUT_IT last,
+                               FUNC&& func,
+                               size_t grainSize)->CoroContextPtr<std::vector<decltype(coroResult(func))>>
+{
+    using Ret = decltype(coroResult(func));
+    return static_cast<Impl*>(this)->template parallelFor<Ret>(first, last, std::forward<FUNC>(func), grainSize);
+}
+
+template <class RET>
+template <class FUNC>
+CoroContextPtr<int>
+ICoroContext<RET>::parallelFor2D(size_t rows,
+                                 size_t cols,
+                                 size_t tileRows,
+                                 size_t tileCols,
+                                 FUNC&& func)
+{
+    return static_cast<Impl*>(this)->parallelFor2D(rows, cols, tileRows, tileCols, std::forward<FUNC>(func));
+}
+
+template <class RET>
+template <class INPUT_IT, class T, class FUNC, class>
+CoroContextPtr<T>
+ICoroContext<RET>::reduce(INPUT_IT first,
+                          INPUT_IT last,
+                          T init,
+                          FUNC&& func,
+                          size_t grainSize)
+{
+    return static_cast<Impl*>(this)->transformReduce(first, last, std::move(init), std::forward<FUNC>(func),
+                                                     Util::Identity{}, grainSize);
+}
+
+template <class RET>
+template <class INPUT_IT, class T, class REDUCE_FUNC, class TRANSFORM_FUNC, class>
+CoroContextPtr<T>
+ICoroContext<RET>::transformReduce(INPUT_IT first,
+                                   INPUT_IT last,
+                                   T init,
+                                   REDUCE_FUNC&& reduceFunc,
+                                   TRANSFORM_FUNC&& transformFunc,
+                                   size_t grainSize)
+{
+    return static_cast<Impl*>(this)->transformReduce(first, last, std::move(init), std::forward<REDUCE_FUNC>(reduceFunc),
+                                                     std::forward<TRANSFORM_FUNC>(transformFunc), grainSize);
+}
+
+template <class RET>
+template <class INPUT_IT, class FUNC, class>
+CoroContextPtr<std::vector<typename std::iterator_traits<INPUT_IT>::value_type>>
+ICoroContext<RET>::inclusiveScan(INPUT_IT first,
+                                 INPUT_IT last,
+                                 FUNC&& func)
+{
+    using T = typename std::iterator_traits<INPUT_IT>::value_type;
+    return static_cast<Impl*>(this)->template scan<T>(first, last, T{}, std::forward<FUNC>(func), true);
+}
+
+template <class RET>
+template <class INPUT_IT, class T, class FUNC, class>
+CoroContextPtr<std::vector<T>>
+ICoroContext<RET>::exclusiveScan(INPUT_IT first,
+                                 INPUT_IT last,
+                                 T init,
+                                 FUNC&& func)
+{
+    return static_cast<Impl*>(this)->template scan<T>(first, last, std::move(init), std::forward<FUNC>(func), false);
+}
+
+template <class RET>
+template <class RANDOM_IT, class COMPARE, class>
+CoroContextPtr<int>
+ICoroContext<RET>::sort(RANDOM_IT first,
+                        RANDOM_IT last,
+                        COMPARE compare)
+{
+    return static_cast<Impl*>(this)->sort(first, last, std::move(compare), false);
+}
+
+template <class RET>
+template <class RANDOM_IT, class COMPARE, class>
+CoroContextPtr<int>
+ICoroContext<RET>::stableSort(RANDOM_IT first,
+                              RANDOM_IT last,
+                              COMPARE compare)
+{
+    return static_cast<Impl*>(this)->sort(first, last, std::move(compare), true);
+}
+
 template <class RET>
 template <class KEY,
           class MAPPED_TYPE,
@@ -609,6 +738,100 @@ ICoroContext<RET>::mapReduceBatch(INPUT_IT first,
         (first, num, std::move(mapper), std::move(reducer));
 }
 
+template <class RET>
+template <class MAPPER_FUNC,
+          class REDUCER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class INPUT_IT,
+          class>
+auto
+ICoroContext<RET>::mapReduce(INPUT_IT first,
+                             INPUT_IT last,
+                             MAPPER_FUNC mapper,
+                             REDUCER_FUNC reducer,
+                             COMBINER_FUNC combiner,
+                             OUTPUT output)->
+          CoroContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using ReducedType = decltype(reducedTypeOf(reducer));
+    return static_cast<Impl*>(this)->template mapReduce<Key, MappedType, ReducedType>
+        (first, (size_t)std::distance(first, last), std::move(mapper), std::move(reducer),
+         Functions::CombineFunc<Key, MappedType>{std::move(combiner)}, output);
+}
+
+template <class RET>
+template <class MAPPER_FUNC,
+          class REDUCER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class INPUT_IT,
+          class>
+auto
+ICoroContext<RET>::mapReduceBatch(INPUT_IT first,
+                                  INPUT_IT last,
+                                  MAPPER_FUNC mapper,
+                                  REDUCER_FUNC reducer,
+                                  COMBINER_FUNC combiner,
+                                  OUTPUT output)->
+          CoroContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using ReducedType = decltype(reducedTypeOf(reducer));
+    return static_cast<Impl*>(this)->template mapReduceBatch<Key, MappedType, ReducedType>
+        (first, (size_t)std::distance(first, last), std::move(mapper), std::move(reducer),
+         Functions::CombineFunc<Key, MappedType>{std::move(combiner)}, output);
+}
+
+template <class RET>
+template <class MAPPER_FUNC,
+          class REDUCER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class INPUT_IT,
+          class>
+auto
+ICoroContext<RET>::mapReduceAsyncIo(INPUT_IT first,
+                                    INPUT_IT last,
+                                    MAPPER_FUNC mapper,
+                                    REDUCER_FUNC reducer,
+                                    COMBINER_FUNC combiner,
+                                    OUTPUT output,
+                                    size_t chunkSize)->
+          CoroContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using ReducedType = decltype(reducedTypeOf(reducer));
+    return static_cast<Impl*>(this)->template mapReduceAsyncIo<Key, MappedType, ReducedType>
+        (first, (size_t)std::distance(first, last), std::move(mapper), std::move(reducer),
+         Functions::CombineFunc<Key, MappedType>{std::move(combiner)}, output, chunkSize);
+}
+
+template <class RET>
+template <class MAPPER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class SOURCE>
+auto
+ICoroContext<RET>::mapReduceStream(SOURCE source,
+                                   MAPPER_FUNC mapper,
+                                   COMBINER_FUNC combiner,
+                                   OUTPUT output,
+                                   size_t batchSize)->
+          CoroContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(mappedTypeOf(mapper))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using Record = typename Traits::BufferSource<SOURCE>::Type;
+    return static_cast<Impl*>(this)->template mapReduceStream<Key, MappedType, Record>
+        (std::move(source), std::move(mapper), Functions::CombineFunc<Key, MappedType>{std::move(combiner)},
+         output, batchSize);
+}
+
 //==============================================================================================
 //                                     class Context
 //==============================================================================================
@@ -835,6 +1058,7 @@ Context<RET>::thenImpl(ITask::Type type, FUNC&& func, ARGS&&... args)
                                      Context<OTHER_RET>::deleter);
     auto task = Task::Ptr(new Task(Traits::IsVoidContext<FirstArg>{},
                                    ctx,
+                                   _dispatcher->getCoroutinePool(),
                                    _task->getQueueId(),      //keep current queueId
                                    _task->isHighPriority(),  //keep current priority
                                    type,
@@ -1041,6 +1265,140 @@ Context<RET>::forEachBatch(INPUT_IT first,
                                                      getNumCoroutineThreads());
 }
 
+template <class RET>
+template <class OTHER_RET, class INPUT_IT, class FUNC, class>
+ContextPtr<typename Traits::ChunkResults<OTHER_RET>::Type>
+Context<RET>::forEachChunk(INPUT_IT first,
+                           INPUT_IT last,
+                           size_t chunkSize,
+                           FUNC&& func)
+{
+    using Results = typename Traits::ChunkResults<OTHER_RET>::Type;
+    return post2<Results>(Util::forEachChunkCoro<OTHER_RET, INPUT_IT, FUNC&&>,
+                          INPUT_IT{first},
+                          (size_t)std::distance(first, last),
+                          size_t{chunkSize},
+                          std::forward<FUNC>(func));
+}
+
+template <class RET>
+template <class INPUT_IT, class OUTPUT_IT, class FUNC, class>
+ContextPtr<int>
+Context<RET>::forEachChunk(INPUT_IT first,
+                           INPUT_IT last,
+                           size_t chunkSize,
+                           OUTPUT_IT outFirst,
+                           FUNC&& func)
+{
+    return post2<int>(Util::forEachChunkOutputCoro<INPUT_IT, OUTPUT_IT, FUNC&&>,
+                      INPUT_IT{first},
+                      (size_t)std::distance(first, last),
+                      size_t{chunkSize},
+                      OUTPUT_IT{outFirst},
+                      std::forward<FUNC>(func));
+}
+
+template <class RET>
+template <class OTHER_RET, class INPUT_IT, class FUNC, class>
+ContextPtr<typename Traits::ChunkResults<OTHER_RET>::Type>
+Context<RET>::forEachAsyncIo(INPUT_IT first,
+                             INPUT_IT last,
+                             FUNC&& func,
+                             size_t chunkSize)
+{
+    using Results = typename Traits::ChunkResults<OTHER_RET>::Type;
+    return post2<Results>(Util::forEachAsyncIoCoro<OTHER_RET, INPUT_IT, FUNC&&>,
+                          INPUT_IT{first},
+                          (size_t)std::distance(first, last),
+                          size_t{chunkSize},
+                          std::forward<FUNC>(func));
+}
+
+template <class RET>
+template <class OTHER_RET, class INPUT_IT, class FUNC, class>
+ContextPtr<std::vector<OTHER_RET>>
+Context<RET>::parallelFor(INPUT_IT first,
+                          INPUT_IT last,
+                          FUNC&& func,
+                          size_t grainSize)
+{
+    return post2<std::vector<OTHER_RET>>(Util::parallelForCoro<OTHER_RET, INPUT_IT, FUNC&&>,
+                                        INPUT_IT{first},
+                                        (size_t)std::distance(first, last),
+                                        std::forward<FUNC>(func),
+                                        size_t{grainSize});
+}
+
+template <class RET>
+template <class FUNC>
+ContextPtr<int>
+Context<RET>::parallelFor2D(size_t rows,
+                            size_t cols,
+                            size_t tileRows,
+                            size_t tileCols,
+                            FUNC&& func)
+{
+    return post2<int>(Util::parallelFor2DCoro<FUNC&&>,
+                      size_t{rows},
+                      size_t{cols},
+                      size_t{tileRows},
+                      size_t{tileCols},
+                      std::forward<FUNC>(func));
+}
+
+template <class RET>
+template <class INPUT_IT, class T, class REDUCE_FUNC, class TRANSFORM_FUNC, class>
+ContextPtr<T>
+Context<RET>::transformReduce(INPUT_IT first,
+                              INPUT_IT last,
+                              T init,
+                              REDUCE_FUNC&& reduceFunc,
+                              TRANSFORM_FUNC&& transformFunc,
+                              size_t grainSize)
+{
+    using ReduceFunc = typename std::decay<REDUCE_FUNC>::type;
+    using TransformFunc = typename std::decay<TRANSFORM_FUNC>::type;
+    return post2<T>(Util::transformReduceCoro<T, INPUT_IT, ReduceFunc, TransformFunc>,
+                    INPUT_IT{first},
+                    (size_t)std::distance(first, last),
+                    std::move(init),
+                    std::forward<REDUCE_FUNC>(reduceFunc),
+                    std::forward<TRANSFORM_FUNC>(transformFunc),
+                    size_t{grainSize});
+}
+
+template <class RET>
+template <class T, class INPUT_IT, class FUNC, class>
+ContextPtr<std::vector<T>>
+Context<RET>::scan(INPUT_IT first,
+                   INPUT_IT last,
+                   T init,
+                   FUNC&& func,
+                   bool isInclusive)
+{
+    return post2<std::vector<T>>(Util::scanCoro<T, INPUT_IT, typename std::decay<FUNC>::type>,
+                                 INPUT_IT{first},
+                                 (size_t)std::distance(first, last),
+                                 std::move(init),
+                                 std::forward<FUNC>(func),
+                                 bool{isInclusive});
+}
+
+template <class RET>
+template <class RANDOM_IT, class COMPARE, class>
+ContextPtr<int>
+Context<RET>::sort(RANDOM_IT first,
+                   RANDOM_IT last,
+                   COMPARE compare,
+                   bool isStable)
+{
+    return post2<int>(Util::sortCoro<RANDOM_IT, COMPARE>,
+                      RANDOM_IT{first},
+                      (size_t)std::distance(first, last),
+                      std::move(compare),
+                      bool{isStable});
+}
+
 template <class RET>
 template <class KEY,
           class MAPPED_TYPE,
@@ -1067,12 +1425,31 @@ Context<RET>::mapReduce(INPUT_IT first,
                         Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
                         Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer)
 {
-    using ReducerOutput = std::map<KEY, REDUCED_TYPE>;
-    return post2<ReducerOutput>(Util::mapReduceCoro<KEY, MAPPED_TYPE, REDUCED_TYPE, INPUT_IT>,
+    return mapReduce<KEY, MAPPED_TYPE, REDUCED_TYPE>(first, num, std::move(mapper), std::move(reducer),
+                                                    nullptr, MapReduceOutput::Ordered{});
+}
+
+template <class RET>
+template <class KEY,
+          class MAPPED_TYPE,
+          class REDUCED_TYPE,
+          class OUTPUT,
+          class INPUT_IT>
+ContextPtr<typename OUTPUT::template Container<KEY, REDUCED_TYPE>>
+Context<RET>::mapReduce(INPUT_IT first,
+                        size_t num,
+                        Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
+                        Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer,
+                        Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+                        OUTPUT)
+{
+    using ReducerOutput = typename OUTPUT::template Container<KEY, REDUCED_TYPE>;
+    return post2<ReducerOutput>(Util::mapReduceCoro<KEY, MAPPED_TYPE, REDUCED_TYPE, INPUT_IT, OUTPUT>,
                                INPUT_IT{first},
                                size_t{num},
                                Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>{std::move(mapper)},
-                               Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>{std::move(reducer)});
+                               Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>{std::move(reducer)},
+                               Functions::CombineFunc<KEY, MAPPED_TYPE>{std::move(combiner)});
 }
 
 template <class RET>
@@ -1101,12 +1478,77 @@ Context<RET>::mapReduceBatch(INPUT_IT first,
                              Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
                              Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer)
 {
-    using ReducerOutput = std::map<KEY, REDUCED_TYPE>;
-    return post2<ReducerOutput>(Util::mapReduceBatchCoro<KEY, MAPPED_TYPE, REDUCED_TYPE, INPUT_IT>,
+    return mapReduceBatch<KEY, MAPPED_TYPE, REDUCED_TYPE>(first, num, std::move(mapper), std::move(reducer),
+                                                         nullptr, MapReduceOutput::Ordered{});
+}
+
+template <class RET>
+template <class KEY,
+          class MAPPED_TYPE,
+          class REDUCED_TYPE,
+          class OUTPUT,
+          class INPUT_IT>
+ContextPtr<typename OUTPUT::template Container<KEY, REDUCED_TYPE>>
+Context<RET>::mapReduceBatch(INPUT_IT first,
+                             size_t num,
+                             Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
+                             Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer,
+                             Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+                             OUTPUT)
+{
+    using ReducerOutput = typename OUTPUT::template Container<KEY, REDUCED_TYPE>;
+    return post2<ReducerOutput>(Util::mapReduceBatchCoro<KEY, MAPPED_TYPE, REDUCED_TYPE, INPUT_IT, OUTPUT>,
                                INPUT_IT{first},
                                size_t{num},
                                Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>{std::move(mapper)},
-                               Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>{std::move(reducer)});
+                               Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>{std::move(reducer)},
+                               Functions::CombineFunc<KEY, MAPPED_TYPE>{std::move(combiner)});
+}
+
+template <class RET>
+template <class KEY,
+          class MAPPED_TYPE,
+          class REDUCED_TYPE,
+          class OUTPUT,
+          class INPUT_IT>
+ContextPtr<typename OUTPUT::template Container<KEY, REDUCED_TYPE>>
+Context<RET>::mapReduceAsyncIo(INPUT_IT first,
+                               size_t num,
+                               Functions::IoMapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
+                               Functions::IoReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer,
+                               Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+                               OUTPUT,
+                               size_t chunkSize)
+{
+    using ReducerOutput = typename OUTPUT::template Container<KEY, REDUCED_TYPE>;
+    return post2<ReducerOutput>(Util::mapReduceAsyncIoCoro<KEY, MAPPED_TYPE, REDUCED_TYPE, INPUT_IT, OUTPUT>,
+                                INPUT_IT{first},
+                                size_t{num},
+                                std::move(mapper),
+                                std::move(reducer),
+                                std::move(combiner),
+                                size_t{chunkSize});
+}
+
+template <class RET>
+template <class KEY,
+          class MAPPED_TYPE,
+          class RECORD,
+          class OUTPUT,
+          class SOURCE>
+ContextPtr<typename OUTPUT::template Container<KEY, MAPPED_TYPE>>
+Context<RET>::mapReduceStream(SOURCE source,
+                              Functions::StreamMapFunc<KEY, MAPPED_TYPE, RECORD> mapper,
+                              Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+                              OUTPUT,
+                              size_t batchSize)
+{
+    using CombinerOutput = typename OUTPUT::template Container<KEY, MAPPED_TYPE>;
+    return post2<CombinerOutput>(Util::mapReduceStreamCoro<KEY, MAPPED_TYPE, RECORD, SOURCE, OUTPUT>,
+                                 std::move(source),
+                                 std::move(mapper),
+                                 std::move(combiner),
+                                 size_t{batchSize});
 }
 
 template <class RET>
@@ -1451,6 +1893,7 @@ Context<RET>::postImpl(int queueId, bool isHighPriority, ITask::Type type, FUNC&
                                      Context<OTHER_RET>::deleter);
     auto task = Task::Ptr(new Task(Traits::IsVoidContext<FirstArg>{},
                                    ctx,
+                                   _dispatcher->getCoroutinePool(),
                                    (queueId == (int)IQueue::QueueId::Same) ? _task->getQueueId() : queueId,
                                    isHighPriority,
                                    type,
@@ -0,0 +1,115 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+void*& CoroLocalStorage::at(Slot slot)
+{
+    if (slot < _inline.size())
+    {
+        return _inline[slot];
+    }
+    slot -= _inline.size();
+    if (!_overflow)
+    {
+        _overflow.reset(new std::deque<void*>());
+    }
+    if (slot >= _overflow->size())
+    {
+        _overflow->resize(slot + 1, nullptr);
+    }
+    return (*_overflow)[slot];
+}
+
+inline
+void* CoroLocalStorage::get(Slot slot) const
+{
+    if (slot < _inline.size())
+    {
+        return _inline[slot];
+    }
+    slot -= _inline.size();
+    return (_overflow && (slot < _overflow->size())) ? (*_overflow)[slot] : nullptr;
+}
+
+inline
+void*& CoroLocalStorage::at(const std::string& name)
+{
+    if (!_named)
+    {
+        _named.reset(new std::unordered_map<std::string, void*>());
+    }
+    return _named->emplace(name, nullptr).first->second;
+}
+
+inline
+CoroLocalStorage::Slot CoroLocalStorage::registerSlot(const std::string& name)
+{
+    Registry& reg = registry();
+    {
+        ReadWriteSpinLock::ReadGuard guard(reg._lock);
+        auto it = reg._slots.find(name);
+        if (it != reg._slots.end())
+        {
+            return it->second;
+        }
+    }
+    ReadWriteSpinLock::WriteGuard guard(reg._lock);
+    auto it = reg._slots.emplace(name, reg._nextSlot).first;
+    if (it->second == reg._nextSlot)
+    {
+        ++reg._nextSlot;
+    }
+    return it->second;
+}
+
+inline
+bool CoroLocalStorage::findSlot(const std::string& name, Slot& slot)
+{
+    Registry& reg = registry();
+    ReadWriteSpinLock::ReadGuard guard(reg._lock);
+    auto it = reg._slots.find(name);
+    if (it == reg._slots.end())
+    {
+        return false;
+    }
+    slot = it->second;
+    return true;
+}
+
+inline
+CoroLocalStorage::Slot CoroLocalStorage::registerSlot()
+{
+    Registry& reg = registry();
+    ReadWriteSpinLock::WriteGuard guard(reg._lock);
+    return reg._nextSlot++;
+}
+
+inline
+CoroLocalStorage::Registry& CoroLocalStorage::registry()
+{
+    static Registry reg;
+    return reg;
+}
+
+}}
@@ -0,0 +1,143 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                 class PooledCoroutine
+//==============================================================================================
+inline
+PooledCoroutine::PooledCoroutine(CoroutinePool& pool, size_t shard) :
+    _pool(pool),
+    _shard(shard),
+    _coro(Allocator<CoroStackAllocator>::instance(AllocatorTraits::defaultCoroPoolAllocSize()),
+          [this](Traits::Yield& yield)
+          {
+              loop(yield);
+          })
+{}
+
+inline
+void PooledCoroutine::assign(Work&& work)
+{
+    _work.emplace(std::move(work));
+}
+
+inline
+void PooledCoroutine::resume(int& rc)
+{
+    _coro(rc);
+}
+
+inline
+bool PooledCoroutine::isIdle() const
+{
+    return !_work;
+}
+
+inline
+CoroutinePool& PooledCoroutine::getPool() const
+{
+    return _pool;
+}
+
+inline
+size_t PooledCoroutine::getShard() const
+{
+    return _shard;
+}
+
+inline
+void PooledCoroutine::loop(Traits::Yield& yield)
+{
+    while (true)
+    {
+        (*_work)(yield); //the task body sets its return code via the yield handle
+        _work = boost::none; //release the task state before going idle
+        yield(); //wait for the next task
+    }
+}
+
+//==============================================================================================
+//                                 class CoroutinePool
+//==============================================================================================
+inline
+CoroutinePool::CoroutinePool(size_t numShards, size_t maxIdle) :
+    _maxIdle(maxIdle),
+    _shards(numShards == 0 ? 1 : numShards)
+{
+    for (auto&& shard : _shards)
+    {
+        shard._idle.reserve(maxIdle);
+    }
+}
+
+inline
+CoroutinePool::Handle CoroutinePool::acquire(int queueId, PooledCoroutine::Work&& work)
+{
+    size_t index = (queueId < 0) ? 0 : (size_t)queueId % _shards.size();
+    Shard& shard = _shards[index];
+    Handle coro;
+    {//========= LOCKED SCOPE =========
+        SpinLock::Guard lock(shard._spinlock);
+        if (!shard._idle.empty())
+        {
+            coro = std::move(shard._idle.back());
+            shard._idle.pop_back();
+        }
+    }
+    if (!coro)
+    {
+        coro.reset(new PooledCoroutine(*this, index));
+    }
+    coro->assign(std::move(work));
+    return coro;
+}
+
+inline
+void CoroutinePool::release(Handle coro)
+{
+    Shard& shard = _shards[coro->getShard()];
+    {//========= LOCKED SCOPE =========
+        SpinLock::Guard lock(shard._spinlock);
+        if (shard._idle.size() < _maxIdle)
+        {
+            shard._idle.push_back(std::move(coro));
+            return;
+        }
+    }
+    //shard is full: the coroutine is destroyed outside the lock
+}
+
+inline
+size_t CoroutinePool::size() const
+{
+    size_t num = 0;
+    for (auto&& shard : _shards)
+    {
+        SpinLock::Guard lock(shard._spinlock);
+        num += shard._idle.size();
+    }
+    return num;
+}
+
+}}
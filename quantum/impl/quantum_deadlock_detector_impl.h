@@ -0,0 +1,333 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+#include <algorithm>
+#include <stdexcept>
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+void DeadlockDetector::enable(std::chrono::milliseconds threshold, Callback callback)
+{
+    if (!callback)
+    {
+        throw std::invalid_argument("Invalid deadlock detector callback");
+    }
+    State& s = state();
+    std::lock_guard<std::mutex> control(s._controlMutex);
+    if (s._thread.joinable())
+    {
+        {//========= LOCKED SCOPE =========
+            std::lock_guard<std::mutex> lock(s._mutex);
+            s._stop = true;
+        }
+        s._cond.notify_all();
+        s._thread.join();
+    }
+    {//========= LOCKED SCOPE =========
+        std::lock_guard<std::mutex> lock(s._mutex);
+        s._stop = false;
+        s._threshold = threshold;
+        s._callback = std::move(callback);
+        s._waits.clear();
+        s._owners.clear();
+        s._isEnabled.store(true, std::memory_order_release);
+    }
+    s._thread = std::thread(&DeadlockDetector::run);
+}
+
+inline
+void DeadlockDetector::disable()
+{
+    State& s = state();
+    std::lock_guard<std::mutex> control(s._controlMutex);
+    {//========= LOCKED SCOPE =========
+        std::lock_guard<std::mutex> lock(s._mutex);
+        s._isEnabled.store(false, std::memory_order_release);
+        s._stop = true;
+        s._waits.clear();
+        s._owners.clear();
+    }
+    s._cond.notify_all();
+    if (s._thread.joinable())
+    {
+        s._thread.join();
+    }
+}
+
+inline
+bool DeadlockDetector::isEnabled()
+{
+    return state()._isEnabled.load(std::memory_order_relaxed);
+}
+
+inline
+std::vector<DeadlockDetector::Wait> DeadlockDetector::getWaits()
+{
+    std::vector<Wait> waits;
+    State& s = state();
+    Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(s._mutex);
+    for (auto&& entry : s._waits)
+    {
+        waits.push_back(makeWait(s, entry.first, entry.second, now));
+    }
+    return waits;
+}
+
+inline
+uint64_t DeadlockDetector::beginWait(Resource resource, const void* object)
+{
+    if (!isEnabled())
+    {
+        return 0;
+    }
+    const CurrentTask& task = currentTask();
+    uint64_t waiterId = currentWaiterId();
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s._mutex);
+    if (!s._isEnabled.load(std::memory_order_relaxed))
+    {
+        return 0; //disabled concurrently
+    }
+    bool isCoroutine = (task._taskId != 0);
+    WaitEntry entry{isCoroutine, isCoroutine ? task._queueId : 0, resource, object, Clock::now(), false};
+    return s._waits.emplace(waiterId, entry).second ? waiterId : 0;
+}
+
+inline
+void DeadlockDetector::endWait(uint64_t waiterId)
+{
+    if (waiterId == 0)
+    {
+        return;
+    }
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s._mutex);
+    s._waits.erase(waiterId);
+}
+
+inline
+void DeadlockDetector::onAcquire(const void* mutex)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    uint64_t ownerId = currentWaiterId();
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s._mutex);
+    if (s._isEnabled.load(std::memory_order_relaxed))
+    {
+        s._owners[mutex] = ownerId;
+    }
+}
+
+inline
+void DeadlockDetector::onRelease(const void* mutex)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s._mutex);
+    s._owners.erase(mutex);
+}
+
+inline
+void DeadlockDetector::setCurrentTask(uint64_t taskId, int queueId)
+{
+    CurrentTask& task = currentTask();
+    task._taskId = taskId;
+    task._queueId = queueId;
+}
+
+inline
+DeadlockDetector::State& DeadlockDetector::state()
+{
+    //Intentionally leaked so that the detector thread does not need to be joined during static destruction
+    static State* s = new State();
+    return *s;
+}
+
+inline
+DeadlockDetector::CurrentTask& DeadlockDetector::currentTask()
+{
+    static thread_local CurrentTask task;
+    return task;
+}
+
+inline
+uint64_t DeadlockDetector::currentWaiterId()
+{
+    const CurrentTask& task = currentTask();
+    if (task._taskId != 0)
+    {
+        return task._taskId;
+    }
+    static thread_local std::atomic<uint64_t> threadId{0};
+    return Tracer::taskId(threadId);
+}
+
+inline
+DeadlockDetector::Wait DeadlockDetector::makeWait(const State& s,
+                                                  uint64_t waiterId,
+                                                  const WaitEntry& entry,
+                                                  Clock::time_point now)
+{
+    uint64_t ownerId = 0;
+    if (entry._resource == Resource::Mutex)
+    {
+        auto it = s._owners.find(entry._object);
+        if (it != s._owners.end())
+        {
+            ownerId = it->second;
+        }
+    }
+    return {waiterId,
+            entry._isCoroutine,
+            entry._queueId,
+            entry._resource,
+            entry._object,
+            ownerId,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - entry._start)};
+}
+
+inline
+std::vector<DeadlockDetector::Report> DeadlockDetector::scan(State& s)
+{
+    std::vector<Report> reports;
+    Clock::time_point now = Clock::now();
+    std::vector<WaitEntry*> chain;
+    for (auto&& wait : s._waits)
+    {
+        if (wait.second._isReported)
+        {
+            continue;
+        }
+        //Follow the mutex owners until reaching a waiter which is not blocked on a mutex, or a cycle
+        Report report{Report::Type::LongWait, {}};
+        chain.clear();
+        uint64_t waiterId = wait.first;
+        WaitEntry* entry = &wait.second;
+        while (true)
+        {
+            chain.push_back(entry);
+            report._waits.push_back(makeWait(s, waiterId, *entry, now));
+            waiterId = report._waits.back()._ownerId;
+            if (waiterId == 0)
+            {
+                break;
+            }
+            if (waiterId == wait.first)
+            {
+                report._type = Report::Type::Deadlock;
+                break;
+            }
+            auto it = s._waits.find(waiterId);
+            if ((it == s._waits.end()) || (std::find(chain.begin(), chain.end(), &it->second) != chain.end()))
+            {
+                break; //owner is running, or is part of a cycle which is reported from its own members
+            }
+            entry = &it->second;
+        }
+        if (report._type == Report::Type::Deadlock)
+        {
+            for (WaitEntry* member : chain)
+            {
+                member->_isReported = true;
+            }
+        }
+        else if (report._waits.front()._elapsed >= s._threshold)
+        {
+            wait.second._isReported = true;
+        }
+        else
+        {
+            continue;
+        }
+        reports.emplace_back(std::move(report));
+    }
+    return reports;
+}
+
+inline
+void DeadlockDetector::run()
+{
+    State& s = state();
+    std::unique_lock<std::mutex> lock(s._mutex);
+    const std::chrono::milliseconds interval = std::max(s._threshold / 4, std::chrono::milliseconds(1));
+    while (!s._cond.wait_for(lock, interval, [&s]()->bool { return s._stop; }))
+    {
+        std::vector<Report> reports = scan(s);
+        lock.unlock();
+        for (const Report& report : reports)
+        {
+            s._callback(report); //only modified while this thread is stopped
+        }
+        lock.lock();
+    }
+}
+
+//==============================================================================================
+//                               class DeadlockDetector::WaitScope
+//==============================================================================================
+inline
+DeadlockDetector::WaitScope::WaitScope(Resource resource, const void* object)
+{
+    if (DeadlockDetector::isEnabled())
+    {
+        _waiterId = DeadlockDetector::beginWait(resource, object);
+    }
+}
+
+inline
+DeadlockDetector::WaitScope::~WaitScope()
+{
+    DeadlockDetector::endWait(_waiterId);
+}
+
+inline
+std::ostream& operator<<(std::ostream& out, const DeadlockDetector::Report& report)
+{
+    out << ((report._type == DeadlockDetector::Report::Type::Deadlock) ? "deadlock" : "long wait") << std::endl;
+    for (const DeadlockDetector::Wait& wait : report._waits)
+    {
+        out << "  " << (wait._isCoroutine ? "coro " : "thread ") << wait._waiterId;
+        if (wait._isCoroutine)
+        {
+            out << " queue=" << wait._queueId;
+        }
+        out << " waits on "
+            << ((wait._resource == DeadlockDetector::Resource::Mutex) ? "mutex " :
+                (wait._resource == DeadlockDetector::Resource::ConditionVariable) ? "condition " : "future ")
+            << wait._object;
+        if (wait._ownerId != 0)
+        {
+            out << " owned by " << wait._ownerId;
+        }
+        out << " for " << wait._elapsed.count() << "ns" << std::endl;
+    }
+    return out;
+}
+
+}}
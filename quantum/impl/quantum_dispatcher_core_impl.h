@@ -28,7 +28,9 @@ DispatcherCore::DispatcherCore(const Configuration& config) :
     _sharedIoQueues((config.getNumIoThreads() <= 0) ? 1 : config.getNumIoThreads(), IoQueue(config, nullptr)),
     _ioQueues((config.getNumIoThreads() <= 0) ? 1 : config.getNumIoThreads(), IoQueue(config, &_sharedIoQueues)),
     _loadBalanceSharedIoQueues(false),
-    _terminated(false)
+    _terminated(false),
+    _watchdogThreshold(config.getWatchdogThreshold()),
+    _watchdogCallback(config.getWatchdogCallback())
 {
     const int coroCount = (config.getNumCoroutineThreads() == -1) ? std::thread::hardware_concurrency() :
         (config.getNumCoroutineThreads() == 0) ? 1 : config.getNumCoroutineThreads();
@@ -53,6 +55,11 @@ DispatcherCore::DispatcherCore(const Configuration& config) :
                               false);
     }
 
+    if (config.getReuseCoroutines())
+    {
+        _coroutinePool.reset(new CoroutinePool(coroCount, config.getMaxIdleCoroutines()));
+    }
+    
     // start the coro threads
     _coroQueues.reserve(coroCount);
     for (int coroId = 0; coroId < coroCount; ++coroId)
@@ -87,6 +94,12 @@ DispatcherCore::DispatcherCore(const Configuration& config) :
             _coroQueues[i].pinToCore(i%cores);
         }
     }
+    
+    // start the watchdog
+    if ((_watchdogThreshold.count() > 0) && _watchdogCallback)
+    {
+        _watchdog = std::thread(&DispatcherCore::runWatchdog, this);
+    }
 }
 
 inline
@@ -101,6 +114,14 @@ void DispatcherCore::terminate()
     bool value{false};
     if (_terminated.compare_exchange_strong(value, true))
     {
+        if (_watchdog.joinable())
+        {
+            {//========= LOCKED SCOPE =========
+                std::lock_guard<std::mutex> lock(_watchdogMutex);
+            }
+            _watchdogCond.notify_all();
+            _watchdog.join();
+        }
         for (auto&& queue : _coroQueues)
         {
             queue.terminate();
@@ -474,5 +495,76 @@ const std::pair<int, int>& DispatcherCore::getCoroQueueIdRangeForAny() const
 {
     return _coroQueueIdRangeForAny;
 }
+
+inline
+CoroutinePool* DispatcherCore::getCoroutinePool() const
+{
+    return _coroutinePool.get();
+}
  
+inline
+DispatcherSnapshot DispatcherCore::snapshot() const
+{
+    DispatcherSnapshot snapshot;
+    //Reserve before walking the queues so that their locks are not held while allocating. The headroom
+    //absorbs tasks posted in the meantime.
+    size_t num = size(IQueue::QueueType::All, (int)IQueue::QueueId::All);
+    snapshot.reserve(num + num/4 + 16);
+    for (size_t i = 0; i < _coroQueues.size(); ++i)
+    {
+        _coroQueues[i].snapshot(snapshot, (int)i);
+    }
+    if (_sharedCoroAnyQueue)
+    {
+        _sharedCoroAnyQueue->snapshot(snapshot, (int)IQueue::QueueId::Any);
+    }
+    for (size_t i = 0; i < _ioQueues.size(); ++i)
+    {
+        _ioQueues[i].snapshot(snapshot, (int)i);
+    }
+    for (const IoQueue& queue : _sharedIoQueues)
+    {
+        queue.snapshot(snapshot, (int)IQueue::QueueId::Any);
+    }
+    snapshot.summarize();
+    return snapshot;
+}
+
+inline
+void DispatcherCore::runWatchdog()
+{
+    //Each slice is reported once, identified by its start time
+    std::vector<std::chrono::steady_clock::time_point> lastReported(_coroQueues.size() + 1);
+    auto check = [this, &lastReported](const TaskQueue& queue, int queueId, size_t index)
+    {
+        uint64_t taskId;
+        std::chrono::steady_clock::time_point start;
+        if (!queue.getCurrentSlice(taskId, start) || (start == lastReported[index]))
+        {
+            return;
+        }
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed >= _watchdogThreshold)
+        {
+            lastReported[index] = start;
+            _watchdogCallback(queueId, taskId, elapsed);
+        }
+    };
+    const std::chrono::milliseconds interval = std::max(_watchdogThreshold / 4, std::chrono::milliseconds(1));
+    std::unique_lock<std::mutex> lock(_watchdogMutex);
+    while (!_watchdogCond.wait_for(lock, interval, [this]()->bool { return _terminated; }))
+    {
+        lock.unlock();
+        for (size_t i = 0; i < _coroQueues.size(); ++i)
+        {
+            check(_coroQueues[i], (int)i, i);
+        }
+        if (_sharedCoroAnyQueue)
+        {
+            check(*_sharedCoroAnyQueue, (int)IQueue::QueueId::Any, _coroQueues.size());
+        }
+        lock.lock();
+    }
+}
+
 }}
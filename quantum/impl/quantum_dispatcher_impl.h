@@ -200,6 +200,58 @@ Dispatcher::postAsyncIo2(int queueId,
                                  std::forward<ARGS>(args)...);
 }
 
+template <class RET, class FUNC, class ... ARGS>
+auto
+Dispatcher::postLite(FUNC&& func,
+                     ARGS&&... args)->ThreadFuturePtr<decltype(ioResult(func))>
+{
+    using Ret = decltype(ioResult(func));
+    return postLiteImpl<Ret>((int)IQueue::QueueId::Any,
+                             false,
+                             std::forward<FUNC>(func),
+                             std::forward<ARGS>(args)...);
+}
+
+template <class RET, class FUNC, class ... ARGS>
+auto
+Dispatcher::postLite2(FUNC&& func,
+                      ARGS&&... args)->ThreadFuturePtr<decltype(resultOf2(func))>
+{
+    using Ret = decltype(resultOf2(func));
+    return postLiteImpl<Ret>((int)IQueue::QueueId::Any,
+                             false,
+                             std::forward<FUNC>(func),
+                             std::forward<ARGS>(args)...);
+}
+
+template <class RET, class FUNC, class ... ARGS>
+auto
+Dispatcher::postLite(int queueId,
+                     bool isHighPriority,
+                     FUNC&& func,
+                     ARGS&&... args)->ThreadFuturePtr<decltype(ioResult(func))>
+{
+    using Ret = decltype(ioResult(func));
+    return postLiteImpl<Ret>(queueId,
+                             isHighPriority,
+                             std::forward<FUNC>(func),
+                             std::forward<ARGS>(args)...);
+}
+
+template <class RET, class FUNC, class ... ARGS>
+auto
+Dispatcher::postLite2(int queueId,
+                      bool isHighPriority,
+                      FUNC&& func,
+                      ARGS&&... args)->ThreadFuturePtr<decltype(resultOf2(func))>
+{
+    using Ret = decltype(resultOf2(func));
+    return postLiteImpl<Ret>(queueId,
+                             isHighPriority,
+                             std::forward<FUNC>(func),
+                             std::forward<ARGS>(args)...);
+}
+
 template <class RET, class INPUT_IT, class FUNC, class>
 auto
 Dispatcher::forEach(INPUT_IT first,
@@ -245,6 +297,170 @@ Dispatcher::forEachBatch(INPUT_IT first,
                  getNumCoroutineThreads());
 }
 
+template <class INPUT_IT, class FUNC, class>
+auto
+Dispatcher::forEachChunk(INPUT_IT first,
+                         INPUT_IT last,
+                         size_t chunkSize,
+                         FUNC&& func)->ThreadContextPtr<typename Traits::ChunkResults<decltype(coroResult(func))>::Type>
+{
+    using Ret = decltype(coroResult(func));
+    return post2(Util::forEachChunkCoro<Ret, INPUT_IT, FUNC&&>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 size_t{chunkSize},
+                 std::forward<FUNC>(func));
+}
+
+template <class INPUT_IT, class OUTPUT_IT, class FUNC, class>
+ThreadContextPtr<int>
+Dispatcher::forEachChunk(INPUT_IT first,
+                         INPUT_IT last,
+                         size_t chunkSize,
+                         OUTPUT_IT outFirst,
+                         FUNC&& func)
+{
+    return post2(Util::forEachChunkOutputCoro<INPUT_IT, OUTPUT_IT, FUNC&&>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 size_t{chunkSize},
+                 OUTPUT_IT{outFirst},
+                 std::forward<FUNC>(func));
+}
+
+template <class INPUT_IT, class FUNC, class>
+auto
+Dispatcher::forEachAsyncIo(INPUT_IT first,
+                           INPUT_IT last,
+                           FUNC&& func,
+                           size_t chunkSize)->ThreadContextPtr<typename Traits::ChunkResults<decltype(resultOf2(func))>::Type>
+{
+    using Ret = decltype(resultOf2(func));
+    return post2(Util::forEachAsyncIoCoro<Ret, INPUT_IT, FUNC&&>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 size_t{chunkSize},
+                 std::forward<FUNC>(func));
+}
+
+template <class INPUT_IT, class FUNC, class>
+auto
+Dispatcher::parallelFor(INPUT_IT first,
+                        INPUT_IT last,
+                        FUNC&& func,
+                        size_t grainSize)->ThreadContextPtr<std::vector<decltype(coroResult(func))>>
+{
+    using Ret = decltype(coroResult(func));
+    return post2(Util::parallelForCoro<Ret, INPUT_IT, FUNC&&>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 std::forward<FUNC>(func),
+                 size_t{grainSize});
+}
+
+template <class FUNC>
+ThreadContextPtr<int>
+Dispatcher::parallelFor2D(size_t rows,
+                          size_t cols,
+                          size_t tileRows,
+                          size_t tileCols,
+                          FUNC&& func)
+{
+    return post2(Util::parallelFor2DCoro<FUNC&&>,
+                 size_t{rows},
+                 size_t{cols},
+                 size_t{tileRows},
+                 size_t{tileCols},
+                 std::forward<FUNC>(func));
+}
+
+template <class INPUT_IT, class T, class FUNC, class>
+ThreadContextPtr<T>
+Dispatcher::reduce(INPUT_IT first,
+                   INPUT_IT last,
+                   T init,
+                   FUNC&& func,
+                   size_t grainSize)
+{
+    return transformReduce(first, last, std::move(init), std::forward<FUNC>(func), Util::Identity{}, grainSize);
+}
+
+template <class INPUT_IT, class T, class REDUCE_FUNC, class TRANSFORM_FUNC, class>
+ThreadContextPtr<T>
+Dispatcher::transformReduce(INPUT_IT first,
+                            INPUT_IT last,
+                            T init,
+                            REDUCE_FUNC&& reduceFunc,
+                            TRANSFORM_FUNC&& transformFunc,
+                            size_t grainSize)
+{
+    using ReduceFunc = typename std::decay<REDUCE_FUNC>::type;
+    using TransformFunc = typename std::decay<TRANSFORM_FUNC>::type;
+    return post2(Util::transformReduceCoro<T, INPUT_IT, ReduceFunc, TransformFunc>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 std::move(init),
+                 std::forward<REDUCE_FUNC>(reduceFunc),
+                 std::forward<TRANSFORM_FUNC>(transformFunc),
+                 size_t{grainSize});
+}
+
+template <class INPUT_IT, class FUNC, class>
+ThreadContextPtr<std::vector<typename std::iterator_traits<INPUT_IT>::value_type>>
+Dispatcher::inclusiveScan(INPUT_IT first,
+                          INPUT_IT last,
+                          FUNC&& func)
+{
+    using T = typename std::iterator_traits<INPUT_IT>::value_type;
+    return post2(Util::scanCoro<T, INPUT_IT, typename std::decay<FUNC>::type>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 T{},
+                 std::forward<FUNC>(func),
+                 true);
+}
+
+template <class INPUT_IT, class T, class FUNC, class>
+ThreadContextPtr<std::vector<T>>
+Dispatcher::exclusiveScan(INPUT_IT first,
+                          INPUT_IT last,
+                          T init,
+                          FUNC&& func)
+{
+    return post2(Util::scanCoro<T, INPUT_IT, typename std::decay<FUNC>::type>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 std::move(init),
+                 std::forward<FUNC>(func),
+                 false);
+}
+
+template <class RANDOM_IT, class COMPARE, class>
+ThreadContextPtr<int>
+Dispatcher::sort(RANDOM_IT first,
+                 RANDOM_IT last,
+                 COMPARE compare)
+{
+    return post2(Util::sortCoro<RANDOM_IT, COMPARE>,
+                 RANDOM_IT{first},
+                 (size_t)std::distance(first, last),
+                 std::move(compare),
+                 false);
+}
+
+template <class RANDOM_IT, class COMPARE, class>
+ThreadContextPtr<int>
+Dispatcher::stableSort(RANDOM_IT first,
+                       RANDOM_IT last,
+                       COMPARE compare)
+{
+    return post2(Util::sortCoro<RANDOM_IT, COMPARE>,
+                 RANDOM_IT{first},
+                 (size_t)std::distance(first, last),
+                 std::move(compare),
+                 true);
+}
+
 template <class KEY,
           class MAPPED_TYPE,
           class REDUCED_TYPE,
@@ -283,7 +499,34 @@ Dispatcher::mapReduce(INPUT_IT first,
                  INPUT_IT{first},
                  size_t{num},
                  Functions::MapFunc<Key, MappedType, INPUT_IT>{std::move(mapper)},
-                 Functions::ReduceFunc<Key, MappedType, ReducedType>{std::move(reducer)});
+                 Functions::ReduceFunc<Key, MappedType, ReducedType>{std::move(reducer)},
+                 Functions::CombineFunc<Key, MappedType>{});
+}
+
+template <class MAPPER_FUNC,
+          class REDUCER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class INPUT_IT,
+          class>
+auto
+Dispatcher::mapReduce(INPUT_IT first,
+                      INPUT_IT last,
+                      MAPPER_FUNC mapper,
+                      REDUCER_FUNC reducer,
+                      COMBINER_FUNC combiner,
+                      OUTPUT)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using ReducedType = decltype(reducedTypeOf(reducer));
+    return post2(Util::mapReduceCoro<Key, MappedType, ReducedType, INPUT_IT, OUTPUT>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 Functions::MapFunc<Key, MappedType, INPUT_IT>{std::move(mapper)},
+                 Functions::ReduceFunc<Key, MappedType, ReducedType>{std::move(reducer)},
+                 Functions::CombineFunc<Key, MappedType>{std::move(combiner)});
 }
 
 template <class KEY,
@@ -324,7 +567,84 @@ Dispatcher::mapReduceBatch(INPUT_IT first,
                  INPUT_IT{first},
                  size_t{num},
                  Functions::MapFunc<Key, MappedType, INPUT_IT>{std::move(mapper)},
-                 Functions::ReduceFunc<Key, MappedType, ReducedType>{std::move(reducer)});
+                 Functions::ReduceFunc<Key, MappedType, ReducedType>{std::move(reducer)},
+                 Functions::CombineFunc<Key, MappedType>{});
+}
+
+template <class MAPPER_FUNC,
+          class REDUCER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class INPUT_IT,
+          class>
+auto
+Dispatcher::mapReduceBatch(INPUT_IT first,
+                           INPUT_IT last,
+                           MAPPER_FUNC mapper,
+                           REDUCER_FUNC reducer,
+                           COMBINER_FUNC combiner,
+                           OUTPUT)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using ReducedType = decltype(reducedTypeOf(reducer));
+    return post2(Util::mapReduceBatchCoro<Key, MappedType, ReducedType, INPUT_IT, OUTPUT>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 Functions::MapFunc<Key, MappedType, INPUT_IT>{std::move(mapper)},
+                 Functions::ReduceFunc<Key, MappedType, ReducedType>{std::move(reducer)},
+                 Functions::CombineFunc<Key, MappedType>{std::move(combiner)});
+}
+
+template <class MAPPER_FUNC,
+          class REDUCER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class INPUT_IT,
+          class>
+auto
+Dispatcher::mapReduceAsyncIo(INPUT_IT first,
+                             INPUT_IT last,
+                             MAPPER_FUNC mapper,
+                             REDUCER_FUNC reducer,
+                             COMBINER_FUNC combiner,
+                             OUTPUT,
+                             size_t chunkSize)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using ReducedType = decltype(reducedTypeOf(reducer));
+    return post2(Util::mapReduceAsyncIoCoro<Key, MappedType, ReducedType, INPUT_IT, OUTPUT>,
+                 INPUT_IT{first},
+                 (size_t)std::distance(first, last),
+                 Functions::IoMapFunc<Key, MappedType, INPUT_IT>{std::move(mapper)},
+                 Functions::IoReduceFunc<Key, MappedType, ReducedType>{std::move(reducer)},
+                 Functions::CombineFunc<Key, MappedType>{std::move(combiner)},
+                 size_t{chunkSize});
+}
+
+template <class MAPPER_FUNC,
+          class COMBINER_FUNC,
+          class OUTPUT,
+          class SOURCE>
+auto
+Dispatcher::mapReduceStream(SOURCE source,
+                            MAPPER_FUNC mapper,
+                            COMBINER_FUNC combiner,
+                            OUTPUT,
+                            size_t batchSize)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(mappedTypeOf(mapper))>>
+{
+    using Key = decltype(mappedKeyOf(mapper));
+    using MappedType = decltype(mappedTypeOf(mapper));
+    using Record = typename Traits::BufferSource<SOURCE>::Type;
+    return post2(Util::mapReduceStreamCoro<Key, MappedType, Record, SOURCE, OUTPUT>,
+                 std::move(source),
+                 Functions::StreamMapFunc<Key, MappedType, Record>{std::move(mapper)},
+                 Functions::CombineFunc<Key, MappedType>{std::move(combiner)},
+                 size_t{batchSize});
 }
 
 inline
@@ -414,6 +734,12 @@ void Dispatcher::resetStats()
     _dispatcher.resetStats();
 }
 
+inline
+DispatcherSnapshot Dispatcher::snapshot() const
+{
+    return _dispatcher.snapshot();
+}
+
 template <class RET, class FUNC, class ... ARGS>
 ThreadContextPtr<RET>
 Dispatcher::postImpl(int queueId,
@@ -435,6 +761,7 @@ Dispatcher::postImpl(int queueId,
                                Context<RET>::deleter);
     auto task = Task::Ptr(new Task(Traits::IsVoidContext<FirstArg>{},
                                    ctx,
+                                   _dispatcher.getCoroutinePool(),
                                    queueId,
                                    isHighPriority,
                                    type,
@@ -477,4 +804,32 @@ Dispatcher::postAsyncIoImpl(int queueId,
     return promise->getIThreadFuture();
 }
 
+template <class RET, class FUNC, class ... ARGS>
+ThreadFuturePtr<RET>
+Dispatcher::postLiteImpl(int queueId,
+                         bool isHighPriority,
+                         FUNC&& func,
+                         ARGS&&... args)
+{
+    using FirstArg = decltype(firstArgOf(func));
+    if (_drain || _terminated)
+    {
+        throw std::runtime_error("Posting is disabled");
+    }
+    if (queueId < (int)IQueue::QueueId::Any)
+    {
+        throw std::runtime_error("Invalid coroutine queue id");
+    }
+    auto promise = PromisePtr<RET>(new Promise<RET>(), Promise<RET>::deleter);
+    auto task = Task::Ptr(new Task(Traits::IsThreadPromise<FirstArg>{},
+                                   promise,
+                                   queueId,
+                                   isHighPriority,
+                                   std::forward<FUNC>(func),
+                                   std::forward<ARGS>(args)...),
+                          Task::deleter);
+    _dispatcher.post(task);
+    return promise->getIThreadFuture();
+}
+
 }}
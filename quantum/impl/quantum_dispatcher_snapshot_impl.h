@@ -0,0 +1,126 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+DispatcherSnapshot::DispatcherSnapshot() :
+    _time(std::chrono::steady_clock::now())
+{
+    _counts.fill(0);
+}
+
+inline
+const std::vector<TaskSnapshot>& DispatcherSnapshot::getTasks() const
+{
+    return _tasks;
+}
+
+inline
+size_t DispatcherSnapshot::getCount(State state) const
+{
+    return _counts.at((size_t)state);
+}
+
+inline
+const Histogram& DispatcherSnapshot::getAgeHistogram(State state) const
+{
+    return _ages.at((size_t)state);
+}
+
+inline
+std::chrono::steady_clock::time_point DispatcherSnapshot::getTime() const
+{
+    return _time;
+}
+
+inline
+void DispatcherSnapshot::print(std::ostream& out) const
+{
+    for (size_t i = 0; i < (size_t)State::Max; ++i)
+    {
+        if (_counts[i] > 0)
+        {
+            out << nameOf((State)i) << ": " << _counts[i] << " age(ns) " << _ages[i] << std::endl;
+        }
+    }
+    for (const TaskSnapshot& task : _tasks)
+    {
+        out << ((task._queueType == IQueue::QueueType::IO) ? "io " : "coro ") << task._taskId
+            << " queue=" << task._queueId
+            << " state=" << nameOf(task._state)
+            << " type=" << (int)task._type
+            << " priority=" << (task._isHighPriority ? "high" : "normal")
+            << " age(ns)=" << task._age.count();
+        if (task._tag)
+        {
+            out << " tag=" << task._tag;
+        }
+        out << std::endl;
+    }
+}
+
+inline
+const char* DispatcherSnapshot::nameOf(State state)
+{
+    switch (state)
+    {
+        case State::NotStarted: return "NotStarted";
+        case State::Running: return "Running";
+        case State::Runnable: return "Runnable";
+        case State::Blocked: return "Blocked";
+        case State::Sleeping: return "Sleeping";
+        case State::Completed: return "Completed";
+        default: return "Unknown";
+    }
+}
+
+inline
+void DispatcherSnapshot::reserve(size_t num)
+{
+    _tasks.reserve(_tasks.size() + num);
+}
+
+inline
+void DispatcherSnapshot::add(const TaskSnapshot& task)
+{
+    _tasks.push_back(task);
+}
+
+inline
+void DispatcherSnapshot::summarize()
+{
+    for (const TaskSnapshot& task : _tasks)
+    {
+        ++_counts[(size_t)task._state];
+        _ages[(size_t)task._state].record(task._age.count() > 0 ? task._age.count() : 0);
+    }
+}
+
+inline
+std::ostream& operator<<(std::ostream& out, const DispatcherSnapshot& snapshot)
+{
+    snapshot.print(out);
+    return out;
+}
+
+}}
@@ -0,0 +1,156 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                   class Generator::Yield
+//==============================================================================================
+template <class T>
+Generator<T>::Yield::Yield(Push& push) :
+    _push(push)
+{}
+
+template <class T>
+void Generator<T>::Yield::operator()(T& value)
+{
+    _push(std::addressof(value)); //the consumer reads the value in place while the producer is suspended
+}
+
+template <class T>
+void Generator<T>::Yield::operator()(T&& value)
+{
+    _push(std::addressof(value)); //the temporary outlives the suspension
+}
+
+template <class T>
+void Generator<T>::Yield::operator()(const T& value)
+{
+    T copy(value);
+    _push(std::addressof(copy));
+}
+
+//==============================================================================================
+//                                  class Generator::Iterator
+//==============================================================================================
+template <class T>
+Generator<T>::Iterator::Iterator(Generator<T>* generator) :
+    _generator(generator)
+{}
+
+template <class T>
+typename Generator<T>::Iterator::reference Generator<T>::Iterator::operator*() const
+{
+    return _generator->value();
+}
+
+template <class T>
+typename Generator<T>::Iterator::pointer Generator<T>::Iterator::operator->() const
+{
+    return std::addressof(_generator->value());
+}
+
+template <class T>
+typename Generator<T>::Iterator& Generator<T>::Iterator::operator++()
+{
+    if (!_generator->next())
+    {
+        _generator = nullptr; //reached the end
+    }
+    return *this;
+}
+
+template <class T>
+void Generator<T>::Iterator::operator++(int)
+{
+    ++(*this);
+}
+
+template <class T>
+bool Generator<T>::Iterator::operator==(const Iterator& other) const
+{
+    return _generator == other._generator;
+}
+
+template <class T>
+bool Generator<T>::Iterator::operator!=(const Iterator& other) const
+{
+    return _generator != other._generator;
+}
+
+//==============================================================================================
+//                                      class Generator
+//==============================================================================================
+template <class T>
+template <class FUNC, class ... ARGS>
+Generator<T>::Generator(FUNC&& func, ARGS&&... args) :
+    _pull(Allocator<CoroStackAllocator>::instance(AllocatorTraits::defaultCoroPoolAllocSize()),
+          [func = std::decay_t<FUNC>(std::forward<FUNC>(func)),
+           args = std::make_tuple(std::forward<ARGS>(args)...)](Push& push) mutable
+          {
+              push(static_cast<T*>(nullptr)); //return from the constructor without running the producer
+              Yield yield(push);
+              apply<void>(func, std::move(args), yield);
+          })
+{}
+
+template <class T>
+bool Generator<T>::next()
+{
+    _value = nullptr;
+    if (_pull)
+    {
+        _pull(); //resume the producer
+        if (_pull)
+        {
+            _value = _pull.get();
+        }
+    }
+    return _value != nullptr;
+}
+
+template <class T>
+T& Generator<T>::value() const
+{
+    assert(_value);
+    return *_value;
+}
+
+template <class T>
+bool Generator<T>::done() const
+{
+    return !_pull;
+}
+
+template <class T>
+typename Generator<T>::Iterator Generator<T>::begin()
+{
+    return next() ? Iterator(this) : Iterator();
+}
+
+template <class T>
+typename Generator<T>::Iterator Generator<T>::end()
+{
+    return Iterator();
+}
+
+}}
@@ -0,0 +1,195 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+#include <algorithm>
+#include <limits>
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+Histogram::Histogram()
+{
+    reset();
+}
+
+inline
+Histogram::Histogram(const Histogram& other)
+{
+    reset();
+    *this += other;
+}
+
+inline
+Histogram& Histogram::operator=(const Histogram& other)
+{
+    if (this != &other)
+    {
+        reset();
+        *this += other;
+    }
+    return *this;
+}
+
+inline
+void Histogram::record(uint64_t value)
+{
+    _buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t current = _min.load(std::memory_order_relaxed);
+    while ((value < current) && !_min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    current = _max.load(std::memory_order_relaxed);
+    while ((value > current) && !_max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+}
+
+inline
+void Histogram::reset()
+{
+    for (auto&& bucket : _buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _count = 0;
+    _sum = 0;
+    _min = std::numeric_limits<uint64_t>::max();
+    _max = 0;
+}
+
+inline
+size_t Histogram::count() const
+{
+    return _count.load(std::memory_order_relaxed);
+}
+
+inline
+uint64_t Histogram::min() const
+{
+    return count() ? _min.load(std::memory_order_relaxed) : 0;
+}
+
+inline
+uint64_t Histogram::max() const
+{
+    return _max.load(std::memory_order_relaxed);
+}
+
+inline
+double Histogram::mean() const
+{
+    size_t num = count();
+    return num ? (double)_sum.load(std::memory_order_relaxed)/num : 0.0;
+}
+
+inline
+uint64_t Histogram::percentile(double percent) const
+{
+    //Buckets are read individually so the total may differ slightly from count() while values are being recorded
+    uint64_t total = 0;
+    for (auto&& bucket : _buckets)
+    {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+    percent = std::min(std::max(percent, 0.0), 100.0);
+    uint64_t rank = std::max((uint64_t)1, (uint64_t)(percent * total / 100.0 + 0.5));
+    uint64_t cumulative = 0;
+    for (size_t bucket = 0; bucket < numBuckets; ++bucket)
+    {
+        cumulative += _buckets[bucket].load(std::memory_order_relaxed);
+        if (cumulative >= rank)
+        {
+            return std::min(highestValueOf(bucket), max());
+        }
+    }
+    return max();
+}
+
+inline
+Histogram& Histogram::operator+=(const Histogram& rhs)
+{
+    for (size_t bucket = 0; bucket < numBuckets; ++bucket)
+    {
+        _buckets[bucket].fetch_add(rhs._buckets[bucket].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    _count.fetch_add(rhs._count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _sum.fetch_add(rhs._sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    uint64_t value = rhs._min.load(std::memory_order_relaxed);
+    uint64_t current = _min.load(std::memory_order_relaxed);
+    while ((value < current) && !_min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    value = rhs._max.load(std::memory_order_relaxed);
+    current = _max.load(std::memory_order_relaxed);
+    while ((value > current) && !_max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    return *this;
+}
+
+inline
+void Histogram::print(std::ostream& out) const
+{
+    out << "count=" << count()
+        << " mean=" << mean()
+        << " p50=" << percentile(50)
+        << " p90=" << percentile(90)
+        << " p99=" << percentile(99)
+        << " p99.9=" << percentile(99.9)
+        << " max=" << max();
+}
+
+inline
+size_t Histogram::bucketOf(uint64_t value)
+{
+    if (value < numSubBuckets)
+    {
+        return (size_t)value;
+    }
+    //position of the most significant bit, which is at least 4 here
+#if defined(__GNUC__) || defined(__clang__)
+    size_t msb = 63 - __builtin_clzll(value);
+#else
+    size_t msb = 0;
+    for (uint64_t v = value; v >>= 1; ++msb);
+#endif
+    size_t shift = msb - 4;
+    return numSubBuckets + shift * numSubBuckets + (size_t)((value >> shift) - numSubBuckets);
+}
+
+inline
+uint64_t Histogram::highestValueOf(size_t bucket)
+{
+    if (bucket < numSubBuckets)
+    {
+        return bucket;
+    }
+    size_t shift = (bucket - numSubBuckets) / numSubBuckets;
+    uint64_t lowest = (uint64_t)(numSubBuckets + (bucket % numSubBuckets)) << shift;
+    return lowest + ((uint64_t)1 << shift) - 1;
+}
+
+inline
+std::ostream& operator<<(std::ostream& out, const Histogram& histogram)
+{
+    histogram.print(out);
+    return out;
+}
+
+}}
@@ -129,6 +129,9 @@ void IoQueue::run()
             //========================= START TASK =========================
             int rc = task->run();
             //========================== END TASK ==========================
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+            std::static_pointer_cast<IoTask>(task)->getTiming().record(_stats);
+#endif
 
             if (rc == (int)ITask::RetCode::Success)
             {
@@ -227,6 +230,13 @@ void IoQueue::doEnqueue(ITask::Ptr task)
     }
     _stats.incPostedCount();
     _stats.incNumElements();
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    std::static_pointer_cast<IoTask>(task)->getTiming().onPost();
+#endif
+    if (Tracer::isEnabled())
+    {
+        Tracer::record(Tracer::EventType::IoPost, std::static_pointer_cast<IoTask>(task)->getTraceId(), task->getQueueId());
+    }
     if (!_loadBalanceSharedIoQueues && isEmpty)
     {
         //signal on transition from 0 to 1 element only
@@ -453,4 +463,22 @@ const std::shared_ptr<std::thread>& IoQueue::getThread() const
     return _thread;
 }
 
+inline
+void IoQueue::snapshot(DispatcherSnapshot& snapshot, int queueId) const
+{
+    //========================= LOCKED SCOPE =========================
+    SpinLock::Guard lock(_spinlock);
+    for (const IoTaskPtr& task : _queue)
+    {
+        snapshot.add({task->getTraceId(),
+                      queueId,
+                      IQueue::QueueType::IO,
+                      ITask::Type::IO,
+                      TaskSnapshot::State::NotStarted,
+                      task->isHighPriority(),
+                      snapshot.getTime() - task->getCreationTime(),
+                      nullptr});
+    }
+}
+
 }}
@@ -80,7 +80,27 @@ void IoTask::terminate()
 inline
 int IoTask::run()
 {
-    return _func ? _func() : (int)ITask::RetCode::NotCallable;
+    if (!_func)
+    {
+        return (int)ITask::RetCode::NotCallable;
+    }
+    const bool isTraced = Tracer::isEnabled();
+    if (isTraced)
+    {
+        Tracer::record(Tracer::EventType::IoStart, getTraceId(), _queueId);
+    }
+    int rc;
+    {
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+        TaskTiming::RunGuard timer(_timing);
+#endif
+        rc = _func();
+    }
+    if (isTraced)
+    {
+        Tracer::record(Tracer::EventType::IoComplete, getTraceId(), _queueId);
+    }
+    return rc;
 }
 
 inline
@@ -125,6 +145,26 @@ bool IoTask::isSuspended() const
     return false;
 }
 
+inline
+uint64_t IoTask::getTraceId()
+{
+    return Tracer::taskId(_traceId);
+}
+
+inline
+std::chrono::steady_clock::time_point IoTask::getCreationTime() const
+{
+    return _creationTime;
+}
+
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+inline
+TaskTiming& IoTask::getTiming()
+{
+    return _timing;
+}
+#endif
+
 inline
 void* IoTask::operator new(size_t)
 {
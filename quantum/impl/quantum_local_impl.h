@@ -27,17 +27,54 @@ namespace Bloomberg {
 namespace quantum {
 namespace local {
 
-template <typename T>
-T*& variable(const std::string& key)
+inline
+CoroLocalStorage& currentStorage()
 {
-    // default thread local map to be used outside of coroutines
-    thread_local Task::CoroLocalStorage defaultStorage;
+    // default thread local storage to be used outside of coroutines
+    thread_local CoroLocalStorage defaultStorage;
     
     Task* task = TaskQueue::getCurrentTask();
-    Task::CoroLocalStorage& storage = task ? task->getCoroLocalStorage() : defaultStorage;
-    
-    void** r = &storage.emplace(key, nullptr).first->second;
-    return *reinterpret_cast<T**>(r);
+    return task ? task->getCoroLocalStorage() : defaultStorage;
+}
+
+inline
+Slot registerSlot(const std::string& name)
+{
+    return CoroLocalStorage::registerSlot(name);
+}
+
+inline
+Slot registerSlot()
+{
+    return CoroLocalStorage::registerSlot();
+}
+
+template <typename T>
+T*& variable(Slot slot)
+{
+    void*& r = currentStorage().at(slot);
+    return *reinterpret_cast<T**>(&r);
+}
+
+template <typename T>
+T* get(Slot slot)
+{
+    return static_cast<T*>(currentStorage().get(slot));
+}
+
+template <typename T>
+void set(Slot slot, T* value)
+{
+    currentStorage().at(slot) = value;
+}
+
+template <typename T>
+T*& variable(const std::string& key)
+{
+    CoroLocalStorage& storage = currentStorage();
+    CoroLocalStorage::Slot slot;
+    void*& r = CoroLocalStorage::findSlot(key, slot) ? storage.at(slot) : storage.at(key);
+    return *reinterpret_cast<T**>(&r);
 }
 
 inline
@@ -51,4 +88,14 @@ VoidContextPtr context()
     return std::static_pointer_cast<Context<Void>, ITaskAccessor>(task->getTaskAccessor());
 }
 
+inline
+void setTag(const char* tag)
+{
+    Task* task = TaskQueue::getCurrentTask();
+    if (task)
+    {
+        task->setTag(tag);
+    }
+}
+
 }}}
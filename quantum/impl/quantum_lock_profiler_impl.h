@@ -0,0 +1,155 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                       class LockProfile
+//==============================================================================================
+inline
+size_t LockProfile::acquisitions() const
+{
+    return _acquisitions.load(std::memory_order_relaxed);
+}
+
+inline
+size_t LockProfile::contendedAcquisitions() const
+{
+    return _contendedAcquisitions.load(std::memory_order_relaxed);
+}
+
+inline
+size_t LockProfile::spinCount() const
+{
+    return _spinCount.load(std::memory_order_relaxed);
+}
+
+inline
+size_t LockProfile::yieldCount() const
+{
+    return _yieldCount.load(std::memory_order_relaxed);
+}
+
+inline
+const Histogram& LockProfile::holdTime() const
+{
+    return _holdTime;
+}
+
+inline
+void LockProfile::reset()
+{
+    _acquisitions = 0;
+    _contendedAcquisitions = 0;
+    _spinCount = 0;
+    _yieldCount = 0;
+    _holdTime.reset();
+}
+
+inline
+void LockProfile::print(std::ostream& out) const
+{
+    out << "acquisitions=" << acquisitions()
+        << " contended=" << contendedAcquisitions()
+        << " spins=" << spinCount()
+        << " yields=" << yieldCount()
+        << " hold(ns): " << _holdTime;
+}
+
+inline
+void LockProfile::onAcquire(size_t numSpins, size_t numYields)
+{
+    _acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if ((numSpins > 0) || (numYields > 0))
+    {
+        _contendedAcquisitions.fetch_add(1, std::memory_order_relaxed);
+        _spinCount.fetch_add(numSpins, std::memory_order_relaxed);
+        _yieldCount.fetch_add(numYields, std::memory_order_relaxed);
+    }
+}
+
+inline
+void LockProfile::onRelease(Clock::time_point acquireTime)
+{
+    _holdTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - acquireTime).count());
+}
+
+//==============================================================================================
+//                                       class LockProfiler
+//==============================================================================================
+inline
+LockProfile& LockProfiler::get(const std::string& name)
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r._mutex);
+    std::unique_ptr<LockProfile>& profile = r._profiles[name];
+    if (!profile)
+    {
+        profile.reset(new LockProfile());
+    }
+    return *profile;
+}
+
+inline
+LockProfiler::ProfileMap LockProfiler::getProfiles()
+{
+    ProfileMap profiles;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r._mutex);
+    for (auto&& entry : r._profiles)
+    {
+        profiles.emplace(entry.first, entry.second.get());
+    }
+    return profiles;
+}
+
+inline
+void LockProfiler::reset()
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r._mutex);
+    for (auto&& entry : r._profiles)
+    {
+        entry.second->reset();
+    }
+}
+
+inline
+void LockProfiler::print(std::ostream& out)
+{
+    for (auto&& entry : getProfiles())
+    {
+        out << entry.first << ": ";
+        entry.second->print(out);
+        out << std::endl;
+    }
+}
+
+inline
+LockProfiler::Registry& LockProfiler::registry()
+{
+    //Intentionally leaked so that locks destroyed during static destruction can still report
+    static Registry* r = new Registry();
+    return *r;
+}
+
+}}
@@ -41,6 +41,15 @@ inline
 Mutex::Mutex()
 {}
 
+inline
+Mutex::Mutex(const char* name)
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    : _profile(&LockProfiler::get(name))
+#endif
+{
+    (void)name;
+}
+
 inline
 void Mutex::lock()
 {
@@ -56,24 +65,62 @@ void Mutex::lock(ICoroSync::Ptr sync)
 inline
 void Mutex::lockImpl(ICoroSync::Ptr sync)
 {
-    while (!tryLock())
+    size_t numYields = 0;
+    uint64_t waiterId = 0;
+    while (!_spinlock.tryLock())
     {
+        if ((numYields++ == 0) && DeadlockDetector::isEnabled())
+        {
+            waiterId = DeadlockDetector::beginWait(DeadlockDetector::Resource::Mutex, this);
+        }
         yield(sync);
     }
+    if (waiterId != 0)
+    {
+        DeadlockDetector::endWait(waiterId);
+    }
+    onLocked(numYields);
 }
 
 inline
 bool Mutex::tryLock()
 {
-    return _spinlock.tryLock();
+    bool isLocked = _spinlock.tryLock();
+    if (isLocked)
+    {
+        onLocked(0);
+    }
+    return isLocked;
 }
 
 inline
 void Mutex::unlock()
 {
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile)
+    {
+        _profile->onRelease(_acquireTime);
+    }
+#endif
+    DeadlockDetector::onRelease(this);
     _spinlock.unlock();
 }
 
+inline
+void Mutex::onLocked(size_t numYields)
+{
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile)
+    {
+        _profile->onAcquire(0, numYields);
+        _acquireTime = LockProfile::Clock::now();
+    }
+#else
+    (void)numYields;
+#endif
+    DeadlockDetector::onAcquire(this);
+}
+
 //==============================================================================================
 //                                class Mutex::Guard
 //==============================================================================================
@@ -30,38 +30,55 @@ QueueStatistics::QueueStatistics()
 
 inline
 QueueStatistics::QueueStatistics(const QueueStatistics& other) :
-    _numElements(other.numElements()),
-    _errorCount(other._errorCount),
-    _sharedQueueErrorCount(other._sharedQueueErrorCount),
-    _completedCount(other._completedCount),
-    _sharedQueueCompletedCount(other._sharedQueueCompletedCount),
-    _postedCount(other._postedCount),
-    _highPriorityCount(other._highPriorityCount)
+    _numElements(other.numElements())
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+   ,_queueWaitTime(other._queueWaitTime),
+    _executionTime(other._executionTime),
+    _totalTime(other._totalTime),
+    _resumeCount(other._resumeCount)
+#endif
 {
+    //Collapse all the shards of 'other' into the first one
+    Shard& shard = _shards[0];
+    shard._errorCount = other.errorCount();
+    shard._sharedQueueErrorCount = other.sharedQueueErrorCount();
+    shard._completedCount = other.completedCount();
+    shard._sharedQueueCompletedCount = other.sharedQueueCompletedCount();
+    shard._postedCount = other.postedCount();
+    shard._highPriorityCount = other.highPriorityCount();
 }
 
 inline
 void QueueStatistics::reset()
 {
     _numElements = 0;
-    _errorCount = 0;
-    _sharedQueueErrorCount = 0;
-    _completedCount = 0;
-    _sharedQueueCompletedCount = 0;
-    _postedCount = 0;
-    _highPriorityCount = 0;
+    for (Shard& shard : _shards)
+    {
+        shard._errorCount = 0;
+        shard._sharedQueueErrorCount = 0;
+        shard._completedCount = 0;
+        shard._sharedQueueCompletedCount = 0;
+        shard._postedCount = 0;
+        shard._highPriorityCount = 0;
+    }
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    _queueWaitTime.reset();
+    _executionTime.reset();
+    _totalTime.reset();
+    _resumeCount.reset();
+#endif
 }
 
 inline
 size_t QueueStatistics::numElements() const
 {
-    return _numElements;
+    return _numElements.load(std::memory_order_relaxed);
 }
 
 inline
 void QueueStatistics::incNumElements()
 {
-    ++_numElements;
+    _numElements.fetch_add(1, std::memory_order_relaxed);
 }
 
 inline
@@ -69,7 +86,7 @@ void QueueStatistics::decNumElements()
 {
     size_t oldValue = 1;
     size_t newValue = 0;
-    while(!_numElements.compare_exchange_weak(oldValue, newValue, std::memory_order_acq_rel))
+    while(!_numElements.compare_exchange_weak(oldValue, newValue, std::memory_order_relaxed))
     {
         if (oldValue == 0)
         {
@@ -85,97 +102,148 @@ void QueueStatistics::decNumElements()
 inline
 size_t QueueStatistics::errorCount() const
 {
-    return _errorCount;
+    return sum(&Shard::_errorCount);
 }
 
 inline
 void QueueStatistics::incErrorCount()
 {
-    ++_errorCount;
+    increment(localShard()._errorCount);
 }
 
 inline
 size_t QueueStatistics::sharedQueueErrorCount() const
 {
-    return _sharedQueueErrorCount;
+    return sum(&Shard::_sharedQueueErrorCount);
 }
 
 inline
 void QueueStatistics::incSharedQueueErrorCount()
 {
-    ++_sharedQueueErrorCount;
+    increment(localShard()._sharedQueueErrorCount);
 }
 
 inline
 size_t QueueStatistics::completedCount() const
 {
-    return _completedCount;
+    return sum(&Shard::_completedCount);
 }
 
 inline
 void QueueStatistics::incCompletedCount()
 {
-    ++_completedCount;
+    increment(localShard()._completedCount);
 }
 
 inline
 size_t QueueStatistics::sharedQueueCompletedCount() const
 {
-    return _sharedQueueCompletedCount;
+    return sum(&Shard::_sharedQueueCompletedCount);
 }
 
 inline
 void QueueStatistics::incSharedQueueCompletedCount()
 {
-    ++_sharedQueueCompletedCount;
+    increment(localShard()._sharedQueueCompletedCount);
 }
 
 inline
 size_t QueueStatistics::postedCount() const
 {
-    return _postedCount;
+    return sum(&Shard::_postedCount);
 }
 
 inline
 void QueueStatistics::incPostedCount()
 {
-    ++_postedCount;
+    increment(localShard()._postedCount);
 }
 
 inline
 size_t QueueStatistics::highPriorityCount() const
 {
-    return _highPriorityCount;
+    return sum(&Shard::_highPriorityCount);
 }
 
 inline
 void QueueStatistics::incHighPriorityCount()
 {
-    ++_highPriorityCount;
+    increment(localShard()._highPriorityCount);
+}
+
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+inline
+const Histogram& QueueStatistics::queueWaitTime() const
+{
+    return _queueWaitTime;
+}
+
+inline
+const Histogram& QueueStatistics::executionTime() const
+{
+    return _executionTime;
+}
+
+inline
+const Histogram& QueueStatistics::totalTime() const
+{
+    return _totalTime;
+}
+
+inline
+const Histogram& QueueStatistics::resumeCount() const
+{
+    return _resumeCount;
+}
+
+inline
+void QueueStatistics::recordTaskTiming(std::chrono::nanoseconds queueWaitTime,
+                                       std::chrono::nanoseconds executionTime,
+                                       std::chrono::nanoseconds totalTime,
+                                       size_t resumeCount)
+{
+    _queueWaitTime.record(queueWaitTime.count());
+    _executionTime.record(executionTime.count());
+    _totalTime.record(totalTime.count());
+    _resumeCount.record(resumeCount);
 }
+#endif
 
 inline
 void QueueStatistics::print(std::ostream& out) const
 {
-    out << "Num elemetns: " << _numElements << std::endl;
-    out << "Num queued: " << _errorCount << std::endl;
-    out << "Num completed: " << _completedCount << std::endl;
-    out << "Num shared completed: " << _sharedQueueCompletedCount << std::endl;
-    out << "Num errors: " << _errorCount << std::endl;
-    out << "Num shared errors: " << _sharedQueueErrorCount << std::endl;
-    out << "Num high priority count: " << _highPriorityCount << std::endl;
+    out << "Num elemetns: " << numElements() << std::endl;
+    out << "Num queued: " << postedCount() << std::endl;
+    out << "Num completed: " << completedCount() << std::endl;
+    out << "Num shared completed: " << sharedQueueCompletedCount() << std::endl;
+    out << "Num errors: " << errorCount() << std::endl;
+    out << "Num shared errors: " << sharedQueueErrorCount() << std::endl;
+    out << "Num high priority count: " << highPriorityCount() << std::endl;
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    out << "Queue wait time (ns): " << _queueWaitTime << std::endl;
+    out << "Execution time (ns): " << _executionTime << std::endl;
+    out << "Total time (ns): " << _totalTime << std::endl;
+    out << "Resume count: " << _resumeCount << std::endl;
+#endif
 }
 
 inline
 QueueStatistics& QueueStatistics::operator+=(const IQueueStatistics& rhs)
 {
-    _numElements += rhs.numElements();
-    _errorCount += rhs.errorCount();
-    _sharedQueueErrorCount += rhs.sharedQueueErrorCount();
-    _completedCount += rhs.completedCount();
-    _sharedQueueCompletedCount += rhs.sharedQueueCompletedCount();
-    _postedCount += rhs.postedCount();
-    _highPriorityCount += rhs.highPriorityCount();
+    _numElements.fetch_add(rhs.numElements(), std::memory_order_relaxed);
+    Shard& shard = localShard();
+    increment(shard._errorCount, rhs.errorCount());
+    increment(shard._sharedQueueErrorCount, rhs.sharedQueueErrorCount());
+    increment(shard._completedCount, rhs.completedCount());
+    increment(shard._sharedQueueCompletedCount, rhs.sharedQueueCompletedCount());
+    increment(shard._postedCount, rhs.postedCount());
+    increment(shard._highPriorityCount, rhs.highPriorityCount());
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    _queueWaitTime += rhs.queueWaitTime();
+    _executionTime += rhs.executionTime();
+    _totalTime += rhs.totalTime();
+    _resumeCount += rhs.resumeCount();
+#endif
     return *this;
 }
 
@@ -187,6 +255,38 @@ QueueStatistics operator+(QueueStatistics lhs,
     return lhs;
 }
 
+inline
+size_t QueueStatistics::shardIndex()
+{
+    //Threads are assigned shards round-robin on their first update, across all queues
+    static std::atomic_size_t nextIndex{0};
+    static thread_local size_t index = nextIndex.fetch_add(1, std::memory_order_relaxed) % numShards;
+    return index;
+}
+
+inline
+QueueStatistics::Shard& QueueStatistics::localShard()
+{
+    return _shards[shardIndex()];
+}
+
+inline
+size_t QueueStatistics::sum(std::atomic_size_t Shard::* counter) const
+{
+    size_t total = 0;
+    for (const Shard& shard : _shards)
+    {
+        total += (shard.*counter).load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+inline
+void QueueStatistics::increment(std::atomic_size_t& counter, size_t value)
+{
+    counter.fetch_add(value, std::memory_order_relaxed);
+}
+
 inline
 std::ostream& operator<<(std::ostream& out, const IQueueStatistics& stats)
 {
@@ -22,32 +22,66 @@
 namespace Bloomberg {
 namespace quantum {
 
+inline
+ReadWriteSpinLock::ReadWriteSpinLock(const char* name)
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    : _profile(&LockProfiler::get(name))
+#endif
+{
+    (void)name;
+}
+
 inline
 void ReadWriteSpinLock::lockRead()
 {
     int oldValue = 0;
     int newValue = 1;
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    size_t numSpins = 0;
+#endif
     while(!_count.compare_exchange_weak(oldValue, newValue, std::memory_order_acq_rel))
     {
         if (oldValue == -1)
         {
             oldValue = 0;
             newValue = 1;
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+            ++numSpins; //only waiting on a writer counts as contention
+#endif
         }
         else
         {
             newValue = oldValue + 1;
         }
     }
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile)
+    {
+        _profile->onAcquire(numSpins, 0);
+    }
+#endif
 }
 
 inline
 void ReadWriteSpinLock::lockWrite()
 {
     int i{0};
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    size_t numSpins = 0;
     while (!_count.compare_exchange_weak(i, -1, std::memory_order_acq_rel)) {
         i = 0;
+        ++numSpins;
+    }
+    if (_profile)
+    {
+        _profile->onAcquire(numSpins, 0);
+        _acquireTime = LockProfile::Clock::now();
     }
+#else
+    while (!_count.compare_exchange_weak(i, -1, std::memory_order_acq_rel)) {
+        i = 0;
+    }
+#endif
 }
 
 inline
@@ -66,6 +100,12 @@ bool ReadWriteSpinLock::tryLockRead()
             newValue = oldValue + 1;
         }
     }
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile)
+    {
+        _profile->onAcquire(0, 0);
+    }
+#endif
     return true;
 }
 
@@ -73,7 +113,15 @@ inline
 bool ReadWriteSpinLock::tryLockWrite()
 {
     int i{0};
-    return _count.compare_exchange_strong(i, -1, std::memory_order_acq_rel);
+    bool isLocked = _count.compare_exchange_strong(i, -1, std::memory_order_acq_rel);
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile && isLocked)
+    {
+        _profile->onAcquire(0, 0);
+        _acquireTime = LockProfile::Clock::now();
+    }
+#endif
+    return isLocked;
 }
 
 inline
@@ -85,6 +133,12 @@ void ReadWriteSpinLock::unlockRead()
 inline
 void ReadWriteSpinLock::unlockWrite()
 {
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile)
+    {
+        _profile->onRelease(_acquireTime);
+    }
+#endif
     _count.fetch_add(1, std::memory_order_acq_rel);
 }
 
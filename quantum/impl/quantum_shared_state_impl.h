@@ -125,6 +125,7 @@ void SharedState<T>::wait() const
 {
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(_mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.wait(_mutex, [this]()->bool
     {
         return stateHasChanged();
@@ -136,6 +137,7 @@ void SharedState<T>::wait(ICoroSync::Ptr sync) const
 {
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(sync, _mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.wait(sync, _mutex, [this]()->bool
     {
         return stateHasChanged();
@@ -148,11 +150,12 @@ std::future_status SharedState<T>::waitFor(const std::chrono::duration<REP, PERI
 {
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(_mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.waitFor(_mutex, time, [this]()->bool
     {
         return stateHasChanged();
     });
-    return _state == FutureState::PromiseNotSatisfied ? std::future_status::timeout : std::future_status::ready;
+    return stateHasChanged() ? std::future_status::ready : std::future_status::timeout;
 }
 
 template <class T>
@@ -162,11 +165,12 @@ std::future_status SharedState<T>::waitFor(ICoroSync::Ptr sync,
 {
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(sync, _mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.waitFor(sync, _mutex, time, [this]()->bool
     {
         return stateHasChanged();
     });
-    return _state == FutureState::PromiseNotSatisfied ? std::future_status::timeout : std::future_status::ready;
+    return stateHasChanged() ? std::future_status::ready : std::future_status::timeout;
 }
 
 template <class T>
@@ -195,6 +199,7 @@ int SharedState<T>::setException(ICoroSync::Ptr sync,
 template <class T>
 void SharedState<T>::conditionWait() const
 {
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.wait(_mutex, [this]()->bool
     {
         return stateHasChanged();
@@ -205,6 +210,7 @@ void SharedState<T>::conditionWait() const
 template <class T>
 void SharedState<T>::conditionWait(ICoroSync::Ptr sync) const
 {
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.wait(sync, _mutex, [this]()->bool
     {
         return stateHasChanged();
@@ -263,6 +269,7 @@ void SharedState<Buffer<T>>::wait() const
     }
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(_mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.wait(_mutex, [this]()->bool
     {
         BufferStatus status = _writer.empty() ?
@@ -280,6 +287,7 @@ void SharedState<Buffer<T>>::wait(ICoroSync::Ptr sync) const
     }
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(sync, _mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.wait(sync, _mutex, [this]()->bool
     {
         BufferStatus status = _writer.empty() ?
@@ -298,6 +306,7 @@ std::future_status SharedState<Buffer<T>>::waitFor(const std::chrono::duration<R
     }
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(_mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.waitFor(_mutex, time, [this]()->bool
     {
         BufferStatus status = _writer.empty() ?
@@ -318,6 +327,7 @@ std::future_status SharedState<Buffer<T>>::waitFor(ICoroSync::Ptr sync,
     }
     //========= LOCKED SCOPE =========
     Mutex::Guard lock(sync, _mutex);
+    DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
     _cond.waitFor(sync, _mutex, time, [this]()->bool
     {
         BufferStatus status = _writer.empty() ?
@@ -402,6 +412,7 @@ T SharedState<Buffer<T>>::pull(bool& isBufferClosed)
     }
     {//========= LOCKED SCOPE =========
         Mutex::Guard lock(_mutex);
+        DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
         _cond.wait(_mutex, [this]()->bool
         {
             BufferStatus status = _writer.empty() ?
@@ -437,6 +448,7 @@ T SharedState<Buffer<T>>::pull(ICoroSync::Ptr sync, bool& isBufferClosed)
     }
     {//========= LOCKED SCOPE =========
         Mutex::Guard lock(_mutex);
+        DeadlockDetector::WaitScope waitScope(DeadlockDetector::Resource::Future, this);
         _cond.wait(sync, _mutex, [this]()->bool
         {
             BufferStatus status = _writer.empty() ?
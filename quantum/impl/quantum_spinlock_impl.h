@@ -27,21 +27,58 @@ SpinLock::SpinLock() :
     _flag ATOMIC_FLAG_INIT
 {}
 
+inline
+SpinLock::SpinLock(const char* name) :
+    _flag ATOMIC_FLAG_INIT
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+   ,_profile(&LockProfiler::get(name))
+#endif
+{
+    (void)name;
+}
+
 inline
 void SpinLock::lock()
 {
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile)
+    {
+        size_t numSpins = 0;
+        while (_flag.test_and_set(std::memory_order_acquire))
+        {
+            ++numSpins;
+        }
+        _profile->onAcquire(numSpins, 0);
+        _acquireTime = LockProfile::Clock::now();
+        return;
+    }
+#endif
     while (_flag.test_and_set(std::memory_order_acquire)); //spin
 }
 
 inline
 bool SpinLock::tryLock()
 {
-    return !_flag.test_and_set(std::memory_order_acquire);
+    bool isLocked = !_flag.test_and_set(std::memory_order_acquire);
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile && isLocked)
+    {
+        _profile->onAcquire(0, 0);
+        _acquireTime = LockProfile::Clock::now();
+    }
+#endif
+    return isLocked;
 }
 
 inline
 void SpinLock::unlock()
 {
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    if (_profile)
+    {
+        _profile->onRelease(_acquireTime);
+    }
+#endif
     _flag.clear(std::memory_order_release);
 }
 
@@ -37,39 +37,93 @@ namespace quantum {
 template <class RET, class FUNC, class ... ARGS>
 Task::Task(std::false_type,
            std::shared_ptr<Context<RET>> ctx,
+           CoroutinePool* coroPool,
            int queueId,
            bool isHighPriority,
            ITask::Type type,
            FUNC&& func,
            ARGS&&... args) :
     _coroContext(ctx),
-    _coro(Allocator<CoroStackAllocator>::instance(AllocatorTraits::defaultCoroPoolAllocSize()),
-          Util::bindCaller(ctx, std::forward<FUNC>(func), std::forward<ARGS>(args)...)),
     _queueId(queueId),
     _isHighPriority(isHighPriority),
     _type(type),
     _terminated(false),
     _suspendedState((int)State::Suspended),
     _coroLocalStorage()
-{}
+{
+    if (coroPool)
+    {
+        //the coroutine is acquired on the first run so that the pool is only touched by the coroutine threads
+        _coroPool = coroPool;
+        _pooledWork.emplace(Util::bindCaller(ctx, std::forward<FUNC>(func), std::forward<ARGS>(args)...));
+    }
+    else
+    {
+        _coro.emplace(Allocator<CoroStackAllocator>::instance(AllocatorTraits::defaultCoroPoolAllocSize()),
+                      Util::bindCaller(ctx, std::forward<FUNC>(func), std::forward<ARGS>(args)...));
+    }
+}
 
 template <class RET, class FUNC, class ... ARGS>
 Task::Task(std::true_type,
            std::shared_ptr<Context<RET>> ctx,
+           CoroutinePool* coroPool,
            int queueId,
            bool isHighPriority,
            ITask::Type type,
            FUNC&& func,
            ARGS&&... args) :
     _coroContext(ctx),
-    _coro(Allocator<CoroStackAllocator>::instance(AllocatorTraits::defaultCoroPoolAllocSize()),
-          Util::bindCaller2(ctx, std::forward<FUNC>(func), std::forward<ARGS>(args)...)),
     _queueId(queueId),
     _isHighPriority(isHighPriority),
     _type(type),
     _terminated(false),
     _suspendedState((int)State::Suspended),
     _coroLocalStorage()
+{
+    if (coroPool)
+    {
+        //the coroutine is acquired on the first run so that the pool is only touched by the coroutine threads
+        _coroPool = coroPool;
+        _pooledWork.emplace(Util::bindCaller2(ctx, std::forward<FUNC>(func), std::forward<ARGS>(args)...));
+    }
+    else
+    {
+        _coro.emplace(Allocator<CoroStackAllocator>::instance(AllocatorTraits::defaultCoroPoolAllocSize()),
+                      Util::bindCaller2(ctx, std::forward<FUNC>(func), std::forward<ARGS>(args)...));
+    }
+}
+
+template <class RET, class FUNC, class ... ARGS>
+Task::Task(std::true_type,
+           std::shared_ptr<Promise<RET>> promise,
+           int queueId,
+           bool isHighPriority,
+           FUNC&& func,
+           ARGS&&... args) :
+    _func(new Function<int()>(Util::bindIoCaller(promise, std::forward<FUNC>(func), std::forward<ARGS>(args)...))),
+    _queueId(queueId),
+    _isHighPriority(isHighPriority),
+    _type(ITask::Type::Standalone),
+    _terminated(false),
+    _suspendedState((int)State::Suspended),
+    _coroLocalStorage()
+{}
+
+template <class RET, class FUNC, class ... ARGS>
+Task::Task(std::false_type,
+           std::shared_ptr<Promise<RET>> promise,
+           int queueId,
+           bool isHighPriority,
+           FUNC&& func,
+           ARGS&&... args) :
+    _func(new Function<int()>(Util::bindIoCaller2(promise, std::forward<FUNC>(func), std::forward<ARGS>(args)...))),
+    _queueId(queueId),
+    _isHighPriority(isHighPriority),
+    _type(ITask::Type::Standalone),
+    _terminated(false),
+    _suspendedState((int)State::Suspended),
+    _coroLocalStorage()
 {}
 
 inline
@@ -94,7 +148,7 @@ int Task::run()
     SuspensionGuard guard(_suspendedState);
     if (guard)
     {
-        if (!_coro)
+        if (!isCallable())
         {
             return (int)ITask::RetCode::NotCallable;
         }
@@ -108,8 +162,62 @@ int Task::run()
         }
         
         int rc = (int)ITask::RetCode::Running;
-        _coro(rc);
-        if (!_coro)
+        const bool isTraced = Tracer::isEnabled();
+        if (isTraced)
+        {
+            Tracer::record((getState() == TaskSnapshot::State::NotStarted) ? Tracer::EventType::Start :
+                           Tracer::EventType::Resume, getTraceId(), _queueId);
+        }
+        _runState.store((int)TaskSnapshot::State::Running, std::memory_order_relaxed);
+        {
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+            TaskTiming::RunGuard timer(_timing);
+#endif
+            if (_coro)
+            {
+                (*_coro)(rc);
+            }
+            else if (_pooledCoro || _pooledWork)
+            {
+                if (_pooledWork)
+                {
+                    _pooledCoro = _coroPool->acquire(_queueId, std::move(*_pooledWork));
+                    _pooledWork = boost::none;
+                }
+                _pooledCoro->resume(rc);
+                if (_pooledCoro->isIdle())
+                {
+                    //the coroutine picks up another task instead of being destroyed
+                    CoroutinePool& pool = _pooledCoro->getPool();
+                    pool.release(std::move(_pooledCoro));
+                }
+            }
+            else
+            {
+                rc = (*_func)();
+                if ((rc != (int)ITask::RetCode::Running) &&
+                    (rc != (int)ITask::RetCode::Blocked) &&
+                    (rc != (int)ITask::RetCode::Sleeping))
+                {
+                    _func.reset(); //run-to-completion tasks never resume unless they ask to be polled again
+                }
+            }
+        }
+        const bool isPolled = static_cast<bool>(_func);
+        TaskSnapshot::State state = (!isCallable() || (!isPolled && (rc != (int)ITask::RetCode::Running))) ? TaskSnapshot::State::Completed :
+                                    (isBlocked() || (rc == (int)ITask::RetCode::Blocked)) ? TaskSnapshot::State::Blocked :
+                                    (isSleeping() || (rc == (int)ITask::RetCode::Sleeping)) ? TaskSnapshot::State::Sleeping :
+                                    TaskSnapshot::State::Runnable;
+        _runState.store((int)state, std::memory_order_relaxed);
+        if (isTraced)
+        {
+            Tracer::EventType type = (state == TaskSnapshot::State::Completed) ? Tracer::EventType::Complete :
+                                     (state == TaskSnapshot::State::Blocked) ? Tracer::EventType::YieldBlocked :
+                                     (state == TaskSnapshot::State::Sleeping) ? Tracer::EventType::YieldSleeping :
+                                     Tracer::EventType::YieldRunning;
+            Tracer::record(type, getTraceId(), _queueId);
+        }
+        if (!isCallable())
         {
             guard.set((int)State::Terminated);
         }
@@ -189,6 +297,14 @@ bool Task::isHighPriority() const
     return _isHighPriority;
 }
 
+inline
+bool Task::isCallable() const
+{
+    return _coro ? static_cast<bool>(*_coro) :
+           (_pooledCoro || _pooledWork) ? true : //released as soon as the task body returns
+           static_cast<bool>(_func);
+}
+
 inline
 bool Task::isSuspended() const
 {
@@ -207,6 +323,44 @@ ITaskAccessor::Ptr Task::getTaskAccessor() const
     return _coroContext;
 }
 
+inline
+uint64_t Task::getTraceId()
+{
+    return Tracer::taskId(_traceId);
+}
+
+inline
+TaskSnapshot::State Task::getState() const
+{
+    return (TaskSnapshot::State)_runState.load(std::memory_order_relaxed);
+}
+
+inline
+std::chrono::steady_clock::time_point Task::getCreationTime() const
+{
+    return _creationTime;
+}
+
+inline
+void Task::setTag(const char* tag)
+{
+    _tag.store(tag, std::memory_order_relaxed);
+}
+
+inline
+const char* Task::getTag() const
+{
+    return _tag.load(std::memory_order_relaxed);
+}
+
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+inline
+TaskTiming& Task::getTiming()
+{
+    return _timing;
+}
+#endif
+
 inline
 void* Task::operator new(size_t)
 {
@@ -46,14 +46,29 @@ TaskQueue::ProcessTaskResult::ProcessTaskResult(bool isBlocked,
 
 inline
 TaskQueue::CurrentTaskSetter::CurrentTaskSetter(TaskQueue& taskQueue, const TaskPtr & task) :
-    _taskQueue(taskQueue)
+    _taskQueue(taskQueue),
+    _slice(currentSlice())
 {
     _taskQueue.setCurrentTask(task.get());
+    if (DeadlockDetector::isEnabled())
+    {
+        DeadlockDetector::setCurrentTask(task->getTraceId(), task->getQueueId());
+    }
+    if (_slice)
+    {
+        _slice->_taskId.store(task->getTraceId(), std::memory_order_relaxed);
+        _slice->_start.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+    }
 }
 
 inline
 TaskQueue::CurrentTaskSetter::~CurrentTaskSetter()
 {
+    if (_slice)
+    {
+        _slice->_start.store(0, std::memory_order_release);
+    }
+    DeadlockDetector::setCurrentTask(0, 0);
     _taskQueue.setCurrentTask(nullptr);
 }
     
@@ -64,7 +79,7 @@ TaskQueue::TaskQueue() :
 }
 
 inline
-TaskQueue::TaskQueue(const Configuration&, std::shared_ptr<TaskQueue> sharedQueue) :
+TaskQueue::TaskQueue(const Configuration& config, std::shared_ptr<TaskQueue> sharedQueue) :
     _alloc(Allocator<QueueListAllocator>::instance(AllocatorTraits::queueListAllocSize())),
     _runQueue(_alloc),
     _waitQueue(_alloc),
@@ -77,6 +92,7 @@ TaskQueue::TaskQueue(const Configuration&, std::shared_ptr<TaskQueue> sharedQueu
     _isIdle(true),
     _terminated(false),
     _isAdvanced(false),
+    _isWatched((config.getWatchdogThreshold().count() > 0) && config.getWatchdogCallback()),
     _sharedQueue(sharedQueue),
     _queueRound(0),
     _lastSleptQueueRound(std::numeric_limits<unsigned int>::max()),
@@ -123,6 +139,8 @@ void TaskQueue::pinToCore(int coreId)
 inline
 void TaskQueue::run()
 {
+    //Coroutines from the shared queue also run on this thread so the slice is tracked per thread
+    currentSlice() = _isWatched ? &_slice : nullptr;
     while (!isInterrupted())
     {
         const ProcessTaskResult result = processTask();
@@ -265,6 +283,13 @@ void TaskQueue::doEnqueue(ITask::Ptr task)
     //NOTE: _queueIt remains unchanged following this operation
     _stats.incPostedCount();
     _stats.incNumElements();
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    std::static_pointer_cast<Task>(task)->getTiming().onPost();
+#endif
+    if (Tracer::isEnabled())
+    {
+        Tracer::record(Tracer::EventType::Post, std::static_pointer_cast<Task>(task)->getTraceId(), task->getQueueId());
+    }
     bool isEmpty = _waitQueue.empty();
     if (task->isHighPriority())
     {
@@ -476,6 +501,9 @@ bool TaskQueue::handleSuccess(const WorkItem& workItem)
     doDequeue(_isIdle, workItem._iter);
     //Coroutine ended normally with "return 0" statement
     _stats.incCompletedCount();
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    workItem._task->getTiming().record(_stats);
+#endif
     return true;
 }
 
@@ -490,6 +518,9 @@ bool TaskQueue::handleError(const WorkItem& workItem)
     doDequeue(_isIdle, workItem._iter);
     //Coroutine ended with explicit user error
     _stats.incErrorCount();
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    workItem._task->getTiming().record(_stats);
+#endif
 #ifdef __QUANTUM_PRINT_DEBUG
     std::lock_guard<std::mutex> guard(Util::LogMutex());
     if (rc == (int)ITask::RetCode::Exception)
@@ -645,5 +676,59 @@ inline void TaskQueue::setCurrentTask(Task* task)
     getCurrentTaskImpl() = task;
 }
 
+inline
+bool TaskQueue::getCurrentSlice(uint64_t& taskId, std::chrono::steady_clock::time_point& start) const
+{
+    int64_t ticks = _slice._start.load(std::memory_order_acquire);
+    if (ticks == 0)
+    {
+        return false;
+    }
+    taskId = _slice._taskId.load(std::memory_order_relaxed);
+    if (_slice._start.load(std::memory_order_acquire) != ticks)
+    {
+        return false; //a new slice started while reading
+    }
+    start = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(ticks));
+    return true;
+}
+
+inline
+void TaskQueue::snapshot(DispatcherSnapshot& snapshot, int queueId) const
+{
+    auto add = [&snapshot, queueId](const TaskPtr& task)
+    {
+        snapshot.add({task->getTraceId(),
+                      queueId,
+                      IQueue::QueueType::Coro,
+                      task->getType(),
+                      task->getState(),
+                      task->isHighPriority(),
+                      snapshot.getTime() - task->getCreationTime(),
+                      task->getTag()});
+    };
+    {//========================= LOCKED SCOPE =========================
+        SpinLock::Guard lock(_runQueueLock);
+        for (const TaskPtr& task : _runQueue)
+        {
+            add(task);
+        }
+    }
+    {//========================= LOCKED SCOPE =========================
+        SpinLock::Guard lock(_waitQueueLock);
+        for (const TaskPtr& task : _waitQueue)
+        {
+            add(task);
+        }
+    }
+}
+
+inline
+TaskQueue::Slice*& TaskQueue::currentSlice()
+{
+    static thread_local Slice* slice = nullptr;
+    return slice;
+}
+
 }}
 
@@ -0,0 +1,61 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+TaskTiming::RunGuard::RunGuard(TaskTiming& timing) :
+    _timing(timing),
+    _start(Clock::now())
+{
+    if (_timing._numRuns++ == 0)
+    {
+        _timing._firstRunTime = _start;
+    }
+}
+
+inline
+TaskTiming::RunGuard::~RunGuard()
+{
+    _timing._executionTime += Clock::now() - _start;
+}
+
+inline
+void TaskTiming::onPost()
+{
+    _postTime = Clock::now();
+}
+
+inline
+void TaskTiming::record(IQueueStatistics& stats) const
+{
+    if (_numRuns == 0)
+    {
+        return; //task never ran
+    }
+    stats.recordTaskTiming(std::chrono::duration_cast<std::chrono::nanoseconds>(_firstRunTime - _postTime),
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(_executionTime),
+                           std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _postTime),
+                           _numRuns - 1);
+}
+
+}}
@@ -0,0 +1,241 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <set>
+#include <stdexcept>
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+Tracer::Buffer::Buffer(size_t capacity, uint32_t threadId, uint64_t generation) :
+    _events(capacity),
+    _head(0),
+    _threadId(threadId),
+    _generation(generation)
+{
+}
+
+inline
+void Tracer::enable(size_t capacityPerThread)
+{
+    if (capacityPerThread == 0)
+    {
+        throw std::invalid_argument("Invalid trace buffer capacity");
+    }
+    State& s = state();
+    {//========= LOCKED SCOPE =========
+        std::lock_guard<std::mutex> lock(s._mutex);
+        s._capacity = capacityPerThread;
+        s._buffers.clear();
+        s._numThreads = 0;
+        ++s._generation; //threads allocate new buffers on their next event
+    }
+    s._isEnabled.store(true, std::memory_order_release);
+}
+
+inline
+void Tracer::disable()
+{
+    state()._isEnabled.store(false, std::memory_order_release);
+}
+
+inline
+bool Tracer::isEnabled()
+{
+    return state()._isEnabled.load(std::memory_order_relaxed);
+}
+
+inline
+void Tracer::clear()
+{
+    State& s = state();
+    std::lock_guard<std::mutex> lock(s._mutex);
+    s._buffers.clear();
+    s._numThreads = 0;
+    ++s._generation;
+}
+
+inline
+std::vector<Tracer::Event> Tracer::getEvents()
+{
+    std::vector<Event> events;
+    State& s = state();
+    {//========= LOCKED SCOPE =========
+        std::lock_guard<std::mutex> lock(s._mutex);
+        for (const BufferPtr& buffer : s._buffers)
+        {
+            uint64_t head = buffer->_head.load(std::memory_order_acquire);
+            uint64_t num = std::min(head, (uint64_t)buffer->_events.size());
+            for (uint64_t i = head - num; i < head; ++i)
+            {
+                events.push_back(buffer->_events[i % buffer->_events.size()]);
+            }
+        }
+    }
+    std::stable_sort(events.begin(), events.end(), [](const Event& lhs, const Event& rhs)->bool
+    {
+        return lhs._timestamp < rhs._timestamp;
+    });
+    return events;
+}
+
+inline
+void Tracer::dump(std::ostream& out)
+{
+    std::vector<Event> events = getEvents();
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    const char* separator = "";
+    std::set<uint32_t> threadIds;
+    for (const Event& event : events)
+    {
+        if (threadIds.insert(event._threadId).second)
+        {
+            out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << event._threadId
+                << ",\"args\":{\"name\":\"quantum thread " << event._threadId << "\"}}";
+            separator = ",";
+        }
+    }
+    uint64_t base = events.empty() ? 0 : events.front()._timestamp;
+    for (const Event& event : events)
+    {
+        bool isIo = (event._type == EventType::IoPost) ||
+                    (event._type == EventType::IoStart) ||
+                    (event._type == EventType::IoComplete);
+        out << separator << "{\"pid\":1,\"tid\":" << event._threadId
+            << ",\"ts\":" << (event._timestamp - base) / 1000.0
+            << ",\"cat\":\"" << (isIo ? "io" : "coro") << "\"";
+        separator = ",";
+        switch (event._type)
+        {
+            case EventType::Post:
+            case EventType::IoPost:
+                //instant event followed by the start of a flow arrow pointing to the first run
+                out << ",\"name\":\"post\",\"ph\":\"i\",\"s\":\"t\"";
+                out << ",\"args\":{\"task\":" << event._taskId << ",\"queue\":" << event._queueId << "}}";
+                out << ",{\"pid\":1,\"tid\":" << event._threadId
+                    << ",\"ts\":" << (event._timestamp - base) / 1000.0
+                    << ",\"cat\":\"" << (isIo ? "io" : "coro") << "\""
+                    << ",\"name\":\"dispatch\",\"ph\":\"s\",\"id\":" << event._taskId << "}";
+                break;
+            case EventType::Start:
+            case EventType::IoStart:
+                //end of the flow arrow followed by the beginning of the first run
+                out << ",\"name\":\"dispatch\",\"ph\":\"f\",\"bp\":\"e\",\"id\":" << event._taskId << "}";
+                out << ",{\"pid\":1,\"tid\":" << event._threadId
+                    << ",\"ts\":" << (event._timestamp - base) / 1000.0
+                    << ",\"cat\":\"" << (isIo ? "io" : "coro") << "\"";
+                out << ",\"name\":\"" << (isIo ? "io " : "coro ") << event._taskId << "\",\"ph\":\"B\""
+                    << ",\"args\":{\"task\":" << event._taskId << ",\"queue\":" << event._queueId << "}}";
+                break;
+            case EventType::Resume:
+                out << ",\"name\":\"coro " << event._taskId << "\",\"ph\":\"B\""
+                    << ",\"args\":{\"task\":" << event._taskId << ",\"queue\":" << event._queueId << "}}";
+                break;
+            default:
+                out << ",\"ph\":\"E\",\"args\":{\"reason\":\"" << nameOf(event._type) << "\"}}";
+                break;
+        }
+    }
+    out << "]}";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+inline
+void Tracer::record(EventType type, uint64_t taskId, int queueId)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    Buffer& buffer = threadBuffer();
+    //single writer per buffer
+    uint64_t head = buffer._head.load(std::memory_order_relaxed);
+    Event& event = buffer._events[head % buffer._events.size()];
+    event._timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count();
+    event._taskId = taskId;
+    event._queueId = queueId;
+    event._threadId = buffer._threadId;
+    event._type = type;
+    buffer._head.store(head + 1, std::memory_order_release);
+}
+
+inline
+uint64_t Tracer::taskId(std::atomic<uint64_t>& taskId)
+{
+    uint64_t id = taskId.load(std::memory_order_relaxed);
+    if (id == 0)
+    {
+        uint64_t newId = state()._nextTaskId.fetch_add(1, std::memory_order_relaxed);
+        //another thread may be assigning an id concurrently, in which case its id is kept
+        id = taskId.compare_exchange_strong(id, newId, std::memory_order_relaxed) ? newId : id;
+    }
+    return id;
+}
+
+inline
+Tracer::State& Tracer::state()
+{
+    static State s;
+    return s;
+}
+
+inline
+Tracer::Buffer& Tracer::threadBuffer()
+{
+    static thread_local BufferPtr buffer;
+    State& s = state();
+    if (!buffer || (buffer->_generation != s._generation.load(std::memory_order_acquire)))
+    {
+        std::lock_guard<std::mutex> lock(s._mutex);
+        buffer = std::make_shared<Buffer>(s._capacity, s._numThreads++, s._generation.load());
+        s._buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+inline
+const char* Tracer::nameOf(EventType type)
+{
+    switch (type)
+    {
+        case EventType::Post: return "Post";
+        case EventType::Start: return "Start";
+        case EventType::Resume: return "Resume";
+        case EventType::YieldRunning: return "Running";
+        case EventType::YieldBlocked: return "Blocked";
+        case EventType::YieldSleeping: return "Sleeping";
+        case EventType::Complete: return "Complete";
+        case EventType::IoPost: return "IoPost";
+        case EventType::IoStart: return "IoStart";
+        case EventType::IoComplete: return "IoComplete";
+    }
+    return "Unknown";
+}
+
+}}
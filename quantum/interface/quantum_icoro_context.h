@@ -19,6 +19,7 @@
 #include <quantum/quantum_functions.h>
 #include <quantum/interface/quantum_icoro_context_base.h>
 #include <quantum/interface/quantum_icoro_future.h>
+#include <quantum/util/quantum_map_reduce_output.h>
 #include <map>
 #include <vector>
 
@@ -428,6 +429,124 @@ struct ICoroContext : ICoroContextBase
     auto forEachBatch(INPUT_IT first, size_t num, FUNC&& func)
         ->typename ICoroContext<std::vector<std::vector<decltype(coroResult(func))>>>::Ptr;
     
+    /// @brief Applies the given function to consecutive chunks of the range [first,last).
+    /// @return A vector of values (i.e. one per chunk in range order), or an int set to 0 if the function
+    ///         returns void.
+    /// @note See Dispatcher::forEachChunk() for more details.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto forEachChunk(INPUT_IT first, INPUT_IT last, size_t chunkSize, FUNC&& func)
+        ->typename ICoroContext<typename Traits::ChunkResults<decltype(coroResult(func))>::Type>::Ptr;
+    
+    /// @brief Same as forEachChunk() but each chunk writes its output in place into the range starting at 'outFirst'.
+    /// @return An int set to 0 once all chunks are processed.
+    /// @note See Dispatcher::forEachChunk() for more details.
+    template <class INPUT_IT,
+              class OUTPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    std::shared_ptr<ICoroContext<int>>
+    forEachChunk(INPUT_IT first, INPUT_IT last, size_t chunkSize, OUTPUT_IT outFirst, FUNC&& func);
+    
+    /// @brief Applies the given unary function to all the elements in the range [first,last) on the IO threads.
+    /// @return A vector of values (i.e. one per element in range order), or an int set to 0 if the function
+    ///         returns void.
+    /// @note See Dispatcher::forEachAsyncIo() for more details.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto forEachAsyncIo(INPUT_IT first, INPUT_IT last, FUNC&& func, size_t chunkSize = 0)
+        ->typename ICoroContext<typename Traits::ChunkResults<decltype(resultOf2(func))>::Type>::Ptr;
+    
+    /// @brief Applies the given unary function to all the elements in the range [first,last) using
+    ///        adaptive work-stealing partitioning.
+    /// @details One worker coroutine is started on each coroutine thread covered by IQueue::QueueId::Any. A worker which
+    ///          runs out of elements steals the second half of the largest remaining share of another worker.
+    /// @param[in] grainSize The maximum number of consecutive elements a worker processes before checking for
+    ///                      more work. Set to 0 to let the library choose.
+    /// @return A vector of future values corresponding to the output of 'func' on every element in the range.
+    /// @note INPUT_IT must meet the requirements of a RandomAccessIterator. RET must be default-constructible and
+    ///       cannot be 'bool'. See Dispatcher::parallelFor() for more details.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto parallelFor(INPUT_IT first, INPUT_IT last, FUNC&& func, size_t grainSize = 0)
+        ->typename ICoroContext<std::vector<decltype(coroResult(func))>>::Ptr;
+    
+    /// @brief Applies the given function to every tile of a 2-D range of rows x cols. Neighbouring tiles are
+    ///        processed by the same worker whenever possible.
+    /// @return A future which completes once all tiles are processed.
+    /// @note See Dispatcher::parallelFor2D() for more details.
+    template <class FUNC>
+    std::shared_ptr<ICoroContext<int>>
+    parallelFor2D(size_t rows, size_t cols, size_t tileRows, size_t tileCols, FUNC&& func);
+    
+    /// @brief Reduces the range [first,last) in parallel, similarly to std::reduce().
+    /// @return A future to the reduced value.
+    /// @note See Dispatcher::reduce() for more details.
+    template <class INPUT_IT,
+              class T,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    typename ICoroContext<T>::Ptr
+    reduce(INPUT_IT first, INPUT_IT last, T init, FUNC&& func, size_t grainSize = 0);
+    
+    /// @brief Applies a unary transform to every element in the range [first,last) and reduces the results in
+    ///        parallel, similarly to std::transform_reduce().
+    /// @return A future to the reduced value.
+    /// @note See Dispatcher::transformReduce() for more details.
+    template <class INPUT_IT,
+              class T,
+              class REDUCE_FUNC,
+              class TRANSFORM_FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    typename ICoroContext<T>::Ptr
+    transformReduce(INPUT_IT first,
+                    INPUT_IT last,
+                    T init,
+                    REDUCE_FUNC&& reduceFunc,
+                    TRANSFORM_FUNC&& transformFunc,
+                    size_t grainSize = 0);
+    
+    /// @brief Computes the inclusive prefix sums of the range [first,last) in parallel, similarly to
+    ///        std::inclusive_scan().
+    /// @return A future to a vector where the i-th element is the reduction of elements [0,i].
+    /// @note See Dispatcher::inclusiveScan() for more details.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    typename ICoroContext<std::vector<typename std::iterator_traits<INPUT_IT>::value_type>>::Ptr
+    inclusiveScan(INPUT_IT first, INPUT_IT last, FUNC&& func);
+    
+    /// @brief Computes the exclusive prefix sums of the range [first,last) in parallel, similarly to
+    ///        std::exclusive_scan().
+    /// @return A future to a vector where the i-th element is the reduction of 'init' and elements [0,i).
+    /// @note See Dispatcher::exclusiveScan() for more details.
+    template <class INPUT_IT,
+              class T,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    typename ICoroContext<std::vector<T>>::Ptr
+    exclusiveScan(INPUT_IT first, INPUT_IT last, T init, FUNC&& func);
+    
+    /// @brief Sorts the range [first,last) in parallel.
+    /// @return A future which is set to 0 once the range is sorted.
+    /// @note See Dispatcher::sort() for more details.
+    template <class RANDOM_IT,
+              class COMPARE = std::less<typename std::iterator_traits<RANDOM_IT>::value_type>,
+              class = Traits::IsInputIterator<RANDOM_IT>>
+    std::shared_ptr<ICoroContext<int>>
+    sort(RANDOM_IT first, RANDOM_IT last, COMPARE compare = COMPARE());
+    
+    /// @brief Same as sort() but the relative order of equivalent elements is preserved.
+    /// @note See Dispatcher::stableSort() for more details.
+    template <class RANDOM_IT,
+              class COMPARE = std::less<typename std::iterator_traits<RANDOM_IT>::value_type>,
+              class = Traits::IsInputIterator<RANDOM_IT>>
+    std::shared_ptr<ICoroContext<int>>
+    stableSort(RANDOM_IT first, RANDOM_IT last, COMPARE compare = COMPARE());
+    
     /// @brief Implementation of map-reduce functionality.
     /// @tparam KEY The KEY type used for mapping and reducing.
     /// @tparam MAPPED_TYPE The output type after a map operation.
@@ -504,6 +623,81 @@ struct ICoroContext : ICoroContextBase
                         MAPPER_FUNC mapper,
                         REDUCER_FUNC reducer)->
           typename ICoroContext<std::map<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>::Ptr;
+    
+    /// @brief Same as mapReduce() but with an optional combiner and a choice of output container.
+    /// @tparam COMBINER_FUNC The combiner function having the signature
+    ///         'MAPPED_TYPE(const KEY&, MAPPED_TYPE&&, MAPPED_TYPE&&)' or std::nullptr_t.
+    /// @tparam OUTPUT One of MapReduceOutput::Ordered, MapReduceOutput::Unordered or MapReduceOutput::Sorted.
+    /// @param[in] first The start iterator to a list of items to be processed in the range [first,last).
+    /// @param[in] last The end iterator to a list of items (not inclusive).
+    /// @param[in] mapper The mapper function.
+    /// @param[in] reducer The reducer function.
+    /// @param[in] combiner Merges two mapped values of the same key before they are shuffled between
+    ///            coroutine threads. This reduces the shuffle volume when many values share the same key.
+    ///            Pass nullptr if no combining is needed.
+    /// @param[in] output Tag selecting the returned container.
+    /// @return A future to the reduced values.
+    /// @note The mapped values are hash-partitioned between all coroutine threads which index and reduce
+    ///       them in parallel. Keys which are not hashable are processed in a single partition.
+    template <class MAPPER_FUNC,
+              class REDUCER_FUNC,
+              class COMBINER_FUNC,
+              class OUTPUT,
+              class INPUT_IT,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto mapReduce(INPUT_IT first,
+                   INPUT_IT last,
+                   MAPPER_FUNC mapper,
+                   REDUCER_FUNC reducer,
+                   COMBINER_FUNC combiner,
+                   OUTPUT output)->
+          typename ICoroContext<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>::Ptr;
+    
+    /// @brief Same as mapReduceBatch() but with an optional combiner and a choice of output container.
+    /// @note See mapReduce() above for details.
+    template <class MAPPER_FUNC,
+              class REDUCER_FUNC,
+              class COMBINER_FUNC,
+              class OUTPUT,
+              class INPUT_IT,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto mapReduceBatch(INPUT_IT first,
+                        INPUT_IT last,
+                        MAPPER_FUNC mapper,
+                        REDUCER_FUNC reducer,
+                        COMBINER_FUNC combiner,
+                        OUTPUT output)->
+          typename ICoroContext<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>::Ptr;
+    
+    /// @brief Same as mapReduce() but both the mapper and the reducer run on the IO threads.
+    /// @note See Dispatcher::mapReduceAsyncIo() for more details.
+    template <class MAPPER_FUNC,
+              class REDUCER_FUNC,
+              class COMBINER_FUNC = std::nullptr_t,
+              class OUTPUT = MapReduceOutput::Ordered,
+              class INPUT_IT,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto mapReduceAsyncIo(INPUT_IT first,
+                          INPUT_IT last,
+                          MAPPER_FUNC mapper,
+                          REDUCER_FUNC reducer,
+                          COMBINER_FUNC combiner = nullptr,
+                          OUTPUT output = OUTPUT(),
+                          size_t chunkSize = 0)->
+          typename ICoroContext<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>::Ptr;
+    
+    /// @brief Streaming version of mapReduce() which consumes records from a buffered future as they arrive.
+    /// @note See Dispatcher::mapReduceStream() for more details.
+    template <class MAPPER_FUNC,
+              class COMBINER_FUNC,
+              class OUTPUT = MapReduceOutput::Ordered,
+              class SOURCE>
+    auto mapReduceStream(SOURCE source,
+                         MAPPER_FUNC mapper,
+                         COMBINER_FUNC combiner,
+                         OUTPUT output = OUTPUT(),
+                         size_t batchSize = 0)->
+          typename ICoroContext<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(mappedTypeOf(mapper))>>::Ptr;
 };
 
 template <class RET>
@@ -17,6 +17,10 @@
 #define BLOOMBERG_QUANTUM_IQUEUE_STATISTICS_H
 
 #include <ostream>
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+#include <chrono>
+#include <quantum/quantum_histogram.h>
+#endif
 
 namespace Bloomberg {
 namespace quantum {
@@ -85,6 +89,30 @@ struct IQueueStatistics
     /// @brief Increment this counter.
     virtual void incHighPriorityCount() = 0;
     
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    /// @brief Time spent by completed tasks between being posted and first running, in nanoseconds.
+    /// @return Histogram of the values.
+    virtual const Histogram& queueWaitTime() const = 0;
+    
+    /// @brief Time spent by completed tasks actually running, summed over all their resumes, in nanoseconds.
+    /// @return Histogram of the values.
+    virtual const Histogram& executionTime() const = 0;
+    
+    /// @brief Time between the post and the completion of tasks, in nanoseconds.
+    /// @return Histogram of the values.
+    virtual const Histogram& totalTime() const = 0;
+    
+    /// @brief Number of times completed coroutines were resumed after yielding or blocking. Always 0 for IO tasks.
+    /// @return Histogram of the values.
+    virtual const Histogram& resumeCount() const = 0;
+    
+    /// @brief Record the timing of a completed task.
+    virtual void recordTaskTiming(std::chrono::nanoseconds queueWaitTime,
+                                  std::chrono::nanoseconds executionTime,
+                                  std::chrono::nanoseconds totalTime,
+                                  size_t resumeCount) = 0;
+#endif
+    
     /// @brief Print to std::cout the value of all internal counters.
     /// @param[in,out] out Output stream.
     virtual void print(std::ostream& out) const = 0;
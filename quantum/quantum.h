@@ -43,19 +43,30 @@
 #include <quantum/quantum_allocator_traits.h>
 #include <quantum/quantum_buffer.h>
 #include <quantum/quantum_capture.h>
+#include <quantum/quantum_co_awaitables.h>
+#include <quantum/quantum_co_generator.h>
+#include <quantum/quantum_co_task.h>
 #include <quantum/quantum_condition_variable.h>
 #include <quantum/quantum_configuration.h>
 #include <quantum/quantum_context.h>
 #include <quantum/quantum_contiguous_pool_manager.h>
+#include <quantum/quantum_coro_local_storage.h>
+#include <quantum/quantum_coroutine_pool.h>
 #include <quantum/quantum_coroutine_pool_allocator.h>
+#include <quantum/quantum_deadlock_detector.h>
 #include <quantum/quantum_dispatcher.h>
 #include <quantum/quantum_dispatcher_core.h>
+#include <quantum/quantum_dispatcher_snapshot.h>
 #include <quantum/quantum_functions.h>
 #include <quantum/quantum_future.h>
 #include <quantum/quantum_future_state.h>
+#include <quantum/quantum_generator.h>
+#include <quantum/quantum_heap_allocator.h>
+#include <quantum/quantum_histogram.h>
 #include <quantum/quantum_io_queue.h>
 #include <quantum/quantum_io_task.h>
 #include <quantum/quantum_local.h>
+#include <quantum/quantum_lock_profiler.h>
 #include <quantum/quantum_macros.h>
 #include <quantum/quantum_mutex.h>
 #include <quantum/quantum_promise.h>
@@ -67,16 +78,26 @@
 #include <quantum/quantum_stack_traits.h>
 #include <quantum/quantum_task.h>
 #include <quantum/quantum_task_queue.h>
+#include <quantum/quantum_task_timing.h>
 #include <quantum/quantum_thread_traits.h>
+#include <quantum/quantum_tracer.h>
 #include <quantum/quantum_traits.h>
 #include <quantum/quantum_yielding_thread.h>
 #include <quantum/util/quantum_drain_guard.h>
 #include <quantum/util/quantum_future_joiner.h>
 #include <quantum/util/quantum_generic_future.h>
 #include <quantum/util/quantum_local_variable_guard.h>
+#include <quantum/util/quantum_map_reduce_output.h>
+#include <quantum/util/quantum_pipeline.h>
+#include <quantum/util/quantum_pipeline_configuration.h>
+#include <quantum/util/quantum_pipeline_queue.h>
+#include <quantum/util/quantum_pipeline_statistics.h>
 #include <quantum/util/quantum_sequence_key_statistics.h>
 #include <quantum/util/quantum_sequencer.h>
 #include <quantum/util/quantum_sequencer_configuration.h>
+#include <quantum/util/quantum_stealing_range.h>
+#include <quantum/util/quantum_task_graph.h>
+#include <quantum/util/quantum_tile_grid.h>
 #include <quantum/util/quantum_util.h>
 
 #endif //BLOOMBERG_QUANTUM_H
@@ -67,6 +67,10 @@ namespace quantum {
     #define __QUANTUM_IO_QUEUE_LIST_ALLOC_SIZE __QUANTUM_DEFAULT_POOL_ALLOC_SIZE
 #endif
 
+#ifndef __QUANTUM_CORO_FRAME_ALLOC_SIZE
+    #define __QUANTUM_CORO_FRAME_ALLOC_SIZE __QUANTUM_DEFAULT_POOL_ALLOC_SIZE
+#endif
+
 //==============================================================================================
 //                                 struct AllocatorTraits
 //==============================================================================================
@@ -162,6 +166,16 @@ struct AllocatorTraits {
         static size_type size = __QUANTUM_IO_QUEUE_LIST_ALLOC_SIZE;
         return size;
     }
+    
+    /**
+     * @brief Get/set if the default size for each of the C++20 coroutine frame pools (see co::Task).
+     * @return A modifiable reference to the value.
+     * @remark Normally this should not be modified unless very specific tuning is needed.
+     */
+    static size_type& coroFrameAllocSize() {
+        static size_type size = __QUANTUM_CORO_FRAME_ALLOC_SIZE;
+        return size;
+    }
 };
 
 }}
@@ -70,6 +70,7 @@ class Function<RET(ARGS...)>
     using Callback = RET(*)(void*, ARGS...);
     using Destructor = void(*)(void*);
     using Deleter = void(*)(void*);
+    using Mover = void(*)(void*, void*);
     
 public:
     // Ctors
@@ -101,6 +102,7 @@ private:
     Callback                _invoker{nullptr};
     Destructor              _destructor{dummy};
     Deleter                 _deleter{dummy};
+    Mover                   _mover{nullptr};
 };
 
 }}
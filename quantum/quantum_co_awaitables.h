@@ -0,0 +1,270 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_CO_AWAITABLES_H
+#define BLOOMBERG_QUANTUM_CO_AWAITABLES_H
+
+#if defined(__cpp_impl_coroutine)
+
+#include <quantum/quantum_co_task.h>
+#include <quantum/quantum_condition_variable.h>
+#include <quantum/quantum_mutex.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <utility>
+
+namespace Bloomberg {
+namespace quantum {
+namespace co {
+
+//==============================================================================================
+//                                     class Awaitable
+//==============================================================================================
+/// @class Awaitable.
+/// @brief Base class for all quantum awaitables. Suspending registers the awaitable with the driver
+///        of the co::Task chain which then polls it each time the quantum task is scheduled.
+/// @note For internal use only.
+class Awaitable : public Driver::Waiter
+{
+public:
+    bool await_ready() { return poll(); }
+
+    template <class PROMISE>
+    void await_suspend(std::coroutine_handle<PROMISE> handle);
+};
+
+//==============================================================================================
+//                                    class FutureAwaiter
+//==============================================================================================
+/// @class FutureAwaiter.
+/// @brief Awaits a thread or coroutine future or context.
+/// @tparam FUTURE A ThreadFuturePtr, CoroFuturePtr, ThreadContextPtr or CoroContextPtr.
+/// @note Buffered futures are not supported.
+template <class FUTURE>
+class FutureAwaiter : public Awaitable
+{
+public:
+    explicit FutureAwaiter(FUTURE future);
+    bool poll() final;
+    auto await_resume();
+private:
+    FUTURE  _future;
+};
+
+//==============================================================================================
+//                                      class LockGuard
+//==============================================================================================
+/// @class LockGuard.
+/// @brief Move-only RAII ownership of a quantum::Mutex acquired via co_await co::lock().
+/// @details The mutex is released when the guard is destroyed, unless unlock() was called or the guard was
+///          moved from. Unlike Mutex::Guard, the guard may be moved out of the scope which acquired it.
+class [[nodiscard]] LockGuard
+{
+public:
+    /// @brief Constructs a guard which owns nothing.
+    LockGuard() = default;
+
+    /// @brief Adopts a mutex already locked by the caller.
+    /// @param[in] mutex The mutex.
+    explicit LockGuard(Mutex& mutex);
+
+    LockGuard(const LockGuard& other) = delete;
+    LockGuard(LockGuard&& other) noexcept;
+    LockGuard& operator=(const LockGuard& other) = delete;
+    LockGuard& operator=(LockGuard&& other) noexcept;
+
+    /// @brief Destructor. Releases the mutex if still owned.
+    ~LockGuard();
+
+    /// @brief Releases the mutex before the guard goes out of scope.
+    void unlock();
+
+    /// @brief Determines if this object owns a mutex.
+    /// @return True if a mutex is owned, false otherwise.
+    bool ownsLock() const;
+
+private:
+    Mutex*  _mutex{nullptr};
+};
+
+//==============================================================================================
+//                                     class LockAwaiter
+//==============================================================================================
+/// @class LockAwaiter.
+/// @brief Acquires a quantum::Mutex without blocking the coroutine thread.
+class LockAwaiter : public Awaitable
+{
+public:
+    explicit LockAwaiter(Mutex& mutex);
+    bool poll() final;
+    LockGuard await_resume() const;
+private:
+    Mutex&  _mutex;
+};
+
+//==============================================================================================
+//                                class ConditionVariableWaiter
+//==============================================================================================
+/// @class ConditionVariableWaiter.
+/// @brief Waits on a quantum::ConditionVariable without blocking the coroutine thread.
+/// @details Same semantics as ConditionVariable::wait(): the mutex is released while waiting and re-acquired
+///          before the coroutine resumes. Since the coroutine cannot yield from within the wait, the awaiter
+///          registers its own signal with the condition variable and polls it.
+class ConditionVariableWaiter : public Awaitable
+{
+public:
+    ConditionVariableWaiter(ConditionVariable& cond,
+                            Mutex& mutex,
+                            std::function<bool()> predicate = nullptr);
+    ~ConditionVariableWaiter();
+    bool await_ready();
+    bool poll() final;
+    void await_resume() const noexcept {}
+private:
+    bool enqueue();
+
+    ConditionVariable&      _cond;
+    Mutex&                  _mutex;
+    std::function<bool()>   _predicate;
+    std::atomic_int         _signal{-1};
+};
+
+//==============================================================================================
+//                                     class SleepAwaiter
+//==============================================================================================
+/// @class SleepAwaiter.
+/// @brief Suspends the coroutine for a period of time while letting other tasks run.
+class SleepAwaiter : public Awaitable
+{
+public:
+    explicit SleepAwaiter(std::chrono::steady_clock::duration duration);
+    bool poll() final;
+    int pendingCode() const final;
+    void await_resume() const noexcept {}
+private:
+    std::chrono::steady_clock::time_point _deadline;
+};
+
+//==============================================================================================
+//                                     class YieldAwaiter
+//==============================================================================================
+/// @class YieldAwaiter.
+/// @brief Suspends the coroutine and gives other tasks on the same queue a chance to run.
+class YieldAwaiter
+{
+public:
+    bool await_ready() const noexcept { return false; }
+    template <class PROMISE>
+    void await_suspend(std::coroutine_handle<PROMISE> handle);
+    void await_resume() const noexcept {}
+};
+
+//==============================================================================================
+//                                      class IoAwaiter
+//==============================================================================================
+/// @class IoAwaiter.
+/// @brief Runs a blocking callable on the IO thread pool and suspends the coroutine until it completes.
+template <class FUNC>
+class IoAwaiter : public Awaitable
+{
+public:
+    using Result = std::invoke_result_t<FUNC&>;
+
+    IoAwaiter(int queueId, bool isHighPriority, FUNC&& func);
+    bool await_ready() const noexcept { return false; }
+    template <class PROMISE>
+    void await_suspend(std::coroutine_handle<PROMISE> handle);
+    bool poll() final;
+    Result await_resume();
+private:
+    using FutureType = std::conditional_t<std::is_void_v<Result>, Void, Result>;
+
+    int                         _queueId;
+    bool                        _isHighPriority;
+    FUNC                        _func;
+    ThreadFuturePtr<FutureType> _future;
+};
+
+/// @brief Acquires a mutex from within a co::Task.
+/// @param[in] mutex The mutex to lock.
+/// @return An awaitable whose result is a LockGuard owning the mutex. The mutex is released when the guard is
+///         destroyed, hence the result must be kept for as long as the mutex should be held.
+/// @code
+///       co::LockGuard guard = co_await co::lock(mutex);
+/// @endcode
+LockAwaiter lock(Mutex& mutex);
+
+/// @brief Waits on a condition variable from within a co::Task.
+/// @param[in] cond The condition variable.
+/// @param[in] mutex A mutex which must be locked by the caller (see lock()). It is released during the wait and
+///                  re-acquired before the co_await completes.
+/// @return An awaitable.
+ConditionVariableWaiter wait(ConditionVariable& cond, Mutex& mutex);
+
+/// @brief Waits on a condition variable from within a co::Task until a predicate is satisfied.
+/// @param[in] cond The condition variable.
+/// @param[in] mutex A mutex which must be locked by the caller. It is held whenever the predicate is evaluated.
+/// @param[in] predicate Callable with signature 'bool f()'.
+/// @return An awaitable.
+template <class PREDICATE>
+ConditionVariableWaiter wait(ConditionVariable& cond, Mutex& mutex, PREDICATE predicate);
+
+/// @brief Suspends the co::Task for a period of time.
+/// @param[in] duration The sleep duration.
+/// @return An awaitable.
+template <class REP, class PERIOD>
+SleepAwaiter sleep(const std::chrono::duration<REP, PERIOD>& duration);
+
+/// @brief Yields control to other tasks running on the same queue.
+/// @return An awaitable.
+YieldAwaiter yield();
+
+/// @brief Runs a blocking callable on the IO thread pool and suspends the co::Task until it completes.
+/// @param[in] func Callable object with signature 'RET f(ARGS...)'. RET may be void.
+/// @param[in] args Arguments passed to the callable. They are copied or moved into the IO task.
+/// @return An awaitable whose result is the callable's return value.
+template <class FUNC, class ... ARGS>
+auto postAsyncIo(FUNC&& func, ARGS&&... args);
+
+/// @brief Same as above but runs the callable on a specific IO queue.
+/// @param[in] queueId Id of the IO queue. Same range as for Dispatcher::postAsyncIo().
+/// @param[in] isHighPriority If set to true, the IO task is scheduled to run immediately.
+template <class FUNC, class ... ARGS>
+auto postAsyncIo(int queueId, bool isHighPriority, FUNC&& func, ARGS&&... args);
+
+} //namespace co
+
+/// @brief Awaiting thread and coroutine futures or contexts from within a co::Task.
+/// @return The future value. Exceptions set on the promise are rethrown.
+template <class T>
+co::FutureAwaiter<ThreadFuturePtr<T>> operator co_await(std::shared_ptr<IThreadFuture<T>> future);
+
+template <class T>
+co::FutureAwaiter<CoroFuturePtr<T>> operator co_await(std::shared_ptr<ICoroFuture<T>> future);
+
+template <class T>
+co::FutureAwaiter<ThreadContextPtr<T>> operator co_await(std::shared_ptr<IThreadContext<T>> context);
+
+template <class T>
+co::FutureAwaiter<CoroContextPtr<T>> operator co_await(std::shared_ptr<ICoroContext<T>> context);
+
+}}
+
+#include <quantum/impl/quantum_co_awaitables_impl.h>
+
+#endif //__cpp_impl_coroutine
+
+#endif //BLOOMBERG_QUANTUM_CO_AWAITABLES_H
@@ -0,0 +1,174 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_CO_GENERATOR_H
+#define BLOOMBERG_QUANTUM_CO_GENERATOR_H
+
+//C++20 stackless coroutines are only available when the compiler supports them (e.g. -std=c++20).
+#if defined(__cpp_impl_coroutine)
+
+#include <quantum/quantum_co_task.h>
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+namespace Bloomberg {
+namespace quantum {
+namespace co {
+
+template <class T>
+class Generator;
+
+//==============================================================================================
+//                                  class GeneratorPromise
+//==============================================================================================
+/// @class GeneratorPromise.
+/// @brief Promise type of co::Generator<T>.
+/// @note Frames are allocated from the same pools as co::Task frames.
+/// @note For internal use only.
+template <class T>
+class GeneratorPromise
+{
+public:
+    //Holds a copy of a read-only value in the coroutine frame while the generator is suspended
+    struct CopyAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<>) noexcept { _promise->_value = std::addressof(_copy); }
+        void await_resume() const noexcept {}
+
+        GeneratorPromise*   _promise;
+        T                   _copy;
+    };
+
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
+    Generator<T> get_return_object() noexcept;
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    std::suspend_always final_suspend() const noexcept { return {}; }
+    std::suspend_always yield_value(T& value) noexcept;
+    std::suspend_always yield_value(T&& value) noexcept;
+    CopyAwaiter yield_value(const T& value);
+    void return_void() noexcept {}
+    void unhandled_exception() noexcept;
+
+    //Generators are resumed by their consumer only, hence they cannot await anything
+    template <class U>
+    std::suspend_never await_transform(U&&) = delete;
+
+    T* getValue() const;
+    void rethrowIfFailed() const;
+
+private:
+    T*                  _value{nullptr};
+    std::exception_ptr  _exception;
+};
+
+//==============================================================================================
+//                                     class Generator
+//==============================================================================================
+/// @class Generator.
+/// @brief Lazy sequence of values produced by a C++20 stackless coroutine.
+/// @details Any function returning co::Generator<T> and containing co_yield is a generator. It does not run
+///          until the first value is requested, and each co_yield suspends it until the consumer asks for the
+///          next value. The consumer reads each value in place inside the coroutine frame, so values are neither
+///          copied (unless read-only) nor locked. This is the stackless counterpart of quantum::Generator<T>
+///          and has the same interface.
+/// @tparam T The type of the values produced.
+/// @note Generators are resumed synchronously by their consumer and therefore cannot co_await. They may be
+///       consumed from any thread, including from inside a co::Task or a stackful coroutine.
+template <class T>
+class Generator
+{
+public:
+    using promise_type = GeneratorPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+    using ValueType = T;
+
+    //==============================================================================================
+    //                                      class Iterator
+    //==============================================================================================
+    /// @class Iterator.
+    /// @brief Input iterator over the generated values. Advancing it resumes the generator.
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const;
+        Iterator& operator++();
+        void operator++(int);
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        friend class Generator<T>;
+        explicit Iterator(Generator<T>* generator);
+
+        Generator<T>* _generator{nullptr};
+    };
+
+    Generator(const Generator& other) = delete;
+    Generator(Generator&& other) noexcept;
+    Generator& operator=(const Generator& other) = delete;
+    Generator& operator=(Generator&& other) noexcept;
+    ~Generator();
+
+    /// @brief Resumes the generator until its next co_yield or until it returns.
+    /// @return True if a new value is available via value(), false if the generator has returned.
+    /// @note If the generator throws, the exception is propagated to the caller.
+    bool next();
+
+    /// @brief Get the value produced by the last successful call to next().
+    /// @return A reference to the value, valid until the generator is resumed.
+    T& value() const;
+
+    /// @brief Checks if the generator has returned.
+    /// @return True if done, false otherwise.
+    bool done() const;
+
+    /// @brief Resumes the generator and returns an iterator to the value it yields.
+    /// @return The iterator, or end() if the generator returned without yielding any more values.
+    /// @note Since each value is only produced once, begin() should only be called once per generator.
+    Iterator begin();
+
+    /// @brief Get the iterator past the last value.
+    /// @return The iterator.
+    Iterator end();
+
+private:
+    friend class GeneratorPromise<T>;
+
+    explicit Generator(Handle handle);
+
+    Handle _handle;
+};
+
+}}}
+
+#include <quantum/impl/quantum_co_generator_impl.h>
+
+#endif //__cpp_impl_coroutine
+
+#endif //BLOOMBERG_QUANTUM_CO_GENERATOR_H
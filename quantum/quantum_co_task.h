@@ -0,0 +1,301 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_CO_TASK_H
+#define BLOOMBERG_QUANTUM_CO_TASK_H
+
+//C++20 stackless coroutines are only available when the compiler supports them (e.g. -std=c++20).
+#if defined(__cpp_impl_coroutine)
+
+#include <quantum/quantum_dispatcher.h>
+#include <quantum/quantum_promise.h>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace Bloomberg {
+namespace quantum {
+namespace co {
+
+template <class T>
+class Task;
+
+//==============================================================================================
+//                                     class Driver
+//==============================================================================================
+/// @class Driver.
+/// @brief Resumes the C++20 coroutine chain of a spawned co::Task from inside a quantum task.
+/// @details A spawned co::Task runs as a polled run-to-completion task (see Dispatcher::postLite()). Whenever
+///          a coroutine in the chain suspends, it registers itself and optionally a Waiter with the driver.
+///          Each time the quantum task is scheduled, the waiter is polled and the coroutine resumed once it
+///          is ready. This mirrors the way stackful coroutines poll their futures, mutexes and condition
+///          variables, so both kinds of coroutines share the same queues and scheduling.
+/// @note For internal use only.
+class Driver
+{
+public:
+    /// @brief Condition on which a suspended coroutine waits.
+    struct Waiter
+    {
+        virtual ~Waiter() = default;
+
+        /// @brief Checks if the coroutine can be resumed.
+        /// @return True if ready, false otherwise.
+        virtual bool poll() = 0;
+
+        /// @brief Return code reported to the task queue while the waiter is not ready.
+        /// @return ITask::RetCode::Blocked or ITask::RetCode::Sleeping.
+        virtual int pendingCode() const { return (int)ITask::RetCode::Blocked; }
+    };
+
+    /// @brief Constructor.
+    /// @param[in] dispatcher The dispatcher on which the coroutine chain runs.
+    explicit Driver(Dispatcher& dispatcher);
+
+    /// @brief Get the dispatcher on which the coroutine chain runs.
+    /// @return The dispatcher.
+    Dispatcher& dispatcher() const;
+
+    /// @brief Registers a suspended coroutine.
+    /// @param[in] handle The coroutine to resume.
+    /// @param[in] waiter Condition which must be met before resuming. If null the coroutine is resumed the next
+    ///                   time the task is scheduled.
+    void suspend(std::coroutine_handle<> handle, Waiter* waiter = nullptr);
+
+    /// @brief Resumes the suspended coroutine if its waiter is ready.
+    /// @return ITask::RetCode::Success when the coroutine chain has no more suspended coroutines, otherwise
+    ///         ITask::RetCode::Running, Blocked or Sleeping.
+    int step();
+
+private:
+    Dispatcher&             _dispatcher;
+    std::coroutine_handle<> _handle;
+    Waiter*                 _waiter{nullptr};
+};
+
+//==============================================================================================
+//                                   class TaskPromiseBase
+//==============================================================================================
+/// @class TaskPromiseBase.
+/// @brief Promise type members common to all co::Task coroutines.
+/// @note Coroutines start suspended and are resumed by the driver or by the coroutine awaiting them.
+///       Frames are allocated from size-class pools (see AllocatorTraits::coroFrameAllocSize()).
+/// @note For internal use only.
+class TaskPromiseBase
+{
+public:
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+        template <class PROMISE>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<PROMISE> handle) const noexcept;
+        void await_resume() const noexcept {}
+    };
+
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept;
+
+    void setDriver(Driver* driver);
+    Driver* getDriver() const;
+    void setContinuation(std::coroutine_handle<> continuation);
+
+protected:
+    void rethrowIfFailed() const;
+
+private:
+    Driver*                 _driver{nullptr};
+    std::coroutine_handle<> _continuation;
+    std::exception_ptr      _exception;
+};
+
+//==============================================================================================
+//                                     class TaskPromise
+//==============================================================================================
+/// @class TaskPromise.
+/// @brief Promise type of co::Task<T>.
+/// @note For internal use only.
+template <class T>
+class TaskPromise : public TaskPromiseBase
+{
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <class V>
+    void return_value(V&& value);
+
+    T getResult();
+
+private:
+    std::optional<T> _value;
+};
+
+template <>
+class TaskPromise<void> : public TaskPromiseBase
+{
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() noexcept {}
+
+    void getResult();
+};
+
+//==============================================================================================
+//                                        class Task
+//==============================================================================================
+/// @class Task.
+/// @brief Lazily-started C++20 stackless coroutine returning a value of type T.
+/// @details Any function returning co::Task<T> and containing co_await or co_return is a stackless
+///          coroutine. It does not run until it is either awaited by another co::Task or handed to the
+///          dispatcher via co::spawn(). Unlike coroutines posted via Dispatcher::post(), no stack is allocated:
+///          local variables live in a small heap frame (typically a few hundred bytes) which is allocated from
+///          a pool, and suspending or resuming costs a function call rather than a context switch.
+///          Inside a co::Task the following may be awaited (see quantum_co_awaitables.h):
+///          - another co::Task<U>, which runs inline on the same quantum task;
+///          - thread and coroutine futures or contexts returned by the Dispatcher or by other coroutines;
+///          - co::lock(), co::wait(), co::sleep(), co::yield() and co::postAsyncIo().
+/// @tparam T The type of the coroutine result. Can be void.
+/// @note Awaitables from other libraries are not supported since the quantum task would have no way of knowing
+///       when to resume the coroutine.
+template <class T = void>
+class Task
+{
+public:
+    using promise_type = TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct Awaiter
+    {
+        bool await_ready() const noexcept;
+        template <class PROMISE>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<PROMISE> parent) noexcept;
+        T await_resume();
+
+        Handle _handle;
+    };
+
+    Task(const Task& other) = delete;
+    Task(Task&& other) noexcept;
+    Task& operator=(const Task& other) = delete;
+    Task& operator=(Task&& other) noexcept;
+    ~Task();
+
+    /// @brief Checks if this object refers to a coroutine.
+    /// @return True if valid, false otherwise.
+    bool valid() const;
+
+    /// @brief Checks if the coroutine ran to completion.
+    /// @return True if completed, false otherwise.
+    bool done() const;
+
+    /// @brief Runs the coroutine inline and suspends the caller until it completes.
+    /// @return The coroutine result. If the coroutine threw, the exception is rethrown in the caller.
+    Awaiter operator co_await() const noexcept;
+
+private:
+    friend class TaskPromise<T>;
+    template <class U> friend class Runner;
+
+    explicit Task(Handle handle);
+
+    Handle _handle;
+};
+
+//==============================================================================================
+//                                        class Runner
+//==============================================================================================
+/// @class Runner.
+/// @brief Drives a spawned co::Task from a polled run-to-completion quantum task and fulfills its promise.
+/// @note For internal use only.
+template <class T>
+class Runner
+{
+public:
+    using Result = std::conditional_t<std::is_void_v<T>, Void, T>;
+
+    Runner(Dispatcher& dispatcher, Task<T>&& task);
+
+    /// @brief Advances the coroutine chain.
+    /// @return See Driver::step(). On completion the promise is set and 0 is returned.
+    int step();
+
+    const PromisePtr<Result>& getPromise() const;
+
+private:
+    void setResult();
+
+    Driver              _driver;
+    Task<T>             _task;
+    PromisePtr<Result>  _promise;
+};
+
+/// @brief Result type of a spawned co::Task<T>. Void tasks produce a quantum::Void result.
+template <class T>
+using SpawnResult = typename Runner<T>::Result;
+
+/// @brief Runs a co::Task on one of the coroutine threads.
+/// @param[in] dispatcher The dispatcher.
+/// @param[in] task The coroutine to run.
+/// @param[in] queueId Id of the queue where this coroutine should run. Same range as for Dispatcher::post().
+/// @param[in] isHighPriority If set to true, the coroutine will be scheduled to run immediately.
+/// @return A pointer to a thread future holding the coroutine result.
+/// @note This function is non-blocking and returns immediately.
+template <class T>
+ThreadFuturePtr<SpawnResult<T>>
+spawn(Dispatcher& dispatcher,
+      Task<T> task,
+      int queueId = (int)IQueue::QueueId::Any,
+      bool isHighPriority = false);
+
+/// @brief Runs a co::Task from a (stackful) coroutine.
+/// @param[in] ctx The calling coroutine context.
+/// @param[in] dispatcher The dispatcher.
+/// @param[in] task The coroutine to run.
+/// @param[in] queueId Id of the queue where this coroutine should run. Same range as for Dispatcher::post().
+/// @param[in] isHighPriority If set to true, the coroutine will be scheduled to run immediately.
+/// @return A pointer to a coroutine future which the calling coroutine can wait on without blocking its thread.
+template <class T>
+CoroFuturePtr<SpawnResult<T>>
+spawn(VoidContextPtr ctx,
+      Dispatcher& dispatcher,
+      Task<T> task,
+      int queueId = (int)IQueue::QueueId::Any,
+      bool isHighPriority = false);
+
+/// @brief Allocates a coroutine frame from the pool matching its size.
+/// @param[in] size Frame size in bytes.
+/// @return The frame memory.
+/// @note For internal use only.
+void* allocateFrame(size_t size);
+
+/// @brief Releases a coroutine frame allocated with allocateFrame().
+/// @param[in] p The frame memory.
+/// @param[in] size Frame size in bytes.
+/// @note For internal use only.
+void deallocateFrame(void* p, size_t size);
+
+}}}
+
+#include <quantum/impl/quantum_co_task_impl.h>
+
+#endif //__cpp_impl_coroutine
+
+#endif //BLOOMBERG_QUANTUM_CO_TASK_H
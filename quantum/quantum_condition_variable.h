@@ -26,6 +26,10 @@
 namespace Bloomberg {
 namespace quantum {
 
+namespace co {
+class ConditionVariableWaiter;
+}
+
 //==============================================================================================
 //                                   class ConditionVariable
 //==============================================================================================
@@ -203,6 +207,9 @@ public:
                  PREDICATE predicate);
     
 private:
+    //C++20 coroutines cannot yield from within a wait and register their own signal instead
+    friend class co::ConditionVariableWaiter;
+    
     void notifyOneImpl(ICoroSync::Ptr sync);
     
     void notifyAllImpl(ICoroSync::Ptr sync);
@@ -227,7 +234,7 @@ private:
                      PREDICATE predicate);
     
     //MEMBERS
-    Mutex                           _thisLock; //sync access to this object
+    Mutex                           _thisLock{"ConditionVariable"}; //sync access to this object
     std::list<std::atomic_int*>     _waiters;
     std::atomic_bool                _destroyed;
 };
@@ -18,6 +18,8 @@
 
 #include <quantum/quantum_thread_traits.h>
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <utility>
 
 namespace Bloomberg {
@@ -33,6 +35,14 @@ class Configuration
 public:
      enum class BackoffPolicy : int { Linear,        ///< Linear backoff
                                       Exponential }; ///< Exponential backoff (doubles every time)
+    
+    /// @brief Callback invoked by the watchdog thread when a coroutine runs longer than the watchdog threshold
+    ///        without yielding.
+    /// @param[in] queueId The coroutine queue whose thread is monopolized, or IQueue::QueueId::Any for the thread
+    ///                    of the shared coroutine queue.
+    /// @param[in] taskId Identifier of the coroutine. Matches the task ids reported by the Tracer.
+    /// @param[in] elapsed Time since the coroutine was last started or resumed.
+    using WatchdogCallback = std::function<void(int queueId, uint64_t taskId, std::chrono::nanoseconds elapsed)>;
                            
     /// @brief Get the JSON schema corresponding to this configuration object.
     /// @return The draft-04 compatible schema.
@@ -95,6 +105,28 @@ public:
     /// will _not_ work as expected.
     void setCoroutineSharingForAny(bool sharing);
     
+    /// @brief Set the longest time a coroutine may run without yielding before the watchdog reports it.
+    /// @param[in] threshold The threshold. Default is 0 which disables the watchdog.
+    /// @note The watchdog runs on a dedicated thread which samples the coroutine threads four times per threshold
+    ///       interval. It only starts if a callback is also set.
+    void setWatchdogThreshold(std::chrono::milliseconds threshold);
+    
+    /// @brief Set the function called by the watchdog. It is called at most once per coroutine run slice.
+    /// @param[in] callback The callback. It runs on the watchdog thread and must not block or throw.
+    void setWatchdogCallback(WatchdogCallback callback);
+    
+    /// @brief Reuse coroutines across tasks.
+    /// @param[in] value If set to true, a coroutine whose task completes is kept in a pool along with its stack
+    ///                  and runs the next posted task, instead of being destroyed and a new one created for every
+    ///                  task. This removes the coroutine setup and teardown costs at high task rates. Default is false.
+    /// @note Stacks of idle coroutines remain allocated (see setMaxIdleCoroutines()).
+    void setReuseCoroutines(bool value);
+    
+    /// @brief Set the maximum number of idle coroutines kept for reuse by each coroutine thread.
+    /// @param[in] num The number of coroutines. Coroutines completing while the pool is full are destroyed.
+    ///                Default is 200. Only applies if setReuseCoroutines() is true.
+    void setMaxIdleCoroutines(size_t num);
+    
     /// @brief Get the number of coroutine threads.
     /// @return The number of threads.
     int getNumCoroutineThreads() const;
@@ -132,6 +164,22 @@ public:
     /// @return the enablement flag for the feature
     bool getCoroutineSharingForAny() const;
     
+    /// @brief Get the watchdog threshold.
+    /// @return The threshold. 0 if the watchdog is disabled.
+    std::chrono::milliseconds getWatchdogThreshold() const;
+    
+    /// @brief Get the watchdog callback.
+    /// @return The callback.
+    const WatchdogCallback& getWatchdogCallback() const;
+    
+    /// @brief Check if coroutines are reused across tasks.
+    /// @return True or False.
+    bool getReuseCoroutines() const;
+    
+    /// @brief Get the maximum number of idle coroutines kept for reuse.
+    /// @return The number of coroutines.
+    size_t getMaxIdleCoroutines() const;
+    
 private:
     int                         _numCoroutineThreads{-1};
     int                         _numIoThreads{5};
@@ -142,6 +190,10 @@ private:
     size_t                      _loadBalancePollIntervalNumBackoffs{0};
     std::pair<int, int>         _coroQueueIdRangeForAny{-1, -1};
     bool                        _coroutineSharingForAny{false};
+    std::chrono::milliseconds   _watchdogThreshold{0};
+    WatchdogCallback            _watchdogCallback;
+    bool                        _reuseCoroutines{false};
+    size_t                      _maxIdleCoroutines{200};
 };
 
 }}
@@ -249,6 +249,43 @@ public:
     typename Context<std::vector<std::vector<OTHER_RET>>>::Ptr
     forEachBatch(INPUT_IT first, size_t num, FUNC&& func);
     
+    template <class OTHER_RET, class INPUT_IT, class FUNC, class = Traits::IsInputIterator<INPUT_IT>>
+    typename Context<typename Traits::ChunkResults<OTHER_RET>::Type>::Ptr
+    forEachChunk(INPUT_IT first, INPUT_IT last, size_t chunkSize, FUNC&& func);
+    
+    template <class INPUT_IT, class OUTPUT_IT, class FUNC, class = Traits::IsInputIterator<INPUT_IT>>
+    std::shared_ptr<Context<int>>
+    forEachChunk(INPUT_IT first, INPUT_IT last, size_t chunkSize, OUTPUT_IT outFirst, FUNC&& func);
+    
+    template <class OTHER_RET, class INPUT_IT, class FUNC, class = Traits::IsInputIterator<INPUT_IT>>
+    typename Context<typename Traits::ChunkResults<OTHER_RET>::Type>::Ptr
+    forEachAsyncIo(INPUT_IT first, INPUT_IT last, FUNC&& func, size_t chunkSize);
+    
+    template <class OTHER_RET, class INPUT_IT, class FUNC, class = Traits::IsInputIterator<INPUT_IT>>
+    typename Context<std::vector<OTHER_RET>>::Ptr
+    parallelFor(INPUT_IT first, INPUT_IT last, FUNC&& func, size_t grainSize);
+    
+    template <class FUNC>
+    std::shared_ptr<Context<int>>
+    parallelFor2D(size_t rows, size_t cols, size_t tileRows, size_t tileCols, FUNC&& func);
+    
+    template <class INPUT_IT, class T, class REDUCE_FUNC, class TRANSFORM_FUNC, class = Traits::IsInputIterator<INPUT_IT>>
+    typename Context<T>::Ptr
+    transformReduce(INPUT_IT first,
+                    INPUT_IT last,
+                    T init,
+                    REDUCE_FUNC&& reduceFunc,
+                    TRANSFORM_FUNC&& transformFunc,
+                    size_t grainSize);
+    
+    template <class T, class INPUT_IT, class FUNC, class = Traits::IsInputIterator<INPUT_IT>>
+    typename Context<std::vector<T>>::Ptr
+    scan(INPUT_IT first, INPUT_IT last, T init, FUNC&& func, bool isInclusive);
+    
+    template <class RANDOM_IT, class COMPARE, class = Traits::IsInputIterator<RANDOM_IT>>
+    std::shared_ptr<Context<int>>
+    sort(RANDOM_IT first, RANDOM_IT last, COMPARE compare, bool isStable);
+    
     //===================================
     //           MAP REDUCE
     //===================================
@@ -273,6 +310,19 @@ public:
               Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
               Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer);
     
+    template <class KEY,
+              class MAPPED_TYPE,
+              class REDUCED_TYPE,
+              class OUTPUT,
+              class INPUT_IT>
+    typename Context<typename OUTPUT::template Container<KEY, REDUCED_TYPE>>::Ptr
+    mapReduce(INPUT_IT first,
+              size_t num,
+              Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
+              Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer,
+              Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+              OUTPUT output);
+    
     template <class KEY,
               class MAPPED_TYPE,
               class REDUCED_TYPE,
@@ -294,6 +344,45 @@ public:
                    Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
                    Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer);
     
+    template <class KEY,
+              class MAPPED_TYPE,
+              class REDUCED_TYPE,
+              class OUTPUT,
+              class INPUT_IT>
+    typename Context<typename OUTPUT::template Container<KEY, REDUCED_TYPE>>::Ptr
+    mapReduceBatch(INPUT_IT first,
+                   size_t num,
+                   Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
+                   Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer,
+                   Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+                   OUTPUT output);
+    
+    template <class KEY,
+              class MAPPED_TYPE,
+              class REDUCED_TYPE,
+              class OUTPUT,
+              class INPUT_IT>
+    typename Context<typename OUTPUT::template Container<KEY, REDUCED_TYPE>>::Ptr
+    mapReduceAsyncIo(INPUT_IT first,
+                     size_t num,
+                     Functions::IoMapFunc<KEY, MAPPED_TYPE, INPUT_IT> mapper,
+                     Functions::IoReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE> reducer,
+                     Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+                     OUTPUT output,
+                     size_t chunkSize);
+    
+    template <class KEY,
+              class MAPPED_TYPE,
+              class RECORD,
+              class OUTPUT,
+              class SOURCE>
+    typename Context<typename OUTPUT::template Container<KEY, MAPPED_TYPE>>::Ptr
+    mapReduceStream(SOURCE source,
+                    Functions::StreamMapFunc<KEY, MAPPED_TYPE, RECORD> mapper,
+                    Functions::CombineFunc<KEY, MAPPED_TYPE> combiner,
+                    OUTPUT output,
+                    size_t batchSize);
+    
     //===================================
     //           NEW / DELETE
     //===================================
@@ -0,0 +1,102 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_CORO_LOCAL_STORAGE_H
+#define BLOOMBERG_QUANTUM_CORO_LOCAL_STORAGE_H
+
+#include <quantum/quantum_read_write_spinlock.h>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/// @brief Number of coro-local-variable slots stored inline in each task. Slots beyond this
+///        number are allocated on first access.
+#ifndef __QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS
+    #define __QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS 4
+#endif
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                   class CoroLocalStorage
+//==============================================================================================
+/// @class CoroLocalStorage.
+/// @brief Storage for the coro-local-variable pointers of a coroutine, indexed by slot.
+/// @details Slots are process-wide indexes handed out by registerSlot(). The first
+///          __QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS slots live inside the object and the remaining
+///          ones in an overflow container which is only allocated when such a slot is first written.
+///          Names which were never registered are kept in a per-coroutine map instead, so that
+///          arbitrary names do not grow the registry. References returned by at() remain valid for
+///          the lifetime of the storage.
+/// @note For internal use only. See local::variable() and local::get() for the public API.
+class CoroLocalStorage
+{
+public:
+    using Slot = uint32_t;
+    
+    /// @brief Accesses the pointer stored in a slot, allocating it if needed.
+    /// @param[in] slot The slot index.
+    /// @return A reference to the pointer, which is null if never set.
+    void*& at(Slot slot);
+    
+    /// @brief Reads the pointer stored in a slot without allocating it.
+    /// @param[in] slot The slot index.
+    /// @return The pointer or null if never set.
+    void* get(Slot slot) const;
+    
+    /// @brief Accesses the pointer stored under an unregistered name, allocating it if needed.
+    /// @param[in] name The variable name.
+    /// @return A reference to the pointer, which is null if never set.
+    void*& at(const std::string& name);
+    
+    /// @brief Returns the slot associated with a name, registering it on first use.
+    /// @param[in] name The variable name.
+    /// @return The slot index. Registering the same name again returns the same slot.
+    /// @note Names are never unregistered, hence they should be drawn from a bounded set.
+    static Slot registerSlot(const std::string& name);
+    
+    /// @brief Looks up the slot associated with a name without registering it.
+    /// @param[in] name The variable name.
+    /// @param[out] slot The slot index, if found.
+    /// @return True if the name was registered, false otherwise.
+    static bool findSlot(const std::string& name, Slot& slot);
+    
+    /// @brief Registers a new anonymous slot.
+    /// @return The slot index.
+    static Slot registerSlot();
+    
+private:
+    struct Registry
+    {
+        ReadWriteSpinLock                       _lock;
+        std::unordered_map<std::string, Slot>   _slots;
+        Slot                                    _nextSlot{0};
+    };
+    static Registry& registry();
+    
+    std::array<void*, __QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS>    _inline{};
+    std::unique_ptr<std::deque<void*>>                              _overflow; //deque keeps references stable
+    std::unique_ptr<std::unordered_map<std::string, void*>>         _named;    //unregistered names
+};
+
+}}
+
+#include <quantum/impl/quantum_coro_local_storage_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_CORO_LOCAL_STORAGE_H
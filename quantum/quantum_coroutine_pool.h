@@ -0,0 +1,128 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_COROUTINE_POOL_H
+#define BLOOMBERG_QUANTUM_COROUTINE_POOL_H
+
+#include <memory>
+#include <vector>
+#include <boost/optional.hpp>
+#include <quantum/quantum_allocator.h>
+#include <quantum/quantum_capture.h>
+#include <quantum/quantum_spinlock.h>
+#include <quantum/quantum_traits.h>
+
+namespace Bloomberg {
+namespace quantum {
+
+class CoroutinePool;
+
+//==============================================================================================
+//                                 class PooledCoroutine
+//==============================================================================================
+/// @class PooledCoroutine.
+/// @brief Coroutine which runs task bodies in a loop instead of completing after the first one.
+/// @details Once a task body returns, the coroutine suspends at the top of its loop and can be handed the next
+///          task, thereby keeping its stack and context record. This avoids the stack setup, initial context
+///          switch and unwinding which a fresh coroutine incurs for every task.
+/// @note For internal use only.
+class PooledCoroutine
+{
+public:
+    using Work = Function<int(Traits::Yield&)>;
+
+    PooledCoroutine(CoroutinePool& pool, size_t shard);
+
+    PooledCoroutine(const PooledCoroutine&) = delete;
+    PooledCoroutine& operator=(const PooledCoroutine&) = delete;
+
+    /// @brief Hands a new task body to an idle coroutine.
+    /// @param[in] work The task body. It runs the next time the coroutine is resumed.
+    void assign(Work&& work);
+
+    /// @brief Runs or resumes the current task body until it yields or returns.
+    /// @param[in,out] rc Return code set by the task body.
+    void resume(int& rc);
+
+    /// @brief Indicates if the last task body returned and a new one can be assigned.
+    /// @return True if idle, false otherwise.
+    bool isIdle() const;
+
+    /// @brief Get the pool which owns this coroutine.
+    /// @return The pool.
+    CoroutinePool& getPool() const;
+    
+    /// @brief Get the pool shard in which this coroutine is kept when idle.
+    /// @return The shard index.
+    size_t getShard() const;
+
+private:
+    void loop(Traits::Yield& yield);
+
+    CoroutinePool&          _pool;
+    size_t                  _shard;
+    boost::optional<Work>   _work;
+    Traits::Coroutine       _coro; //declared last so it unwinds before the task body is destroyed
+};
+
+//==============================================================================================
+//                                 class CoroutinePool
+//==============================================================================================
+/// @class CoroutinePool.
+/// @brief Thread-safe pool of idle coroutines shared by all the coroutine queues of a dispatcher.
+/// @details Idle coroutines are kept in one shard per coroutine thread so that threads acquiring and releasing
+///          coroutines do not contend with each other. A coroutine always returns to the shard it came from.
+/// @note For internal use only.
+class CoroutinePool
+{
+public:
+    using Handle = std::unique_ptr<PooledCoroutine>;
+
+    /// @brief Constructor.
+    /// @param[in] numShards Number of shards, typically the number of coroutine threads.
+    /// @param[in] maxIdle Maximum number of idle coroutines kept per shard. Coroutines released beyond this number
+    ///                    are destroyed.
+    CoroutinePool(size_t numShards, size_t maxIdle);
+
+    /// @brief Get an idle coroutine or create a new one if none is available.
+    /// @param[in] queueId The coroutine queue running the task. Any negative id maps to the first shard.
+    /// @param[in] work The task body assigned to the coroutine.
+    /// @return The coroutine.
+    Handle acquire(int queueId, PooledCoroutine::Work&& work);
+
+    /// @brief Returns an idle coroutine to the pool.
+    /// @param[in] coro The coroutine.
+    void release(Handle coro);
+
+    /// @brief Get the number of idle coroutines in all shards.
+    /// @return The number of coroutines.
+    size_t size() const;
+
+private:
+    struct Shard
+    {
+        mutable SpinLock        _spinlock{"CoroutinePool"};
+        std::vector<Handle>     _idle;
+    };
+    
+    size_t                  _maxIdle;
+    std::vector<Shard>      _shards;
+};
+
+}}
+
+#include <quantum/impl/quantum_coroutine_pool_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_COROUTINE_POOL_H
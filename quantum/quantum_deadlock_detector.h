@@ -0,0 +1,195 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_DEADLOCK_DETECTOR_H
+#define BLOOMBERG_QUANTUM_DEADLOCK_DETECTOR_H
+
+#include <quantum/quantum_tracer.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                   class DeadlockDetector
+//==============================================================================================
+/// @class DeadlockDetector.
+/// @brief Tracks which coroutines and threads wait on which Mutex, ConditionVariable or future, as well as the
+///        owner of each Mutex, and reports wait cycles and waits exceeding a threshold.
+/// @details When enabled, a background thread periodically inspects the wait graph. A cycle of Mutex waits, where
+///          each waiter owns the mutex the previous one waits for, is reported as a deadlock as soon as it is
+///          found. Any other wait is reported once it lasts longer than the threshold, along with the chain of
+///          mutex owners it transitively waits on. Each wait is reported at most once. Waiters are identified by
+///          the same task ids as reported by the Tracer and the Dispatcher snapshots, while regular threads are
+///          assigned ids from the same range.
+///          When disabled, the cost of each hook is a single relaxed atomic load. When enabled, every Mutex
+///          acquisition and release updates a shared table, so this is meant for diagnosing hangs rather than
+///          for production use.
+/// @code
+///    DeadlockDetector::enable(std::chrono::milliseconds(500), [](const DeadlockDetector::Report& report)
+///    {
+///        std::cerr << report;
+///    });
+/// @endcode
+/// @note Coroutines which are already running when the detector is enabled are identified from their next resume.
+class DeadlockDetector
+{
+public:
+    enum class Resource : int
+    {
+        Mutex,
+        ConditionVariable,
+        Future          ///< Any wait on a future or promise shared state, including buffer pulls
+    };
+
+    struct Wait
+    {
+        uint64_t                    _waiterId;      ///< Id of the waiting coroutine or thread
+        bool                        _isCoroutine;
+        int                         _queueId;       ///< Queue of the waiting coroutine. 0 for threads.
+        Resource                    _resource;
+        const void*                 _object;        ///< Address of the Mutex, ConditionVariable or future state
+        uint64_t                    _ownerId;       ///< Id of the mutex owner. 0 if unknown or not a mutex.
+        std::chrono::nanoseconds    _elapsed;       ///< Time spent waiting so far
+    };
+
+    struct Report
+    {
+        enum class Type : int
+        {
+            LongWait,   ///< The first wait exceeded the threshold
+            Deadlock    ///< The waits form a cycle
+        };
+
+        Type                _type;
+        std::vector<Wait>   _waits; ///< For a LongWait, the wait which exceeded the threshold followed by the
+                                    ///< waits of the successive mutex owners, if any. For a Deadlock, the cycle.
+    };
+
+    using Callback = std::function<void(const Report& report)>;
+
+    /// @brief Starts tracking waits. Previously tracked waits and mutex owners are discarded.
+    /// @param[in] threshold Minimum duration of a wait before it is reported.
+    /// @param[in] callback Called from the detector thread for each report.
+    /// @note Mutexes acquired before this call have no known owner until they are released.
+    static void enable(std::chrono::milliseconds threshold, Callback callback);
+
+    /// @brief Stops tracking waits and joins the detector thread.
+    /// @warning Must not be called from the callback.
+    static void disable();
+
+    /// @brief Indicates if waits are being tracked.
+    static bool isEnabled();
+
+    /// @brief Gets all the waits in progress.
+    static std::vector<Wait> getWaits();
+
+    /// @brief Records the start of a wait by the current coroutine or thread.
+    /// @return The waiter id to be passed to endWait(), or 0 if the wait is not tracked. Waits nested inside
+    ///         another wait of the same waiter (e.g. the mutex reacquired by a condition variable) are not tracked.
+    /// @note For internal use only.
+    static uint64_t beginWait(Resource resource, const void* object);
+
+    /// @brief Records the end of a wait started with beginWait().
+    /// @note For internal use only.
+    static void endWait(uint64_t waiterId);
+
+    /// @brief Records the current coroutine or thread as the owner of a mutex.
+    /// @note For internal use only.
+    static void onAcquire(const void* mutex);
+
+    /// @brief Clears the owner of a mutex.
+    /// @note For internal use only.
+    static void onRelease(const void* mutex);
+
+    /// @brief Sets the coroutine running on the current thread, or clears it if 'taskId' is 0.
+    /// @note For internal use only.
+    static void setCurrentTask(uint64_t taskId, int queueId);
+
+    //==============================================================================================
+    //                               class DeadlockDetector::WaitScope
+    //==============================================================================================
+    /// @class DeadlockDetector::WaitScope
+    /// @brief Tracks a wait for the lifetime of this object if the detector is enabled.
+    /// @note For internal use only.
+    class WaitScope
+    {
+    public:
+        WaitScope(Resource resource, const void* object);
+        ~WaitScope();
+        WaitScope(const WaitScope&) = delete;
+        WaitScope& operator=(const WaitScope&) = delete;
+    private:
+        uint64_t _waiterId{0};
+    };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct WaitEntry
+    {
+        bool                _isCoroutine;
+        int                 _queueId;
+        Resource            _resource;
+        const void*         _object;
+        Clock::time_point   _start;
+        bool                _isReported;
+    };
+
+    struct State
+    {
+        std::atomic_bool                                _isEnabled{false};
+        std::mutex                                      _controlMutex; //serializes enable() and disable()
+        std::mutex                                      _mutex; //protects the members below
+        std::condition_variable                         _cond;
+        bool                                            _stop{false};
+        std::chrono::milliseconds                       _threshold{0};
+        Callback                                        _callback;
+        std::unordered_map<uint64_t, WaitEntry>         _waits;
+        std::unordered_map<const void*, uint64_t>       _owners;
+        std::thread                                     _thread;
+    };
+
+    struct CurrentTask
+    {
+        uint64_t    _taskId{0};
+        int         _queueId{0};
+    };
+
+    static State& state();
+    static CurrentTask& currentTask();
+    static uint64_t currentWaiterId();
+    static Wait makeWait(const State& s, uint64_t waiterId, const WaitEntry& entry, Clock::time_point now);
+    static std::vector<Report> scan(State& s);
+    static void run();
+};
+
+/// @brief Overloads stream operator for DeadlockDetector::Report objects.
+std::ostream& operator<<(std::ostream& out, const DeadlockDetector::Report& report);
+
+}}
+
+#include <quantum/impl/quantum_deadlock_detector_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_DEADLOCK_DETECTOR_H
@@ -174,6 +174,55 @@ public:
     auto postAsyncIo2(int queueId, bool isHighPriority, FUNC&& func, ARGS&&... args)
         ->ThreadFuturePtr<decltype(resultOf2(func))>;
     
+    /// @brief Post a run-to-completion task to run asynchronously on the coroutine threads.
+    /// @details Unlike post(), the callable is not wrapped in a coroutine: no stack nor coroutine context is allocated
+    ///          and the task runs in one go when scheduled, saving memory and context switches for short tasks
+    ///          which never need to yield.
+    /// @tparam RET Type of future returned by this task.
+    /// @tparam FUNC Callable object type. Can be a standalone function, a method, an std::function,
+    ///              a functor generated via std::bind or a lambda. The signature of the callable
+    ///              object must strictly be 'int f(ThreadPromise<RET>::Ptr, ...)'.
+    /// @tparam ARGS Argument types passed to FUNC.
+    /// @param[in] func Callable object.
+    /// @param[in] args Variable list of arguments passed to the callable object.
+    /// @return A pointer to a thread future object.
+    /// @note This function is non-blocking and returns immediately. Since the task holds its coroutine thread until
+    ///       it returns, it must not block (e.g. waiting on futures or blocking IO). Coroutine-local variables are
+    ///       available within the task but local::context() returns null.
+    /// @note A callable which cannot complete yet may return ITask::RetCode::Running, Blocked or Sleeping. The task
+    ///       is then re-queued and the callable invoked again later (this is how co::spawn() drives C++20 coroutines).
+    ///       Arguments are moved into the callable on its first invocation so any state must be kept in captures.
+    template <class RET = Deprecated, class FUNC, class ... ARGS>
+    auto postLite(FUNC&& func, ARGS&&... args)->ThreadFuturePtr<decltype(ioResult(func))>;
+    
+    /// @brief Version 2 of the API which supports a simpler task signature (see documentation).
+    template <class RET = Deprecated, class FUNC, class ... ARGS>
+    auto postLite2(FUNC&& func, ARGS&&... args)->ThreadFuturePtr<decltype(resultOf2(func))>;
+    
+    /// @brief Post a run-to-completion task to run asynchronously on a specific queue (thread).
+    /// @tparam RET Type of future returned by this task.
+    /// @tparam FUNC Callable object type. Can be a standalone function, a method, an std::function,
+    ///              a functor generated via std::bind or a lambda. The signature of the callable
+    ///              object must strictly be 'int f(ThreadPromise<RET>::Ptr, ...)'.
+    /// @tparam ARGS Argument types passed to FUNC.
+    /// @param[in] queueId Id of the queue where this task should run. Note that the user can specify IQueue::QueueId::Any
+    ///                    as a value, which is equivalent to running the simpler version of postLite() above. Valid range is
+    ///                    [0, numCoroutineThreads) or IQueue::QueueId::Any.
+    /// @param[in] isHighPriority If set to true, the task will be scheduled to run immediately after the currently
+    ///                           executing coroutine on 'queueId' has completed or has yielded.
+    /// @param[in] func Callable object.
+    /// @param[in] args Variable list of arguments passed to the callable object.
+    /// @return A pointer to a thread future object.
+    /// @note See postLite() above.
+    template <class RET = Deprecated, class FUNC, class ... ARGS>
+    auto postLite(int queueId, bool isHighPriority, FUNC&& func, ARGS&&... args)
+        ->ThreadFuturePtr<decltype(ioResult(func))>;
+    
+    /// @brief Version 2 of the API which supports a simpler task signature (see documentation).
+    template <class RET = Deprecated, class FUNC, class ... ARGS>
+    auto postLite2(int queueId, bool isHighPriority, FUNC&& func, ARGS&&... args)
+        ->ThreadFuturePtr<decltype(resultOf2(func))>;
+    
     /// @brief Applies the given unary function to all the elements in the range [first,last).
     ///        This function runs in parallel.
     /// @tparam RET The return value of the unary function.
@@ -225,6 +274,197 @@ public:
     auto forEachBatch(INPUT_IT first, size_t num, FUNC&& func)
         ->ThreadContextPtr<std::vector<std::vector<decltype(coroResult(func))>>>;
     
+    /// @brief Applies the given function to consecutive chunks of the range [first,last).
+    /// @details Each call receives a contiguous sub-range, which allows the function to use vectorized kernels
+    ///          or to amortize per-call setup costs. One worker coroutine is started on each coroutine thread covered
+    ///          by IQueue::QueueId::Any and workers claim chunks in order until none are left.
+    /// @tparam INPUT_IT The type of iterator. Must meet the requirements of a RandomAccessIterator.
+    /// @tparam FUNC A function of type 'RET(VoidContextPtr, INPUT_IT begin, INPUT_IT end)'. RET may be void.
+    /// @param[in] first The first element in the range.
+    /// @param[in] last The last element in the range (exclusive).
+    /// @param[in] chunkSize The number of elements per chunk. The last chunk may be smaller. Set to 0 to create
+    ///                      one chunk per coroutine thread.
+    /// @param[in] func The function.
+    /// @return A vector of values (i.e. one per chunk in range order), or an int set to 0 if RET is void in which
+    ///         case no result vector is allocated.
+    /// @note RET cannot be 'bool'.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto forEachChunk(INPUT_IT first, INPUT_IT last, size_t chunkSize, FUNC&& func)
+        ->ThreadContextPtr<typename Traits::ChunkResults<decltype(coroResult(func))>::Type>;
+    
+    /// @brief Same as forEachChunk() but each chunk writes its output in place into the range starting at 'outFirst'.
+    /// @tparam OUTPUT_IT The type of the output iterator. Must meet the requirements of a RandomAccessIterator.
+    /// @tparam FUNC A function of type 'void(VoidContextPtr, INPUT_IT begin, INPUT_IT end, OUTPUT_IT out)' where
+    ///         'out' corresponds to 'begin' in the output range.
+    /// @return An int set to 0 once all chunks are processed.
+    /// @note The output range must hold at least std::distance(first, last) elements.
+    template <class INPUT_IT,
+              class OUTPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    ThreadContextPtr<int>
+    forEachChunk(INPUT_IT first, INPUT_IT last, size_t chunkSize, OUTPUT_IT outFirst, FUNC&& func);
+    
+    /// @brief Applies the given unary function to all the elements in the range [first,last) on the IO threads.
+    /// @details Use this function instead of forEach() when 'func' makes blocking calls (e.g. compression or legacy
+    ///          database clients) which would otherwise stall the coroutine threads. One worker is posted on each
+    ///          dedicated IO queue and workers claim chunks of the range from a shared counter, so the cost of
+    ///          tracking completion does not depend on the number of elements.
+    /// @tparam INPUT_IT The type of iterator. Must meet the requirements of a RandomAccessIterator.
+    /// @tparam FUNC A unary function of type 'RET(*INPUT_IT)'. RET may be void.
+    /// @param[in] first The first element in the range.
+    /// @param[in] last The last element in the range (exclusive).
+    /// @param[in] func The unary function.
+    /// @param[in] chunkSize The number of elements claimed at once by a worker. Set to 0 to create four chunks
+    ///                      per IO thread.
+    /// @return A vector of values (i.e. one per element in range order), or an int set to 0 if RET is void.
+    /// @note RET cannot be 'bool'. The returned future is set by a coroutine which waits for the IO workers.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto forEachAsyncIo(INPUT_IT first, INPUT_IT last, FUNC&& func, size_t chunkSize = 0)
+        ->ThreadContextPtr<typename Traits::ChunkResults<decltype(resultOf2(func))>::Type>;
+    
+    /// @brief Applies the given unary function to all the elements in the range [first,last) using
+    ///        adaptive work-stealing partitioning.
+    /// @details One worker coroutine is started on each coroutine thread covered by IQueue::QueueId::Any. The range is
+    ///          initially split equally between workers, each of which processes its share in small contiguous chunks.
+    ///          A worker which runs out of elements steals the second half of the largest remaining share, so the
+    ///          range is only subdivided when a thread would otherwise be idle.
+    /// @tparam INPUT_IT The type of iterator. Must meet the requirements of a RandomAccessIterator.
+    /// @tparam FUNC A unary function of type 'RET(VoidContextPtr, *INPUT_IT)'.
+    /// @param[in] first The first element in the range.
+    /// @param[in] last The last element in the range (exclusive).
+    /// @param[in] func The unary function.
+    /// @param[in] grainSize The maximum number of consecutive elements a worker processes before checking for
+    ///                      more work. Set to 0 to let the library choose.
+    /// @return A vector of future values corresponding to the output of 'func' on every element in the range.
+    /// @note The per-element cost is a single function call. Prefer this function over forEachBatch() if FUNC is
+    ///       CPU-bound and its cost varies between elements. RET must be default-constructible and cannot be 'bool'.
+    /// @warning The VoidContextPtr can be used to yield() or to post additional coroutines or IO tasks.
+    ///          However it should *not* be set and this will result in undefined behavior.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto parallelFor(INPUT_IT first, INPUT_IT last, FUNC&& func, size_t grainSize = 0)
+        ->ThreadContextPtr<std::vector<decltype(coroResult(func))>>;
+    
+    /// @brief Applies the given function to every cell of a 2-D range of rows x cols, split into cache-sized tiles.
+    /// @details The range is divided into tiles of tileRows x tileCols cells (smaller at the edges) which are
+    ///          enumerated along a Z-order curve. One worker coroutine is started on each coroutine thread covered by
+    ///          IQueue::QueueId::Any and initially receives a contiguous run of that order, i.e. a compact block of
+    ///          neighbouring tiles. Idle workers steal tiles from the busiest worker as in parallelFor().
+    /// @tparam FUNC A function of type 'void(VoidContextPtr, const Tile2D&)' which processes all the cells within
+    ///         the tile bounds. Any returned value is ignored.
+    /// @param[in] rows The number of rows.
+    /// @param[in] cols The number of columns.
+    /// @param[in] tileRows The number of rows per tile. Set to 0 to use TileGrid::DefaultTileSize.
+    /// @param[in] tileCols The number of columns per tile. Set to 0 to use TileGrid::DefaultTileSize.
+    /// @param[in] func The tile function.
+    /// @return A future which completes once all tiles are processed. Calling get() rethrows the first error thrown
+    ///         by 'func', in which case the remaining tiles are skipped.
+    /// @note Choose tile dimensions so that the data touched by one tile fits in the L1 or L2 cache.
+    /// @warning The VoidContextPtr can be used to yield() or to post additional coroutines or IO tasks.
+    ///          However it should *not* be set and this will result in undefined behavior.
+    template <class FUNC>
+    ThreadContextPtr<int> parallelFor2D(size_t rows, size_t cols, size_t tileRows, size_t tileCols, FUNC&& func);
+    
+    /// @brief Reduces the range [first,last) in parallel, similarly to std::reduce().
+    /// @details The range is recursively split in two halves, each half being reduced by a separate coroutine, until
+    ///          the size of a half drops below the grain size. Partial results are then combined in a tree.
+    /// @tparam INPUT_IT The type of iterator.
+    /// @tparam T The type of the reduced value.
+    /// @tparam FUNC An associative binary function of type 'T(const T&, const T&)'.
+    /// @param[in] first The first element in the range.
+    /// @param[in] last The last element in the range (exclusive).
+    /// @param[in] init The initial value, which is combined once with the result of the reduction.
+    /// @param[in] func The binary function.
+    /// @param[in] grainSize The number of elements below which a range is reduced serially. Set to 0 to let the
+    ///                      library choose.
+    /// @return A future to the reduced value.
+    /// @note FUNC may be called concurrently and in any grouping, but the order of elements is preserved.
+    ///       It is called from a coroutine and must not block.
+    template <class INPUT_IT,
+              class T,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    ThreadContextPtr<T>
+    reduce(INPUT_IT first, INPUT_IT last, T init, FUNC&& func, size_t grainSize = 0);
+    
+    /// @brief Applies a unary transform to every element in the range [first,last) and reduces the results in
+    ///        parallel, similarly to std::transform_reduce().
+    /// @tparam REDUCE_FUNC An associative binary function of type 'T(const T&, const T&)'.
+    /// @tparam TRANSFORM_FUNC A unary function of type 'T(const *INPUT_IT&)'.
+    /// @note See reduce() for details.
+    template <class INPUT_IT,
+              class T,
+              class REDUCE_FUNC,
+              class TRANSFORM_FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    ThreadContextPtr<T>
+    transformReduce(INPUT_IT first,
+                    INPUT_IT last,
+                    T init,
+                    REDUCE_FUNC&& reduceFunc,
+                    TRANSFORM_FUNC&& transformFunc,
+                    size_t grainSize = 0);
+    
+    /// @brief Computes the inclusive prefix sums of the range [first,last) in parallel, similarly to
+    ///        std::inclusive_scan().
+    /// @details The range is split in one chunk per coroutine thread. The chunks are first reduced in parallel, the
+    ///          chunk totals are then combined into a carry value for each chunk, and finally all the chunks are
+    ///          scanned in parallel starting from their carry.
+    /// @tparam FUNC An associative binary function of type 'T(const T&, const T&)' where T is the value
+    ///         type of INPUT_IT.
+    /// @return A future to a vector where the i-th element is the reduction of elements [0,i].
+    /// @note INPUT_IT must meet the requirements of a RandomAccessIterator. The value type must be
+    ///       default-constructible.
+    template <class INPUT_IT,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    ThreadContextPtr<std::vector<typename std::iterator_traits<INPUT_IT>::value_type>>
+    inclusiveScan(INPUT_IT first, INPUT_IT last, FUNC&& func);
+    
+    /// @brief Computes the exclusive prefix sums of the range [first,last) in parallel, similarly to
+    ///        std::exclusive_scan().
+    /// @return A future to a vector where the i-th element is the reduction of 'init' and elements [0,i).
+    /// @note See inclusiveScan() for details. T must be default-constructible.
+    template <class INPUT_IT,
+              class T,
+              class FUNC,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    ThreadContextPtr<std::vector<T>>
+    exclusiveScan(INPUT_IT first, INPUT_IT last, T init, FUNC&& func);
+    
+    /// @brief Sorts the range [first,last) in parallel.
+    /// @details The range is split in one chunk per coroutine thread and each chunk is sorted with std::sort().
+    ///          Pairs of sorted chunks are then merged until one is left. Each merge is divided in independent pieces
+    ///          by binary search so that all coroutine threads take part in every merge round.
+    /// @tparam RANDOM_IT The type of iterator. Must meet the requirements of a RandomAccessIterator.
+    /// @tparam COMPARE A comparison function object of type 'bool(const T&, const T&)'.
+    /// @param[in] first The first element in the range.
+    /// @param[in] last The last element in the range (exclusive).
+    /// @param[in] compare Returns true if the first argument is ordered before the second.
+    /// @return A future which is set to 0 once the range is sorted.
+    /// @note The value type must be default-constructible and move-assignable since the merge rounds use a
+    ///       temporary buffer of the same size as the range. Small ranges are sorted serially. The range must not be
+    ///       accessed until the future is ready and its order is unspecified if 'compare' throws.
+    template <class RANDOM_IT,
+              class COMPARE = std::less<typename std::iterator_traits<RANDOM_IT>::value_type>,
+              class = Traits::IsInputIterator<RANDOM_IT>>
+    ThreadContextPtr<int>
+    sort(RANDOM_IT first, RANDOM_IT last, COMPARE compare = COMPARE());
+    
+    /// @brief Same as sort() but the relative order of equivalent elements is preserved.
+    /// @note Chunks are sorted with std::stable_sort() and the merges are stable.
+    template <class RANDOM_IT,
+              class COMPARE = std::less<typename std::iterator_traits<RANDOM_IT>::value_type>,
+              class = Traits::IsInputIterator<RANDOM_IT>>
+    ThreadContextPtr<int>
+    stableSort(RANDOM_IT first, RANDOM_IT last, COMPARE compare = COMPARE());
+    
     /// @brief Implementation of map-reduce functionality.
     /// @tparam KEY The KEY type used for mapping and reducing.
     /// @tparam MAPPED_TYPE The output type after a map operation.
@@ -301,6 +541,116 @@ public:
                         MAPPER_FUNC mapper,
                         REDUCER_FUNC reducer)->
           ThreadContextPtr<std::map<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>;
+    
+    /// @brief Same as mapReduce() but with an optional combiner and a choice of output container.
+    /// @tparam COMBINER_FUNC The combiner function having the signature
+    ///         'MAPPED_TYPE(const KEY&, MAPPED_TYPE&&, MAPPED_TYPE&&)' or std::nullptr_t.
+    /// @tparam OUTPUT One of MapReduceOutput::Ordered, MapReduceOutput::Unordered or MapReduceOutput::Sorted.
+    /// @param[in] first The start iterator to a list of items to be processed in the range [first,last).
+    /// @param[in] last The end iterator to a list of items (not inclusive).
+    /// @param[in] mapper The mapper function.
+    /// @param[in] reducer The reducer function.
+    /// @param[in] combiner Merges two mapped values of the same key before they are shuffled between
+    ///            coroutine threads. This reduces the shuffle volume when many values share the same key.
+    ///            Pass nullptr if no combining is needed.
+    /// @param[in] output Tag selecting the returned container.
+    /// @return A future to the reduced values.
+    /// @note The mapped values are hash-partitioned between all coroutine threads which index and reduce
+    ///       them in parallel. Keys which are not hashable are processed in a single partition.
+    template <class MAPPER_FUNC,
+              class REDUCER_FUNC,
+              class COMBINER_FUNC,
+              class OUTPUT,
+              class INPUT_IT,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto mapReduce(INPUT_IT first,
+                   INPUT_IT last,
+                   MAPPER_FUNC mapper,
+                   REDUCER_FUNC reducer,
+                   COMBINER_FUNC combiner,
+                   OUTPUT output)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>;
+    
+    /// @brief Same as mapReduceBatch() but with an optional combiner and a choice of output container.
+    /// @note See mapReduce() above for details.
+    template <class MAPPER_FUNC,
+              class REDUCER_FUNC,
+              class COMBINER_FUNC,
+              class OUTPUT,
+              class INPUT_IT,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto mapReduceBatch(INPUT_IT first,
+                        INPUT_IT last,
+                        MAPPER_FUNC mapper,
+                        REDUCER_FUNC reducer,
+                        COMBINER_FUNC combiner,
+                        OUTPUT output)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>;
+    
+    /// @brief Same as mapReduce() but both the mapper and the reducer run on the IO threads.
+    /// @details The input is mapped in chunks claimed by one worker per dedicated IO queue (see forEachAsyncIo()).
+    ///          The mapped values are then hash-partitioned and each partition is reduced by a single IO worker.
+    /// @tparam MAPPER_FUNC The mapper function having the signature
+    ///         'std::vector<std::pair<KEY,MAPPED_TYPE>>(const INPUT_IT::value_type&)'.
+    /// @tparam REDUCER_FUNC The reducer function having the signature
+    ///         'std::pair<KEY,REDUCED_TYPE>(std::pair<KEY, std::vector<MAPPED_TYPE>>&&)'.
+    /// @tparam COMBINER_FUNC The combiner function having the signature
+    ///         'MAPPED_TYPE(const KEY&, MAPPED_TYPE&&, MAPPED_TYPE&&)' or std::nullptr_t.
+    /// @tparam OUTPUT One of MapReduceOutput::Ordered, MapReduceOutput::Unordered or MapReduceOutput::Sorted.
+    /// @tparam INPUT_IT The type of iterator. Must meet the requirements of a RandomAccessIterator.
+    /// @param[in] first The start iterator to a list of items to be processed in the range [first,last).
+    /// @param[in] last The end iterator to a list of items (not inclusive).
+    /// @param[in] mapper The mapper function.
+    /// @param[in] reducer The reducer function.
+    /// @param[in] combiner Merges two mapped values of the same key before they are shuffled. Pass nullptr if no
+    ///            combining is needed.
+    /// @param[in] output Tag selecting the returned container.
+    /// @param[in] chunkSize The number of elements mapped at once by a worker. Set to 0 to use the default.
+    /// @return A future to the reduced values.
+    template <class MAPPER_FUNC,
+              class REDUCER_FUNC,
+              class COMBINER_FUNC = std::nullptr_t,
+              class OUTPUT = MapReduceOutput::Ordered,
+              class INPUT_IT,
+              class = Traits::IsInputIterator<INPUT_IT>>
+    auto mapReduceAsyncIo(INPUT_IT first,
+                          INPUT_IT last,
+                          MAPPER_FUNC mapper,
+                          REDUCER_FUNC reducer,
+                          COMBINER_FUNC combiner = nullptr,
+                          OUTPUT output = OUTPUT(),
+                          size_t chunkSize = 0)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(reducedTypeOf(reducer))>>;
+    
+    /// @brief Streaming version of mapReduce() which consumes records from a buffered future as they arrive.
+    /// @details Records are mapped in batches on all coroutine threads and the mapped values are folded
+    ///          incrementally into per-key aggregates using the combiner. The final aggregates are emitted once the
+    ///          producer closes the buffer. Memory is bounded by the number of distinct keys instead of the
+    ///          number of records.
+    /// @tparam MAPPER_FUNC The mapper function having the signature
+    ///         'std::vector<std::pair<KEY,MAPPED_TYPE>>(VoidContextPtr, const T&)' where T is the buffered type.
+    /// @tparam COMBINER_FUNC The combiner function having the signature
+    ///         'MAPPED_TYPE(const KEY&, MAPPED_TYPE&&, MAPPED_TYPE&&)'. It must be associative.
+    /// @tparam OUTPUT One of MapReduceOutput::Ordered, MapReduceOutput::Unordered or MapReduceOutput::Sorted.
+    /// @tparam SOURCE A pointer to a buffered future or context which supports 'pull(ICoroSync::Ptr, bool&)' such as
+    ///         ThreadContextPtr<Buffer<T>>, CoroContextPtr<Buffer<T>> or CoroFuturePtr<Buffer<T>> (e.g. obtained
+    ///         from a Promise<Buffer<T>> used as a channel).
+    /// @param[in] source The buffered future to consume. It must not be pulled by anyone else.
+    /// @param[in] mapper The mapper function.
+    /// @param[in] combiner The combiner function which merges two mapped values of the same key.
+    /// @param[in] output Tag selecting the returned container.
+    /// @param[in] batchSize Number of records mapped together by a single coroutine. Set to 0 to use the default.
+    /// @return A future to the combined values of each key.
+    template <class MAPPER_FUNC,
+              class COMBINER_FUNC,
+              class OUTPUT = MapReduceOutput::Ordered,
+              class SOURCE>
+    auto mapReduceStream(SOURCE source,
+                         MAPPER_FUNC mapper,
+                         COMBINER_FUNC combiner,
+                         OUTPUT output = OUTPUT(),
+                         size_t batchSize = 0)->
+          ThreadContextPtr<typename OUTPUT::template Container<decltype(mappedKeyOf(mapper)), decltype(mappedTypeOf(mapper))>>;
 
     /// @brief Signal all threads to immediately terminate and exit. All other pending coroutines and IO tasks will not complete.
     ///        Call this function for a fast shutdown of the dispatcher.
@@ -366,6 +716,14 @@ public:
     /// @brief Resets all coroutine and IO queue counters.
     void resetStats();
     
+    /// @brief Takes a snapshot of every task held by the coroutine and IO queues, with its state, age, queue id,
+    ///        priority, continuation stage and tag, as well as per-state summaries.
+    /// @return The snapshot.
+    /// @note Each queue is only locked while its tasks are copied so this can be called periodically under load,
+    ///       e.g. from a diagnostics endpoint. The state of a coroutine is the one it had the last time it ran.
+    ///       A coroutine can tag itself with local::setTag().
+    DispatcherSnapshot snapshot() const;
+    
 private:
     template <class RET, class FUNC, class ... ARGS>
     ThreadContextPtr<RET>
@@ -375,6 +733,10 @@ private:
     ThreadFuturePtr<RET>
     postAsyncIoImpl(int queueId, bool isHighPriority, FUNC&& func, ARGS&&... args);
     
+    template <class RET, class FUNC, class ... ARGS>
+    ThreadFuturePtr<RET>
+    postLiteImpl(int queueId, bool isHighPriority, FUNC&& func, ARGS&&... args);
+    
     //Members
     DispatcherCore              _dispatcher;
     std::atomic_bool            _drain;
@@ -29,6 +29,7 @@
 #include <pthread.h>
 #endif
 #include <quantum/quantum_configuration.h>
+#include <quantum/quantum_coroutine_pool.h>
 #include <quantum/quantum_task_queue.h>
 #include <quantum/quantum_io_queue.h>
 
@@ -59,6 +60,8 @@ public:
     
     void resetStats();
     
+    DispatcherSnapshot snapshot() const;
+    
     void post(Task::Ptr task);
     
     void postAsyncIo(IoTask::Ptr task);
@@ -69,6 +72,8 @@ public:
 
     const std::pair<int, int>& getCoroQueueIdRangeForAny() const;
     
+    CoroutinePool* getCoroutinePool() const;
+    
 private:
     DispatcherCore(const Configuration& config);
     
@@ -84,7 +89,10 @@ private:
     
     QueueStatistics ioStats(int queueId);
     
+    void runWatchdog();
+    
     //Members
+    std::unique_ptr<CoroutinePool> _coroutinePool; // idle coroutines when reuse is enabled (destroyed last)
     std::shared_ptr<TaskQueue>  _sharedCoroAnyQueue; // shared coro queue for Any
     std::vector<TaskQueue>      _coroQueues;     //coroutine queues
     std::vector<IoQueue>        _sharedIoQueues; //shared IO task queues (hold tasks posted to 'Any' IO queue)
@@ -92,6 +100,11 @@ private:
     bool                        _loadBalanceSharedIoQueues; //tasks posted to 'Any' IO queue are load balanced
     std::atomic_bool            _terminated;
     std::pair<int, int>         _coroQueueIdRangeForAny; // range of coroutine queueIds covered by 'Any' 
+    std::chrono::milliseconds   _watchdogThreshold;
+    Configuration::WatchdogCallback _watchdogCallback;
+    std::mutex                  _watchdogMutex;  //for accessing the condition variable
+    std::condition_variable     _watchdogCond;   //signaled on termination
+    std::thread                 _watchdog;       //samples the coroutine threads for long-running slices
 };
 
 }}
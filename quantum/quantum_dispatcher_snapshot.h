@@ -0,0 +1,115 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_DISPATCHER_SNAPSHOT_H
+#define BLOOMBERG_QUANTUM_DISPATCHER_SNAPSHOT_H
+
+#include <quantum/interface/quantum_iqueue.h>
+#include <quantum/interface/quantum_itask.h>
+#include <quantum/quantum_histogram.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                      struct TaskSnapshot
+//==============================================================================================
+/// @struct TaskSnapshot.
+/// @brief State of a single task at the time a DispatcherSnapshot was taken.
+struct TaskSnapshot
+{
+    enum class State : int
+    {
+        NotStarted,     ///< Queued but never run. Always the case for IO tasks.
+        Running,        ///< Currently running on a thread
+        Runnable,       ///< Yielded and ready to be resumed
+        Blocked,        ///< Yielded while waiting on a future, mutex or condition
+        Sleeping,       ///< Yielded while sleeping
+        Completed,      ///< Finished and about to be removed from its queue
+        Max
+    };
+
+    uint64_t                    _taskId;        ///< Same id as reported by the Tracer and the watchdog
+    int                         _queueId;       ///< Queue holding the task. IQueue::QueueId::Any for shared queues.
+    IQueue::QueueType           _queueType;     ///< Coro or IO
+    ITask::Type                 _type;          ///< Continuation stage of the task
+    State                       _state;         ///< State as of the last time the task ran
+    bool                        _isHighPriority;
+    std::chrono::nanoseconds    _age;           ///< Time since the task was created
+    const char*                 _tag;           ///< Tag set via local::setTag() or null. Has static storage duration.
+};
+
+//==============================================================================================
+//                                   class DispatcherSnapshot
+//==============================================================================================
+/// @class DispatcherSnapshot.
+/// @brief Point-in-time view of all the tasks held by the dispatcher queues. Returned by Dispatcher::snapshot().
+/// @details Each queue is walked under its own lock, so the snapshot is consistent per queue but not across
+///          queues. Tasks which were dequeued by an IO thread and are currently running are not included.
+class DispatcherSnapshot
+{
+public:
+    using State = TaskSnapshot::State;
+
+    /// @brief Gets all the tasks, grouped by queue.
+    const std::vector<TaskSnapshot>& getTasks() const;
+
+    /// @brief Gets the number of tasks in a given state.
+    size_t getCount(State state) const;
+
+    /// @brief Gets the age distribution of the tasks in a given state, in nanoseconds.
+    const Histogram& getAgeHistogram(State state) const;
+
+    /// @brief Gets the steady clock time at which the snapshot was taken.
+    std::chrono::steady_clock::time_point getTime() const;
+
+    /// @brief Prints the per-state summary followed by one line per task.
+    /// @param[in,out] out Output stream.
+    void print(std::ostream& out) const;
+
+    /// @brief Gets the name of a state.
+    static const char* nameOf(State state);
+
+private:
+    friend class TaskQueue;
+    friend class IoQueue;
+    friend class DispatcherCore;
+
+    DispatcherSnapshot();
+    //Queues call add() while holding their locks, so it only appends to storage reserved beforehand.
+    //The per-state counts and histograms are built by summarize() once all the locks are released.
+    void reserve(size_t num);
+    void add(const TaskSnapshot& task);
+    void summarize();
+
+    std::chrono::steady_clock::time_point           _time;
+    std::vector<TaskSnapshot>                       _tasks;
+    std::array<size_t, (size_t)State::Max>          _counts;
+    std::array<Histogram, (size_t)State::Max>       _ages;
+};
+
+/// @brief Overloads stream operator for DispatcherSnapshot objects.
+std::ostream& operator<<(std::ostream& out, const DispatcherSnapshot& snapshot);
+
+}}
+
+#include <quantum/impl/quantum_dispatcher_snapshot_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_DISPATCHER_SNAPSHOT_H
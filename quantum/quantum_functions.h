@@ -42,6 +42,18 @@ struct Functions
     template <class KEY, class MAPPED_TYPE, class REDUCED_TYPE>
     using ReduceFunc = std::function<std::pair<KEY, REDUCED_TYPE>(VoidContextPtr,
                                                                   std::pair<KEY, std::vector<MAPPED_TYPE>>&&)>;
+    
+    template <class KEY, class MAPPED_TYPE, class INPUT_IT>
+    using IoMapFunc = std::function<std::vector<std::pair<KEY, MAPPED_TYPE>>(const typename std::iterator_traits<INPUT_IT>::value_type&)>;
+    
+    template <class KEY, class MAPPED_TYPE, class REDUCED_TYPE>
+    using IoReduceFunc = std::function<std::pair<KEY, REDUCED_TYPE>(std::pair<KEY, std::vector<MAPPED_TYPE>>&&)>;
+    
+    template <class KEY, class MAPPED_TYPE, class RECORD>
+    using StreamMapFunc = std::function<std::vector<std::pair<KEY, MAPPED_TYPE>>(VoidContextPtr, const RECORD&)>;
+    
+    template <class KEY, class MAPPED_TYPE>
+    using CombineFunc = std::function<MAPPED_TYPE(const KEY&, MAPPED_TYPE&&, MAPPED_TYPE&&)>;
 };
 
 }}
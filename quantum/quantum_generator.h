@@ -0,0 +1,158 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_GENERATOR_H
+#define BLOOMBERG_QUANTUM_GENERATOR_H
+
+#include <quantum/quantum_allocator.h>
+#include <quantum/quantum_traits.h>
+#include <assert.h>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                      class Generator
+//==============================================================================================
+/// @class Generator.
+/// @brief Lazy sequence of values produced by a function running on its own stack.
+/// @details The producer function receives a Generator<T>::Yield object as its first argument and hands out
+///          values one at a time by calling it. Each call suspends the producer until the consumer asks for the
+///          next value, at which point the producer resumes where it left off. Producer and consumer run on the
+///          same thread and the consumer reads each value in place on the producer's stack, so values are
+///          neither copied, locked nor allocated, contrary to streaming through a Promise<Buffer<T>>.
+///          The producer does not run until the first value is requested.
+/// @tparam T The type of the values produced.
+/// @note The generator stack comes from the same allocator as coroutine stacks. A generator may be consumed from
+///       inside a coroutine, but the producer must not yield, sleep or wait on the coroutine context since it
+///       runs on a different stack. Producer exceptions are rethrown to the consumer when it requests the next value.
+/// @code
+///       Generator<int> squares([](Generator<int>::Yield& yield, int max) {
+///           for (int i = 1; i <= max; ++i) yield(i * i);
+///       }, 10);
+///       for (int& value : squares) { ... }
+/// @endcode
+template <class T>
+class Generator
+{
+    using BoostCoro = boost::coroutines2::coroutine<T*>;
+    using Pull = typename BoostCoro::pull_type;
+    using Push = typename BoostCoro::push_type;
+public:
+    using ValueType = T;
+
+    //==============================================================================================
+    //                                      class Yield
+    //==============================================================================================
+    /// @class Yield.
+    /// @brief Handle used by the producer to hand out values.
+    class Yield
+    {
+    public:
+        /// @brief Hands out a value and suspends the producer until the next value is requested.
+        /// @param[in] value The value. The consumer may modify or move from it.
+        void operator()(T& value);
+
+        /// @brief Hands out a temporary value. See above.
+        void operator()(T&& value);
+
+        /// @brief Hands out a copy of a read-only value. See above.
+        void operator()(const T& value);
+
+    private:
+        friend class Generator<T>;
+        explicit Yield(Push& push);
+
+        Push& _push;
+    };
+
+    //==============================================================================================
+    //                                      class Iterator
+    //==============================================================================================
+    /// @class Iterator.
+    /// @brief Input iterator over the generated values. Advancing it resumes the producer.
+    class Iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const;
+        Iterator& operator++();
+        void operator++(int);
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+
+    private:
+        friend class Generator<T>;
+        explicit Iterator(Generator<T>* generator);
+
+        Generator<T>* _generator{nullptr};
+    };
+
+    /// @brief Constructor.
+    /// @param[in] func The producer function. Must have the signature 'void(Generator<T>::Yield&, ARGS...)'.
+    /// @param[in] args Arguments passed to the producer after the Yield handle. They are copied or moved into
+    ///                 the generator.
+    template <class FUNC, class ... ARGS>
+    explicit Generator(FUNC&& func, ARGS&&... args);
+
+    Generator(const Generator& other) = delete;
+    Generator(Generator&& other) = default;
+    Generator& operator=(const Generator& other) = delete;
+    Generator& operator=(Generator&& other) = default;
+
+    /// @brief Resumes the producer until it hands out its next value or returns.
+    /// @return True if a new value is available via value(), false if the producer has returned.
+    /// @note If the producer throws, the exception is propagated to the caller.
+    bool next();
+
+    /// @brief Get the value produced by the last successful call to next().
+    /// @return A reference to the value, valid until the producer is resumed.
+    T& value() const;
+
+    /// @brief Checks if the producer has returned.
+    /// @return True if done, false otherwise.
+    bool done() const;
+
+    /// @brief Resumes the producer and returns an iterator to the value it hands out.
+    /// @return The iterator, or end() if the producer returned without handing out any more values.
+    /// @note Since each value is only produced once, begin() should only be called once per generator.
+    Iterator begin();
+
+    /// @brief Get the iterator past the last value.
+    /// @return The iterator.
+    Iterator end();
+
+private:
+    Pull    _pull;
+    T*      _value{nullptr};
+};
+
+}}
+
+#include <quantum/impl/quantum_generator_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_GENERATOR_H
@@ -0,0 +1,95 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_HISTOGRAM_H
+#define BLOOMBERG_QUANTUM_HISTOGRAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                       class Histogram
+//==============================================================================================
+/// @class Histogram.
+/// @brief Log-linear histogram of unsigned values in the style of HdrHistogram.
+/// @details Values below 16 have their own bucket. Every power-of-two range above that is split into 16 linear
+///          sub-buckets, so any value is known to within 1/16th (~6%) of its magnitude over the whole 64-bit range
+///          with a fixed memory footprint. Recording a value is wait-free and safe from multiple threads.
+class Histogram
+{
+public:
+    static constexpr size_t numSubBuckets = 16;
+    static constexpr size_t numBuckets = numSubBuckets * 61;
+    
+    Histogram();
+    Histogram(const Histogram& other);
+    Histogram& operator=(const Histogram& other);
+    
+    /// @brief Adds a value to the histogram.
+    void record(uint64_t value);
+    
+    /// @brief Removes all the recorded values.
+    void reset();
+    
+    /// @brief Gets the number of recorded values.
+    size_t count() const;
+    
+    /// @brief Gets the smallest recorded value or 0 if the histogram is empty.
+    uint64_t min() const;
+    
+    /// @brief Gets the largest recorded value.
+    uint64_t max() const;
+    
+    /// @brief Gets the exact mean of all recorded values.
+    double mean() const;
+    
+    /// @brief Gets the value below which the given percentage of the recorded values fall.
+    /// @param[in] percent A value in the range [0, 100].
+    /// @return The highest value equivalent to the bucket containing the percentile, capped at max().
+    uint64_t percentile(double percent) const;
+    
+    /// @brief Merges the values recorded in another histogram into this one.
+    Histogram& operator+=(const Histogram& rhs);
+    
+    /// @brief Prints the count, mean, max and main percentiles.
+    /// @param[in,out] out Output stream.
+    void print(std::ostream& out) const;
+    
+private:
+    static size_t bucketOf(uint64_t value);
+    static uint64_t highestValueOf(size_t bucket);
+    
+    std::atomic<uint64_t>   _buckets[numBuckets];
+    std::atomic<uint64_t>   _count;
+    std::atomic<uint64_t>   _sum;
+    std::atomic<uint64_t>   _min;
+    std::atomic<uint64_t>   _max;
+};
+
+/// @brief Overloads stream operator for Histogram object
+/// @param[in] out Output stream.
+/// @param[in] histogram Histogram object to stream.
+/// @return Reference to the same input stream.
+std::ostream& operator<<(std::ostream& out, const Histogram& histogram);
+
+}}
+
+#include <quantum/impl/quantum_histogram_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_HISTOGRAM_H
@@ -40,7 +40,7 @@ namespace quantum {
 class IoQueue : public IQueue
 {
 public:
-    using TaskList = std::list<IoTask::Ptr, IoQueueListAllocator>;
+    using TaskList = std::list<IoTask::Ptr, std::allocator_traits<IoQueueListAllocator>::rebind_alloc<IoTask::Ptr>>;
     using TaskListIter = TaskList::iterator;
     
     IoQueue();
@@ -82,6 +82,11 @@ public:
     
     const std::shared_ptr<std::thread>& getThread() const final;
     
+    /// @brief Adds all the pending IO tasks held by this queue to a snapshot.
+    /// @param[in,out] snapshot The snapshot.
+    /// @param[in] queueId The id reported for this queue.
+    void snapshot(DispatcherSnapshot& snapshot, int queueId) const;
+    
 private:
     ITask::Ptr grabWorkItem();
     ITask::Ptr grabWorkItemFromAll();
@@ -99,7 +104,7 @@ private:
     size_t                          _loadBalanceBackoffNum;
     std::shared_ptr<std::thread>    _thread;
     TaskList                        _queue;
-    mutable SpinLock                _spinlock;
+    mutable SpinLock                _spinlock{"IoQueue"};
     std::mutex                      _notEmptyMutex; //for accessing the condition variable
     std::condition_variable         _notEmptyCond;
     std::atomic_bool                _isEmpty;
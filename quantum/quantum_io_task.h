@@ -16,11 +16,16 @@
 #ifndef BLOOMBERG_QUANTUM_IO_TASK_H
 #define BLOOMBERG_QUANTUM_IO_TASK_H
 
+#include <chrono>
 #include <functional>
 #include <quantum/interface/quantum_itask.h>
 #include <quantum/quantum_capture.h>
 #include <quantum/quantum_promise.h>
+#include <quantum/quantum_tracer.h>
 #include <quantum/util/quantum_util.h>
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+#include <quantum/quantum_task_timing.h>
+#endif
 
 namespace Bloomberg {
 namespace quantum {
@@ -73,6 +78,16 @@ public:
     bool isHighPriority() const final;
     bool isSuspended() const final;
     
+    //Tracing
+    uint64_t getTraceId();
+    
+    //Introspection
+    std::chrono::steady_clock::time_point getCreationTime() const;
+    
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    TaskTiming& getTiming();
+#endif
+    
     //===================================
     //           NEW / DELETE
     //===================================
@@ -85,6 +100,11 @@ private:
     std::atomic_bool        _terminated;
     int                     _queueId;
     bool                    _isHighPriority;
+    std::atomic<uint64_t>   _traceId{0}; //assigned on first use by the Tracer
+    std::chrono::steady_clock::time_point _creationTime{std::chrono::steady_clock::now()};
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    TaskTiming              _timing;
+#endif
 };
 
 using IoTaskPtr = IoTask::Ptr;
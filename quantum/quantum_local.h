@@ -17,12 +17,47 @@
 #define BLOOMBERG_QUANTUM_LOCAL_H
 
 #include <quantum/quantum_traits.h>
+#include <quantum/quantum_coro_local_storage.h>
 #include <string>
 
 namespace Bloomberg {
 namespace quantum {
 namespace local {
 
+using Slot = CoroLocalStorage::Slot;
+
+/// @brief Returns the slot of a named coro-local-variable, registering it on first use.
+/// @param[in] name the variable name
+/// @return the slot index, which is the same for all the calls with the same name
+/// @note Slots are process-wide and never released. Registering a slot once, typically in a
+///       static variable, and accessing the variable by slot avoids hashing the name on each access.
+Slot registerSlot(const std::string& name);
+
+/// @brief Registers a new anonymous coro-local-variable slot.
+/// @return the slot index
+Slot registerSlot();
+
+/// @brief Accesses the pointer to a coro-local-variable by slot
+/// @param[in] slot the variable slot as returned by registerSlot()
+/// @return the pointer to the coro-local-variable in @see slot
+/// @note Same semantics as variable(const std::string&). Slots below
+///       __QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS never allocate.
+template <typename T>
+T*& variable(Slot slot);
+
+/// @brief Reads a coro-local-variable by slot
+/// @param[in] slot the variable slot as returned by registerSlot()
+/// @return the pointer to the coro-local-variable or nullptr if it was never set in the current
+///         coroutine (or thread if called outside of a coroutine)
+template <typename T>
+T* get(Slot slot);
+
+/// @brief Sets a coro-local-variable by slot
+/// @param[in] slot the variable slot as returned by registerSlot()
+/// @param[in] value the pointer to store
+template <typename T>
+void set(Slot slot, T* value);
+
 /// @brief Accesses the pointer to a coro-local-variable
 /// @param[in] key the variable name
 /// @return the pointer to the coro-local-variable with the name @see key
@@ -36,6 +71,11 @@ namespace local {
 /// @note Upon the termination of the coroutine, the storage occupied by the coro-local-variable
 ///       pointers will be freed. It is up to the user of the API to free the actual variable
 ///       storage.
+/// @note If @see key was registered via registerSlot(), this is equivalent to variable(slot). Otherwise the
+///       variable is kept in a per-coroutine map which is freed with the coroutine, so arbitrary keys do not
+///       grow the process-wide registry. Register a name before any coroutine uses it, since a variable
+///       created under an unregistered name is not visible through the slot registered later.
+///       Prefer the slot API on hot paths.
 template <typename T>
 T*& variable(const std::string& key);
 
@@ -43,6 +83,14 @@ T*& variable(const std::string& key);
 /// @return The coroutine context if this function is called inside a coroutine or null otherwise
 VoidContextPtr context();
 
+/// @brief Tags the current coroutine. The tag is reported by Dispatcher::snapshot().
+/// @param[in] tag A string with static storage duration, i.e. a string literal or a 'static const char*'.
+///                Pass null to clear the tag.
+/// @note Has no effect if called outside of a coroutine.
+/// @warning Snapshots keep the pointer and are typically printed after the coroutine has finished, hence the
+///          tag must never point to a buffer which may be freed or reused, e.g. std::string::c_str().
+void setTag(const char* tag);
+
 }}}
 
 #include <quantum/impl/quantum_local_impl.h>
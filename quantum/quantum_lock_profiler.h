@@ -0,0 +1,132 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_LOCK_PROFILER_H
+#define BLOOMBERG_QUANTUM_LOCK_PROFILER_H
+
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+
+#include <quantum/quantum_histogram.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                       class LockProfile
+//==============================================================================================
+/// @class LockProfile.
+/// @brief Usage counters shared by all the locks registered under the same name.
+/// @details Only compiled in when __QUANTUM_ENABLE_LOCK_PROFILING is defined. All counters are updated with relaxed
+///          atomics and can be read at any time.
+class LockProfile
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Number of times a lock was acquired, including successful try-locks.
+    size_t acquisitions() const;
+
+    /// @brief Number of acquisitions which found the lock already held and had to wait.
+    size_t contendedAcquisitions() const;
+
+    /// @brief Total number of busy-wait iterations of spinlocks.
+    size_t spinCount() const;
+
+    /// @brief Total number of thread or coroutine yields made by mutexes while waiting.
+    size_t yieldCount() const;
+
+    /// @brief Time between acquiring and releasing an exclusive lock, in nanoseconds. Shared (read) locks of a
+    ///        ReadWriteSpinLock are counted but not timed.
+    const Histogram& holdTime() const;
+
+    /// @brief Resets all the counters to 0.
+    void reset();
+
+    /// @brief Prints the counters on a single line.
+    /// @param[in,out] out Output stream.
+    void print(std::ostream& out) const;
+
+    /// @brief Records a successful acquisition.
+    /// @note For internal use only.
+    void onAcquire(size_t numSpins, size_t numYields);
+
+    /// @brief Records the release of a lock acquired at time 'acquireTime'.
+    /// @note For internal use only.
+    void onRelease(Clock::time_point acquireTime);
+
+private:
+    std::atomic_size_t  _acquisitions{0};
+    std::atomic_size_t  _contendedAcquisitions{0};
+    std::atomic_size_t  _spinCount{0};
+    std::atomic_size_t  _yieldCount{0};
+    Histogram           _holdTime;
+};
+
+//==============================================================================================
+//                                       class LockProfiler
+//==============================================================================================
+/// @class LockProfiler.
+/// @brief Global registry of LockProfile objects indexed by lock name.
+/// @details Only compiled in when __QUANTUM_ENABLE_LOCK_PROFILING is defined. SpinLock, ReadWriteSpinLock and Mutex
+///          objects constructed with a name report to the profile of that name, while unnamed locks are not
+///          profiled. The internal queue, pool and condition variable locks are named after their owning class.
+/// @code
+///    Mutex cacheMutex("MyCache");
+///    ... run the workload ...
+///    LockProfiler::print(std::cout);
+/// @endcode
+class LockProfiler
+{
+public:
+    using ProfileMap = std::map<std::string, const LockProfile*>;
+
+    /// @brief Gets the profile registered under a name, creating it if needed.
+    /// @param[in] name The lock name.
+    /// @return The profile. Profiles are never deallocated so they can be used by locks with static lifetime.
+    static LockProfile& get(const std::string& name);
+
+    /// @brief Gets all the registered profiles.
+    static ProfileMap getProfiles();
+
+    /// @brief Resets the counters of all the registered profiles.
+    static void reset();
+
+    /// @brief Prints all the registered profiles, one per line.
+    /// @param[in,out] out Output stream.
+    static void print(std::ostream& out);
+
+private:
+    struct Registry
+    {
+        std::mutex                                          _mutex;
+        std::map<std::string, std::unique_ptr<LockProfile>> _profiles;
+    };
+    static Registry& registry();
+};
+
+}}
+
+#include <quantum/impl/quantum_lock_profiler_impl.h>
+
+#endif //__QUANTUM_ENABLE_LOCK_PROFILING
+
+#endif //BLOOMBERG_QUANTUM_LOCK_PROFILER_H
@@ -24,4 +24,8 @@
     #define DEPRECATED
 #endif
 
+#ifndef __QUANTUM_CACHE_LINE_SIZE
+    #define __QUANTUM_CACHE_LINE_SIZE 64
+#endif
+
 #endif //BLOOMBERG_QUANTUM_MACROS_H
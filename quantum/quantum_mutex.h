@@ -19,6 +19,7 @@
 #include <atomic>
 #include <quantum/quantum_traits.h>
 #include <quantum/quantum_spinlock.h>
+#include <quantum/quantum_deadlock_detector.h>
 #include <quantum/interface/quantum_icontext.h>
 #include <quantum/quantum_yielding_thread.h>
 
@@ -40,6 +41,12 @@ public:
     /// @note Mutex object is in unlocked state.
     Mutex();
     
+    /// @brief Constructor.
+    /// @param[in] name Name under which this mutex is profiled when __QUANTUM_ENABLE_LOCK_PROFILING is defined.
+    ///                 Ignored otherwise. See LockProfiler for more details.
+    /// @note Mutex object is in unlocked state.
+    explicit Mutex(const char* name);
+    
     Mutex(const Mutex& other) = delete;
     Mutex& operator=(const Mutex& other) = delete;
     
@@ -140,9 +147,14 @@ public:
     
 private:
     void lockImpl(ICoroSync::Ptr sync);
+    void onLocked(size_t numYields);
     
     //Members
     mutable SpinLock  _spinlock;
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    LockProfile*                    _profile{nullptr};
+    LockProfile::Clock::time_point  _acquireTime; //only accessed by the owner
+#endif
 };
 
 }}
@@ -17,6 +17,7 @@
 #define BLOOMBERG_QUANTUM_QUEUE_STATISTICS_H
 
 #include <quantum/interface/quantum_iqueue_statistics.h>
+#include <quantum/quantum_macros.h>
 #include <atomic>
 
 namespace Bloomberg {
@@ -27,6 +28,10 @@ namespace quantum {
 //==============================================================================================
 /// @class QueueStatistics.
 /// @brief Provides various counters related to queues and task execution.
+/// @details The event counters are updated by both the posting threads and the thread running the queue. To avoid
+///          contention they are split into shards, each on its own cache line, and each thread always updates the
+///          same shard using relaxed atomics. Reading a counter sums all the shards. The queue size is a single
+///          atomic isolated on its own cache line.
 /// @note See IQueueStatistics for detailed description.
 class QueueStatistics : public IQueueStatistics
 {
@@ -72,6 +77,21 @@ public:
     
     void incHighPriorityCount() final;
     
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    const Histogram& queueWaitTime() const final;
+    
+    const Histogram& executionTime() const final;
+    
+    const Histogram& totalTime() const final;
+    
+    const Histogram& resumeCount() const final;
+    
+    void recordTaskTiming(std::chrono::nanoseconds queueWaitTime,
+                          std::chrono::nanoseconds executionTime,
+                          std::chrono::nanoseconds totalTime,
+                          size_t resumeCount) final;
+#endif
+    
     void print(std::ostream& out) const final;
     
     QueueStatistics& operator+=(const IQueueStatistics& rhs);
@@ -79,14 +99,36 @@ public:
     friend QueueStatistics operator+(QueueStatistics lhs,
                                      const IQueueStatistics& rhs);
 
+    /// @brief Number of cache-line sized counter blocks shared by the updating threads.
+    static constexpr size_t numShards = 16;
+    
 private:
+    struct Shard
+    {
+        std::atomic_size_t  _errorCount{0};
+        std::atomic_size_t  _sharedQueueErrorCount{0};
+        std::atomic_size_t  _completedCount{0};
+        std::atomic_size_t  _sharedQueueCompletedCount{0};
+        std::atomic_size_t  _postedCount{0};
+        std::atomic_size_t  _highPriorityCount{0};
+        char                _padding[__QUANTUM_CACHE_LINE_SIZE]; //avoid false sharing between threads
+    };
+    
+    static size_t shardIndex();
+    Shard& localShard();
+    size_t sum(std::atomic_size_t Shard::* counter) const;
+    static void increment(std::atomic_size_t& counter, size_t value = 1);
+    
+    char                _padding[__QUANTUM_CACHE_LINE_SIZE]; //isolate from the members of the owning queue
     std::atomic_size_t  _numElements;
-    size_t      _errorCount;
-    size_t      _sharedQueueErrorCount;
-    size_t      _completedCount;
-    size_t      _sharedQueueCompletedCount;
-    size_t      _postedCount;
-    size_t      _highPriorityCount;
+    char                _numElementsPadding[__QUANTUM_CACHE_LINE_SIZE];
+    Shard               _shards[numShards];
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    Histogram   _queueWaitTime;
+    Histogram   _executionTime;
+    Histogram   _totalTime;
+    Histogram   _resumeCount;
+#endif
 };
 
 }}
@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <quantum/quantum_lock_profiler.h>
 
 namespace Bloomberg {
 namespace quantum {
@@ -30,6 +31,11 @@ public:
     /// @brief Constructor. The object is in the unlocked state.
     ReadWriteSpinLock() = default;
     
+    /// @brief Constructor. The object is in the unlocked state.
+    /// @param[in] name Name under which this lock is profiled when __QUANTUM_ENABLE_LOCK_PROFILING is defined.
+    ///                 Ignored otherwise. Only write locks are timed. See LockProfiler for more details.
+    explicit ReadWriteSpinLock(const char* name);
+    
     /// @brief Copy constructor.
     ReadWriteSpinLock(const ReadWriteSpinLock&) = delete;
     
@@ -148,6 +154,10 @@ public:
     
 private:
     std::atomic_int     _count{0};
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    LockProfile*                    _profile{nullptr};
+    LockProfile::Clock::time_point  _acquireTime; //only accessed by the writer
+#endif
 };
 
 }
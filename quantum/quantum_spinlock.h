@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <quantum/quantum_lock_profiler.h>
 
 namespace Bloomberg {
 namespace quantum {
@@ -36,6 +37,11 @@ public:
     /// @brief Constructor. The object is in the unlocked state.
     SpinLock();
     
+    /// @brief Constructor. The object is in the unlocked state.
+    /// @param[in] name Name under which this lock is profiled when __QUANTUM_ENABLE_LOCK_PROFILING is defined.
+    ///                 Ignored otherwise. See LockProfiler for more details.
+    explicit SpinLock(const char* name);
+    
     /// @brief Copy constructor.
     SpinLock(const SpinLock&) = delete;
     
@@ -123,6 +129,10 @@ public:
     
 private:
     std::atomic_flag 	_flag;
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+    LockProfile*                    _profile{nullptr};
+    LockProfile::Clock::time_point  _acquireTime; //only accessed by the owner
+#endif
 };
 
 }}
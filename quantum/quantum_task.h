@@ -21,13 +21,21 @@
 #include <list>
 #include <utility>
 #include <unordered_map>
+#include <boost/optional.hpp>
 #include <quantum/interface/quantum_iterminate.h>
 #include <quantum/interface/quantum_icontext.h>
 #include <quantum/interface/quantum_iqueue.h>
 #include <quantum/interface/quantum_itask_continuation.h>
 #include <quantum/interface/quantum_itask_accessor.h>
 #include <quantum/quantum_traits.h>
+#include <quantum/quantum_tracer.h>
+#include <quantum/quantum_dispatcher_snapshot.h>
+#include <quantum/quantum_coro_local_storage.h>
+#include <quantum/quantum_coroutine_pool.h>
 #include <quantum/util/quantum_util.h>
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+#include <quantum/quantum_task_timing.h>
+#endif
 
 namespace Bloomberg {
 namespace quantum {
@@ -37,6 +45,10 @@ namespace quantum {
 //==============================================================================================
 /// @class Task.
 /// @brief Runnable object representing a coroutine.
+/// @details Tasks constructed with a promise instead of a context are run-to-completion tasks. These
+///          have no coroutine, stack or context and run their function on the coroutine thread in one go.
+///          When a coroutine pool is supplied, the task body runs on a pooled coroutine which is handed back to
+///          the pool once the body returns, instead of on a coroutine of its own.
 /// @note For internal use only.
 class Task : public ITaskContinuation,
              public std::enable_shared_from_this<Task>
@@ -47,11 +59,12 @@ public:
     
     enum class State : int { Running, Suspended, Terminated };
 
-    using CoroLocalStorage = std::unordered_map<std::string, void*>;
+    using CoroLocalStorage = quantum::CoroLocalStorage;
     
     template <class RET, class FUNC, class ... ARGS>
     Task(std::false_type t,
          std::shared_ptr<Context<RET>> ctx,
+         CoroutinePool* coroPool,
          int queueId,
          bool isHighPriority,
          ITask::Type type,
@@ -61,12 +74,29 @@ public:
     template <class RET, class FUNC, class ... ARGS>
     Task(std::true_type t,
          std::shared_ptr<Context<RET>> ctx,
+         CoroutinePool* coroPool,
          int queueId,
          bool isHighPriority,
          ITask::Type type,
          FUNC&& func,
          ARGS&&... args);
     
+    template <class RET, class FUNC, class ... ARGS>
+    Task(std::true_type t,
+         std::shared_ptr<Promise<RET>> promise,
+         int queueId,
+         bool isHighPriority,
+         FUNC&& func,
+         ARGS&&... args);
+    
+    template <class RET, class FUNC, class ... ARGS>
+    Task(std::false_type t,
+         std::shared_ptr<Promise<RET>> promise,
+         int queueId,
+         bool isHighPriority,
+         FUNC&& func,
+         ARGS&&... args);
+    
     Task(const Task& task) = delete;
     Task(Task&& task) = default;
     Task& operator=(const Task& task) = delete;
@@ -101,6 +131,19 @@ public:
     //Local storage accessors
     CoroLocalStorage& getCoroLocalStorage();
     ITaskAccessor::Ptr getTaskAccessor() const;
+    
+    //Tracing
+    uint64_t getTraceId();
+    
+    //Introspection
+    TaskSnapshot::State getState() const;
+    std::chrono::steady_clock::time_point getCreationTime() const;
+    void setTag(const char* tag); //tag must have static storage duration, see local::setTag()
+    const char* getTag() const;
+    
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    TaskTiming& getTiming();
+#endif
 
     //===================================
     //           NEW / DELETE
@@ -119,18 +162,18 @@ private:
             int suspended = (int)State::Suspended;
             _isLocked = _suspendedState.compare_exchange_strong(suspended,
                                                                 (int)State::Running,
-                                                                std::memory_order::memory_order_acq_rel);
+                                                                std::memory_order_acq_rel);
         }
         ~SuspensionGuard()
         {
             if (_isLocked)
             {
-                _suspendedState.store((int)State::Suspended, std::memory_order::memory_order_acq_rel);
+                _suspendedState.store((int)State::Suspended, std::memory_order_release);
             }
         }
         void set(int newState)
         {
-            _suspendedState.store(newState, std::memory_order::memory_order_acq_rel);
+            _suspendedState.store(newState, std::memory_order_release);
             _isLocked = false;
         }
                
@@ -143,8 +186,14 @@ private:
         std::atomic_int& _suspendedState;
     };
     
+    bool isCallable() const;
+    
     ITaskAccessor::Ptr          _coroContext; //holds execution context
-    Traits::Coroutine           _coro; //the current runnable coroutine
+    boost::optional<Traits::Coroutine> _coro; //the current runnable coroutine
+    CoroutinePool*              _coroPool{nullptr}; //pool from which _pooledCoro is acquired on the first run
+    boost::optional<PooledCoroutine::Work> _pooledWork; //task body waiting for a pooled coroutine
+    CoroutinePool::Handle       _pooledCoro; //runs the task instead of _coro when coroutines are reused
+    std::unique_ptr<Function<int()>> _func; //run-to-completion function when there is no coroutine
     int                         _queueId;
     bool                        _isHighPriority;
     ITaskContinuation::Ptr      _next; //Task scheduled to run after current completes.
@@ -153,6 +202,13 @@ private:
     std::atomic_bool            _terminated;
     std::atomic_int             _suspendedState; // stores values of State
     CoroLocalStorage            _coroLocalStorage; // local storage of the coroutine
+    std::atomic<uint64_t>       _traceId{0}; // assigned on first use by the Tracer
+    std::atomic_int             _runState{(int)TaskSnapshot::State::NotStarted}; // read by Dispatcher::snapshot()
+    std::chrono::steady_clock::time_point _creationTime{std::chrono::steady_clock::now()};
+    std::atomic<const char*>    _tag{nullptr};
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+    TaskTiming                  _timing;
+#endif
 };
 
 using TaskPtr = Task::Ptr;
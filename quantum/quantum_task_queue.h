@@ -23,6 +23,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <thread>
+#include <chrono>
 #include <pthread.h>
 #include <iostream>
 #include <quantum/interface/quantum_itask_continuation.h>
@@ -33,6 +34,7 @@
 #include <quantum/quantum_yielding_thread.h>
 #include <quantum/quantum_queue_statistics.h>
 #include <quantum/quantum_configuration.h>
+#include <quantum/quantum_deadlock_detector.h>
 
 namespace Bloomberg {
 namespace quantum {
@@ -46,7 +48,7 @@ namespace quantum {
 class TaskQueue : public IQueue
 {
 public:
-    using TaskList = std::list<Task::Ptr, ContiguousPoolManager<ITask::Ptr>>;
+    using TaskList = std::list<Task::Ptr, ContiguousPoolManager<Task::Ptr>>;
     using TaskListIter = TaskList::iterator;
     
     TaskQueue();
@@ -91,6 +93,17 @@ public:
     static Task* getCurrentTask();
 
     static void setCurrentTask(Task* task);
+    
+    /// @brief Gets the coroutine currently running on the thread of this queue. Used by the watchdog.
+    /// @param[out] taskId The id of the running coroutine.
+    /// @param[out] start The time at which the coroutine was started or last resumed.
+    /// @return False if the thread is not running a coroutine or if the watchdog is disabled.
+    bool getCurrentSlice(uint64_t& taskId, std::chrono::steady_clock::time_point& start) const;
+    
+    /// @brief Adds all the coroutines held by this queue to a snapshot.
+    /// @param[in,out] snapshot The snapshot.
+    /// @param[in] queueId The id reported for this queue.
+    void snapshot(DispatcherSnapshot& snapshot, int queueId) const;
 
 private:
     struct WorkItem
@@ -113,12 +126,18 @@ private:
         bool _isBlocked;                 // true if the entire queue is blocked
         unsigned int _blockedQueueRound; // blocked queue round id
     };
+    struct Slice
+    {
+        std::atomic<int64_t>    _start{0};  //steady clock ticks when the running coroutine was resumed, 0 if none
+        std::atomic<uint64_t>   _taskId{0};
+    };
     struct CurrentTaskSetter
     {
         CurrentTaskSetter(TaskQueue& taskQueue, const TaskPtr & task);
         ~CurrentTaskSetter();
 
         TaskQueue& _taskQueue;
+        Slice* _slice;
     };
     //Coroutine result handlers
     bool handleNotCallable(const WorkItem& entry);
@@ -139,6 +158,7 @@ private:
     ProcessTaskResult processTask();
     WorkItem grabWorkItem();
     void doEnqueue(ITask::Ptr task);
+    static Slice*& currentSlice();
     ITask::Ptr doDequeue(std::atomic_bool& hint,
                          TaskListIter iter);
     void acquireWaiting();
@@ -154,8 +174,8 @@ private:
     TaskListIter                        _queueIt;
     TaskListIter                        _blockedIt;
     bool                                _isBlocked;
-    mutable SpinLock                    _runQueueLock;
-    mutable SpinLock                    _waitQueueLock;
+    mutable SpinLock                    _runQueueLock{"TaskQueue::runQueue"};
+    mutable SpinLock                    _waitQueueLock{"TaskQueue::waitQueue"};
     std::mutex                          _notEmptyMutex; //for accessing the condition variable
     std::condition_variable             _notEmptyCond;
     std::atomic_bool                    _isEmpty;
@@ -164,6 +184,8 @@ private:
     std::atomic_bool                    _isIdle;
     std::atomic_bool                    _terminated;
     bool                                _isAdvanced;
+    bool                                _isWatched; //track run slices for the watchdog
+    Slice                               _slice;
     QueueStatistics                     _stats;
     std::shared_ptr<TaskQueue>          _sharedQueue;
     std::vector<TaskQueue*>             _helpers;
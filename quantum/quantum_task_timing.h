@@ -0,0 +1,71 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_TASK_TIMING_H
+#define BLOOMBERG_QUANTUM_TASK_TIMING_H
+
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+
+#include <quantum/interface/quantum_iqueue_statistics.h>
+#include <chrono>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                       class TaskTiming
+//==============================================================================================
+/// @class TaskTiming.
+/// @brief Timestamps taken over the lifetime of a coroutine or IO task.
+/// @details Only compiled in when __QUANTUM_ENABLE_TASK_TIMING is defined. A task is stamped when it is posted on a
+///          queue and around every run, and the results are recorded in the statistics of the queue which completes it.
+/// @note For internal use only.
+class TaskTiming
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    /// @brief Measures a single run of a task for the duration of its scope.
+    class RunGuard
+    {
+    public:
+        explicit RunGuard(TaskTiming& timing);
+        ~RunGuard();
+    private:
+        TaskTiming& _timing;
+        Clock::time_point _start;
+    };
+    
+    /// @brief Marks the time at which the task is posted on a queue.
+    void onPost();
+    
+    /// @brief Records the queue wait, execution and end-to-end times as well as the number of resumes of a
+    ///        completed task.
+    void record(IQueueStatistics& stats) const;
+    
+private:
+    Clock::time_point   _postTime;
+    Clock::time_point   _firstRunTime;
+    Clock::duration     _executionTime{Clock::duration::zero()};
+    size_t              _numRuns{0};
+};
+
+}}
+
+#include <quantum/impl/quantum_task_timing_impl.h>
+
+#endif //__QUANTUM_ENABLE_TASK_TIMING
+
+#endif //BLOOMBERG_QUANTUM_TASK_TIMING_H
@@ -0,0 +1,138 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_TRACER_H
+#define BLOOMBERG_QUANTUM_TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                        class Tracer
+//==============================================================================================
+/// @class Tracer.
+/// @brief Records the lifecycle of coroutines and IO tasks for offline analysis.
+/// @details When enabled, the dispatcher threads record task posts, starts, resumes, yields and completions in
+///          per-thread ring buffers which are written without locks or contention. Each yield carries its reason
+///          (still running, blocked on a future or mutex, or sleeping) so that a latency spike can be attributed.
+///          The collected events can be exported in the Chrome trace event format and loaded in chrome://tracing
+///          or https://ui.perfetto.dev. When disabled, the cost of tracing is a single relaxed atomic load per hook.
+/// @code
+///    Tracer::enable();
+///    ... run the workload ...
+///    Tracer::disable();
+///    std::ofstream file("quantum.trace.json");
+///    Tracer::dump(file);
+/// @endcode
+/// @note Events recorded by threads which have exited are kept until the next call to enable() or clear().
+class Tracer
+{
+public:
+    enum class EventType : uint8_t
+    {
+        Post,           ///< Coroutine posted on a queue
+        Start,          ///< Coroutine runs for the first time
+        Resume,         ///< Coroutine is resumed after a yield
+        YieldRunning,   ///< Coroutine yielded and remains runnable
+        YieldBlocked,   ///< Coroutine yielded while waiting on a future, mutex or condition
+        YieldSleeping,  ///< Coroutine yielded while sleeping
+        Complete,       ///< Coroutine returned or threw
+        IoPost,         ///< IO task dispatched on a queue
+        IoStart,        ///< IO task starts running
+        IoComplete      ///< IO task returned or threw
+    };
+    
+    struct Event
+    {
+        uint64_t    _timestamp; ///< Nanoseconds from an arbitrary steady epoch
+        uint64_t    _taskId;
+        int         _queueId;
+        uint32_t    _threadId;  ///< Index of the recording thread, in order of first event
+        EventType   _type;
+    };
+    
+    static constexpr size_t defaultCapacity = 1 << 16;
+    
+    /// @brief Starts recording events. All previously recorded events are discarded.
+    /// @param[in] capacityPerThread The maximum number of events kept by each thread. Once full, the oldest
+    ///                              events of that thread are overwritten.
+    static void enable(size_t capacityPerThread = defaultCapacity);
+    
+    /// @brief Stops recording events. Already recorded events are kept until the next call to enable() or clear().
+    static void disable();
+    
+    /// @brief Indicates if events are being recorded.
+    static bool isEnabled();
+    
+    /// @brief Discards all recorded events.
+    static void clear();
+    
+    /// @brief Gets a copy of all recorded events ordered by timestamp.
+    /// @note For a consistent snapshot, disable tracing first. Otherwise events overwritten while being copied
+    ///       may be reported with mixed fields.
+    static std::vector<Event> getEvents();
+    
+    /// @brief Writes all recorded events in the Chrome trace event JSON format.
+    /// @param[in,out] out Output stream.
+    static void dump(std::ostream& out);
+    
+    /// @brief Records an event from the calling thread if tracing is enabled.
+    /// @note For internal use only.
+    static void record(EventType type, uint64_t taskId, int queueId);
+    
+    /// @brief Gets the id of a task, assigning a new one if 'taskId' is 0. Safe to call from multiple threads.
+    /// @note For internal use only.
+    static uint64_t taskId(std::atomic<uint64_t>& taskId);
+    
+private:
+    struct Buffer
+    {
+        Buffer(size_t capacity, uint32_t threadId, uint64_t generation);
+        
+        std::vector<Event>      _events;
+        std::atomic<uint64_t>   _head;
+        uint32_t                _threadId;
+        uint64_t                _generation;
+    };
+    using BufferPtr = std::shared_ptr<Buffer>;
+    
+    struct State
+    {
+        std::atomic_bool        _isEnabled{false};
+        std::atomic<uint64_t>   _generation{0};
+        std::atomic<uint64_t>   _nextTaskId{1};
+        std::mutex              _mutex; //protects the members below
+        size_t                  _capacity{defaultCapacity};
+        uint32_t                _numThreads{0};
+        std::vector<BufferPtr>  _buffers;
+    };
+    
+    static State& state();
+    static Buffer& threadBuffer();
+    static const char* nameOf(EventType type);
+};
+
+}}
+
+#include <quantum/impl/quantum_tracer_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_TRACER_H
@@ -87,10 +87,26 @@ struct Traits
     template <typename T>
     struct IsThreadPromise : std::false_type
     {};
+    
+    //Value type of a pointer to a buffered future or context e.g. ThreadContextPtr<Buffer<T>>
+    template <typename SOURCE>
+    struct BufferSource
+    {};
+    
+    //Result of forEachChunk(). Void callbacks produce no result vector.
+    template <typename RET>
+    struct ChunkResults
+    {
+        using Type = std::vector<RET>;
+    };
 };
 
 template <class T>
 struct Traits::InnerType<std::vector<T>> { using Type = T; };
+template <>
+struct Traits::ChunkResults<void> { using Type = int; };
+template <template <class> class FUTURE, class T>
+struct Traits::BufferSource<std::shared_ptr<FUTURE<Buffer<T>>>> { using Type = T; };
 template <class T, class V>
 using BufferType = std::enable_if_t<Traits::IsBuffer<T>::value &&
                                     !std::is_same<std::decay_t<V>,T>::value &&
@@ -33,6 +33,14 @@ VariableGuard<T>::VariableGuard(const std::string& key, T* value) :
     _storage = value;
 }
 
+template<typename T>
+VariableGuard<T>::VariableGuard(Slot slot, T* value) :
+    _storage(variable<T>(slot)),
+    _prev(_storage)
+{
+    _storage = value;
+}
+
 template<typename T>
 VariableGuard<T>::~VariableGuard()
 {
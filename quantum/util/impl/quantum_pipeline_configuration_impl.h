@@ -0,0 +1,87 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+#include <stdexcept>
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+void PipelineStageConfiguration::setName(const std::string& name)
+{
+    _name = name;
+}
+
+inline
+const std::string& PipelineStageConfiguration::getName() const
+{
+    return _name;
+}
+
+inline
+void PipelineStageConfiguration::setParallelism(size_t parallelism)
+{
+    if (parallelism == 0)
+    {
+        throw std::invalid_argument("Stage parallelism must be greater than 0");
+    }
+    _parallelism = parallelism;
+}
+
+inline
+size_t PipelineStageConfiguration::getParallelism() const
+{
+    return _parallelism;
+}
+
+inline
+void PipelineStageConfiguration::setQueueCapacity(size_t capacity)
+{
+    if (capacity == 0)
+    {
+        throw std::invalid_argument("Stage queue capacity must be greater than 0");
+    }
+    _queueCapacity = capacity;
+}
+
+inline
+size_t PipelineStageConfiguration::getQueueCapacity() const
+{
+    return _queueCapacity;
+}
+
+inline
+void PipelineStageConfiguration::setQueueId(int queueId)
+{
+    if (queueId < (int)IQueue::QueueId::Any)
+    {
+        throw std::invalid_argument("Invalid queue id");
+    }
+    _queueId = queueId;
+}
+
+inline
+int PipelineStageConfiguration::getQueueId() const
+{
+    return _queueId;
+}
+
+}}
@@ -0,0 +1,547 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+#include <stdexcept>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                    class PipelineState
+//==============================================================================================
+inline
+PipelineState::PipelineState(PipelineOrdering ordering) :
+    _ordering(ordering)
+{
+}
+
+inline
+bool PipelineState::isOrdered() const
+{
+    return _ordering == PipelineOrdering::Ordered;
+}
+
+inline
+bool PipelineState::isAborted() const
+{
+    return _isAborted;
+}
+
+inline
+void PipelineState::addAborter(Aborter aborter)
+{
+    Mutex::Guard lock(_mutex);
+    _aborters.emplace_back(std::move(aborter));
+}
+
+inline
+void PipelineState::abort(ICoroSync::Ptr sync)
+{
+    _isAborted = true;
+    std::vector<Aborter> aborters;
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _mutex);
+        aborters = _aborters;
+    }
+    for (auto&& aborter : aborters)
+    {
+        aborter(sync);
+    }
+}
+
+inline
+void PipelineState::fail(ICoroSync::Ptr sync, std::exception_ptr error)
+{
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _mutex);
+        if (!_error)
+        {
+            _error = error;
+        }
+    }
+    abort(sync);
+}
+
+inline
+void PipelineState::workerStarted()
+{
+    Mutex::Guard lock(_mutex);
+    ++_numWorkers;
+}
+
+inline
+void PipelineState::workerFinished(ICoroSync::Ptr sync)
+{
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _mutex);
+        if (--_numWorkers > 0)
+        {
+            return;
+        }
+    }
+    _workersDone.notifyAll(sync);
+}
+
+inline
+std::exception_ptr PipelineState::wait(ICoroSync::Ptr sync)
+{
+    Mutex::Guard lock(sync, _mutex);
+    _workersDone.wait(sync, _mutex, [this]()->bool
+    {
+        return _numWorkers == 0;
+    });
+    return _error;
+}
+
+inline
+bool PipelineState::start()
+{
+    if (_isStarted.exchange(true))
+    {
+        return false;
+    }
+    _startTime = std::chrono::steady_clock::now();
+    return true;
+}
+
+inline
+std::chrono::microseconds PipelineState::getElapsedTime() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _startTime);
+}
+
+//==============================================================================================
+//                                    class PipelineStage
+//==============================================================================================
+template <class IN, class OUT>
+PipelineStage<IN, OUT>::PipelineStage(PipelineState::Ptr state,
+                                      const PipelineStageConfiguration& configuration,
+                                      IQueue::QueueType queueType,
+                                      InputQueuePtr input,
+                                      Func func) :
+    _state(std::move(state)),
+    _configuration(configuration),
+    _queueType(queueType),
+    _input(std::move(input)),
+    _func(std::move(func))
+{
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::setOutput(OutputQueuePtr output)
+{
+    _output = std::move(output);
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::start(Dispatcher& dispatcher)
+{
+    std::weak_ptr<PipelineStage<IN, OUT>> weakSelf = this->shared_from_this();
+    _state->addAborter([weakSelf](ICoroSync::Ptr sync)
+    {
+        if (auto self = weakSelf.lock())
+        {
+            self->_input->abort(sync);
+            self->releaseTurns(sync);
+        }
+    });
+    //Account for all workers before posting any of them so that the output queue is
+    //only closed once the last worker exits.
+    size_t parallelism = _configuration.getParallelism();
+    _numRunningWorkers = parallelism;
+    for (size_t i = 0; i < parallelism; ++i)
+    {
+        _state->workerStarted();
+    }
+    auto self = this->shared_from_this();
+    for (size_t i = 0; i < parallelism; ++i)
+    {
+        if (_queueType == IQueue::QueueType::Coro)
+        {
+            dispatcher.post2(_configuration.getQueueId(), false, [self](VoidContextPtr ctx)->int
+            {
+                self->run(ctx);
+                return 0;
+            });
+        }
+        else
+        {
+            dispatcher.postAsyncIo2(_configuration.getQueueId(), false, [self]()->int
+            {
+                self->run(nullptr);
+                return 0;
+            });
+        }
+    }
+}
+
+template <class IN, class OUT>
+PipelineStageStatistics PipelineStage<IN, OUT>::getStatistics() const
+{
+    PipelineStageStatistics stats;
+    stats._name = _configuration.getName();
+    stats._parallelism = _configuration.getParallelism();
+    stats._processedCount = _processedCount;
+    stats._queueDepth = _input->size();
+    stats._maxQueueDepth = _input->maxSize();
+    stats._queueCapacity = _input->capacity();
+    stats._blockedPushCount = _input->blockedPushCount();
+    stats._busyTime = std::chrono::microseconds(_busyTimeUs.load());
+    stats._elapsedTime = _state->getElapsedTime();
+    return stats;
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::run(VoidContextPtr ctx)
+{
+    ICoroSync::Ptr sync = ctx;
+    std::exception_ptr error;
+    PipelineItem<IN> item;
+    while (!_state->isAborted() && _input->pull(sync, item))
+    {
+        try
+        {
+            if (!process(ctx, std::move(item), std::is_void<OUT>()))
+            {
+                break; //downstream aborted
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+            break;
+        }
+    }
+    if (error)
+    {
+        //Abort outside of the handler since it may yield this coroutine
+        _state->fail(sync, error);
+    }
+    if (--_numRunningWorkers == 0)
+    {
+        closeOutput(sync, std::is_void<OUT>());
+    }
+    _state->workerFinished(sync);
+}
+
+template <class IN, class OUT>
+bool PipelineStage<IN, OUT>::process(VoidContextPtr ctx, PipelineItem<IN>&& item, std::true_type)
+{
+    auto start = std::chrono::steady_clock::now();
+    _func(ctx, std::move(item.second));
+    _busyTimeUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    ++_processedCount;
+    return true;
+}
+
+template <class IN, class OUT>
+bool PipelineStage<IN, OUT>::process(VoidContextPtr ctx, PipelineItem<IN>&& item, std::false_type)
+{
+    auto start = std::chrono::steady_clock::now();
+    PipelineItem<OUT> result(item.first, _func(ctx, std::move(item.second)));
+    _busyTimeUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    ++_processedCount;
+    if (!_state->isOrdered())
+    {
+        return _output->push(ctx, std::move(result));
+    }
+    waitTurn(ctx, result.first);
+    bool pushed = _output->push(ctx, std::move(result));
+    endTurn(ctx);
+    return pushed;
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::closeOutput(ICoroSync::Ptr, std::true_type)
+{
+    //sink stage
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::closeOutput(ICoroSync::Ptr sync, std::false_type)
+{
+    _output->close(sync);
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::waitTurn(ICoroSync::Ptr sync, size_t sequence)
+{
+    Mutex::Guard lock(sync, _turnMutex);
+    _turnCond.wait(sync, _turnMutex, [this, sequence]()->bool
+    {
+        return (_nextSequence == sequence) || _state->isAborted();
+    });
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::endTurn(ICoroSync::Ptr sync)
+{
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _turnMutex);
+        ++_nextSequence;
+    }
+    _turnCond.notifyAll(sync);
+}
+
+template <class IN, class OUT>
+void PipelineStage<IN, OUT>::releaseTurns(ICoroSync::Ptr sync)
+{
+    {//========= LOCKED SCOPE =========
+        //Synchronize with waiters evaluating the abort flag
+        Mutex::Guard lock(sync, _turnMutex);
+    }
+    _turnCond.notifyAll(sync);
+}
+
+//==============================================================================================
+//                                        class Pipeline
+//==============================================================================================
+template <class IN, class OUT>
+Pipeline<IN, OUT>::Pipeline(PipelineState::Ptr state,
+                            InputQueuePtr input,
+                            OutputQueuePtr output,
+                            std::vector<IPipelineStage::Ptr> stages) :
+    _state(std::move(state)),
+    _input(std::move(input)),
+    _output(std::move(output)),
+    _stages(std::move(stages))
+{
+}
+
+template <class IN, class OUT>
+Pipeline<IN, OUT>::~Pipeline()
+{
+    abort(nullptr);
+    _state->wait(nullptr);
+}
+
+template <class IN, class OUT>
+bool Pipeline<IN, OUT>::push(IN value)
+{
+    return push(nullptr, std::move(value));
+}
+
+template <class IN, class OUT>
+bool Pipeline<IN, OUT>::push(ICoroSync::Ptr sync, IN value)
+{
+    if (!_state->isOrdered())
+    {
+        return _input->push(sync, PipelineItem<IN>(0, std::move(value)));
+    }
+    //Sequence numbers must match the order in which items are queued
+    Mutex::Guard lock(sync, _inputMutex);
+    return _input->push(sync, PipelineItem<IN>(_nextSequence++, std::move(value)));
+}
+
+template <class IN, class OUT>
+void Pipeline<IN, OUT>::close()
+{
+    close(nullptr);
+}
+
+template <class IN, class OUT>
+void Pipeline<IN, OUT>::close(ICoroSync::Ptr sync)
+{
+    _input->close(sync);
+}
+
+template <class IN, class OUT>
+void Pipeline<IN, OUT>::abort()
+{
+    abort(nullptr);
+}
+
+template <class IN, class OUT>
+void Pipeline<IN, OUT>::abort(ICoroSync::Ptr sync)
+{
+    _state->abort(sync);
+}
+
+template <class IN, class OUT>
+template <class V, class>
+bool Pipeline<IN, OUT>::pull(V& value)
+{
+    return pull(nullptr, value);
+}
+
+template <class IN, class OUT>
+template <class V, class>
+bool Pipeline<IN, OUT>::pull(ICoroSync::Ptr sync, V& value)
+{
+    PipelineItem<OUT> item;
+    if (!_output->pull(sync, item))
+    {
+        return false;
+    }
+    value = std::move(item.second);
+    return true;
+}
+
+template <class IN, class OUT>
+void Pipeline<IN, OUT>::wait()
+{
+    wait(nullptr);
+}
+
+template <class IN, class OUT>
+void Pipeline<IN, OUT>::wait(ICoroSync::Ptr sync)
+{
+    std::exception_ptr error = _state->wait(sync);
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+template <class IN, class OUT>
+std::vector<PipelineStageStatistics> Pipeline<IN, OUT>::getStatistics() const
+{
+    std::vector<PipelineStageStatistics> stats;
+    stats.reserve(_stages.size());
+    for (auto&& stage : _stages)
+    {
+        stats.emplace_back(stage->getStatistics());
+    }
+    return stats;
+}
+
+//==============================================================================================
+//                                     class PipelineBuilder
+//==============================================================================================
+template <class IN, class OUT>
+PipelineBuilder<IN, OUT>::PipelineBuilder(Dispatcher& dispatcher,
+                                          PipelineOrdering ordering) :
+    _dispatcher(dispatcher),
+    _state(std::make_shared<PipelineState>(ordering)),
+    _input(std::make_shared<InputQueuePtr>())
+{
+    static_assert(std::is_same<IN, OUT>::value, "Invalid pipeline builder");
+    static_assert(!std::is_void<IN>::value, "Pipeline input type cannot be void");
+    std::shared_ptr<InputQueuePtr> input = _input;
+    _connector = [input](OutputQueuePtr queue)
+    {
+        *input = std::move(queue);
+    };
+}
+
+template <class IN, class OUT>
+PipelineBuilder<IN, OUT>::PipelineBuilder(Dispatcher& dispatcher,
+                                          PipelineState::Ptr state,
+                                          std::shared_ptr<InputQueuePtr> input,
+                                          std::vector<IPipelineStage::Ptr> stages,
+                                          Connector connector) :
+    _dispatcher(dispatcher),
+    _state(std::move(state)),
+    _input(std::move(input)),
+    _stages(std::move(stages)),
+    _connector(std::move(connector))
+{
+}
+
+template <class IN, class OUT>
+template <class FUNC>
+auto PipelineBuilder<IN, OUT>::addStage(FUNC&& func,
+                                        const PipelineStageConfiguration& configuration)
+    ->PipelineBuilder<IN, decltype(resultOf2(func))>
+{
+    using NEXT = decltype(resultOf2(func));
+    return addStageImpl<NEXT>(std::forward<FUNC>(func), configuration, IQueue::QueueType::Coro);
+}
+
+template <class IN, class OUT>
+template <class FUNC>
+auto PipelineBuilder<IN, OUT>::addIoStage(FUNC&& func,
+                                          const PipelineStageConfiguration& configuration)
+    ->PipelineBuilder<IN, decltype(resultOf2(func))>
+{
+    using NEXT = decltype(resultOf2(func));
+    using Func = std::function<NEXT(OUT&&)>;
+    Func ioFunc(std::forward<FUNC>(func));
+    return addStageImpl<NEXT>([ioFunc](VoidContextPtr, OUT&& value)->NEXT
+    {
+        return ioFunc(std::move(value));
+    }, configuration, IQueue::QueueType::IO);
+}
+
+template <class IN, class OUT>
+template <class NEXT>
+PipelineBuilder<IN, NEXT>
+PipelineBuilder<IN, OUT>::addStageImpl(typename PipelineStage<OUT, NEXT>::Func func,
+                                       const PipelineStageConfiguration& configuration,
+                                       IQueue::QueueType queueType)
+{
+    static_assert(!std::is_void<OUT>::value, "Cannot add a stage after a sink stage");
+    auto input = std::make_shared<PipelineQueue<PipelineItem<OUT>>>(configuration.getQueueCapacity());
+    _connector(input);
+    auto stage = std::make_shared<PipelineStage<OUT, NEXT>>(_state, configuration, queueType, input, std::move(func));
+    std::vector<IPipelineStage::Ptr> stages = _stages;
+    stages.push_back(stage);
+    return PipelineBuilder<IN, NEXT>(_dispatcher, _state, _input, std::move(stages),
+        [stage](typename PipelineQueueOf<NEXT>::Ptr output)
+        {
+            stage->setOutput(std::move(output));
+        });
+}
+
+template <class IN, class OUT>
+typename Pipeline<IN, OUT>::Ptr PipelineBuilder<IN, OUT>::build(size_t outputQueueCapacity)
+{
+    if (_stages.empty())
+    {
+        throw std::runtime_error("Pipeline has no stages");
+    }
+    if (!_state->start())
+    {
+        throw std::runtime_error("Pipeline already built");
+    }
+    OutputQueuePtr output = makeOutput(outputQueueCapacity, std::is_void<OUT>());
+    for (auto&& stage : _stages)
+    {
+        stage->start(_dispatcher);
+    }
+    return typename Pipeline<IN, OUT>::Ptr(new Pipeline<IN, OUT>(_state, *_input, std::move(output), _stages));
+}
+
+template <class IN, class OUT>
+typename PipelineBuilder<IN, OUT>::OutputQueuePtr
+PipelineBuilder<IN, OUT>::makeOutput(size_t, std::true_type)
+{
+    return nullptr; //sink stage
+}
+
+template <class IN, class OUT>
+typename PipelineBuilder<IN, OUT>::OutputQueuePtr
+PipelineBuilder<IN, OUT>::makeOutput(size_t capacity, std::false_type)
+{
+    auto output = std::make_shared<PipelineQueue<PipelineItem<OUT>>>(capacity);
+    _connector(output);
+    std::weak_ptr<PipelineQueue<PipelineItem<OUT>>> weakOutput = output;
+    _state->addAborter([weakOutput](ICoroSync::Ptr sync)
+    {
+        if (auto output = weakOutput.lock())
+        {
+            output->abort(sync);
+        }
+    });
+    return output;
+}
+
+}}
@@ -0,0 +1,128 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+#include <algorithm>
+
+namespace Bloomberg {
+namespace quantum {
+
+template <class T>
+PipelineQueue<T>::PipelineQueue(size_t capacity) :
+    _capacity(std::max(capacity, (size_t)1))
+{
+}
+
+template <class T>
+bool PipelineQueue<T>::push(ICoroSync::Ptr sync, T&& item)
+{
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _mutex);
+        if (!_isClosed && (_items.size() >= _capacity))
+        {
+            ++_blockedPushCount;
+            _notFull.wait(sync, _mutex, [this]()->bool
+            {
+                return _isClosed || (_items.size() < _capacity);
+            });
+        }
+        if (_isClosed)
+        {
+            return false;
+        }
+        _items.emplace_back(std::move(item));
+        _maxSize = std::max(_maxSize, _items.size());
+    }
+    _notEmpty.notifyOne(sync);
+    return true;
+}
+
+template <class T>
+bool PipelineQueue<T>::pull(ICoroSync::Ptr sync, T& item)
+{
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _mutex);
+        _notEmpty.wait(sync, _mutex, [this]()->bool
+        {
+            return _isClosed || !_items.empty();
+        });
+        if (_items.empty())
+        {
+            return false; //closed
+        }
+        item = std::move(_items.front());
+        _items.pop_front();
+    }
+    _notFull.notifyOne(sync);
+    return true;
+}
+
+template <class T>
+void PipelineQueue<T>::close(ICoroSync::Ptr sync)
+{
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _mutex);
+        _isClosed = true;
+    }
+    _notFull.notifyAll(sync);
+    _notEmpty.notifyAll(sync);
+}
+
+template <class T>
+void PipelineQueue<T>::abort(ICoroSync::Ptr sync)
+{
+    std::deque<T> items;
+    {//========= LOCKED SCOPE =========
+        Mutex::Guard lock(sync, _mutex);
+        _isClosed = true;
+        items.swap(_items); //destroy outside the lock
+    }
+    _notFull.notifyAll(sync);
+    _notEmpty.notifyAll(sync);
+}
+
+template <class T>
+size_t PipelineQueue<T>::size() const
+{
+    Mutex::Guard lock(_mutex);
+    return _items.size();
+}
+
+template <class T>
+size_t PipelineQueue<T>::capacity() const
+{
+    return _capacity;
+}
+
+template <class T>
+size_t PipelineQueue<T>::maxSize() const
+{
+    Mutex::Guard lock(_mutex);
+    return _maxSize;
+}
+
+template <class T>
+size_t PipelineQueue<T>::blockedPushCount() const
+{
+    Mutex::Guard lock(_mutex);
+    return _blockedPushCount;
+}
+
+}}
@@ -0,0 +1,103 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+const std::string& PipelineStageStatistics::getName() const
+{
+    return _name;
+}
+
+inline
+size_t PipelineStageStatistics::getParallelism() const
+{
+    return _parallelism;
+}
+
+inline
+size_t PipelineStageStatistics::getProcessedCount() const
+{
+    return _processedCount;
+}
+
+inline
+size_t PipelineStageStatistics::getQueueDepth() const
+{
+    return _queueDepth;
+}
+
+inline
+size_t PipelineStageStatistics::getMaxQueueDepth() const
+{
+    return _maxQueueDepth;
+}
+
+inline
+size_t PipelineStageStatistics::getQueueCapacity() const
+{
+    return _queueCapacity;
+}
+
+inline
+size_t PipelineStageStatistics::getBlockedPushCount() const
+{
+    return _blockedPushCount;
+}
+
+inline
+std::chrono::microseconds PipelineStageStatistics::getBusyTime() const
+{
+    return _busyTime;
+}
+
+inline
+std::chrono::microseconds PipelineStageStatistics::getElapsedTime() const
+{
+    return _elapsedTime;
+}
+
+inline
+double PipelineStageStatistics::getThroughput() const
+{
+    if (_elapsedTime.count() == 0)
+    {
+        return 0;
+    }
+    return _processedCount * 1e6 / _elapsedTime.count();
+}
+
+inline
+std::ostream& operator<<(std::ostream& out, const PipelineStageStatistics& stats)
+{
+    out << "Stage: " << stats.getName() << std::endl;
+    out << "Parallelism: " << stats.getParallelism() << std::endl;
+    out << "Num processed: " << stats.getProcessedCount() << std::endl;
+    out << "Throughput (items/s): " << stats.getThroughput() << std::endl;
+    out << "Queue depth: " << stats.getQueueDepth() << "/" << stats.getQueueCapacity() << std::endl;
+    out << "Max queue depth: " << stats.getMaxQueueDepth() << std::endl;
+    out << "Num blocked pushes: " << stats.getBlockedPushCount() << std::endl;
+    out << "Busy time (us): " << stats.getBusyTime().count() << std::endl;
+    return out;
+}
+
+}}
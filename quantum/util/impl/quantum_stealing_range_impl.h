@@ -0,0 +1,162 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+#include <algorithm>
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+StealingRange::Slot::Slot() :
+    _begin(0),
+    _end(0)
+{}
+
+inline
+StealingRange::StealingRange(size_t size,
+                             size_t numWorkers,
+                             size_t grainSize) :
+    _slots(std::max(numWorkers, (size_t)1)),
+    _grainSize(std::max(grainSize, (size_t)1)),
+    _cancelled(false)
+{
+    //split the range equally, the first 'remainder' workers get one extra index
+    size_t numPerWorker = size/_slots.size();
+    size_t remainder = size%_slots.size();
+    size_t begin = 0;
+    for (size_t i = 0; i < _slots.size(); ++i)
+    {
+        size_t end = begin + ((i < remainder) ? numPerWorker + 1 : numPerWorker);
+        _slots[i]._begin.store(begin, std::memory_order_relaxed);
+        _slots[i]._end.store(end, std::memory_order_relaxed);
+        begin = end;
+    }
+}
+
+inline
+StealingRange::Range StealingRange::next(size_t worker)
+{
+    Slot& slot = _slots.at(worker);
+    while (!_cancelled.load(std::memory_order_relaxed))
+    {
+        Range range = take(slot);
+        if (range.first != range.second)
+        {
+            return range;
+        }
+        if (!steal(worker))
+        {
+            break; //no work left anywhere
+        }
+    }
+    return Range(0, 0);
+}
+
+inline
+void StealingRange::cancel()
+{
+    _cancelled = true;
+}
+
+inline
+size_t StealingRange::numWorkers() const
+{
+    return _slots.size();
+}
+
+inline
+size_t StealingRange::grainSize() const
+{
+    return _grainSize;
+}
+
+inline
+size_t StealingRange::defaultGrainSize(size_t size, size_t numWorkers)
+{
+    //aim for 64 chunks per worker which leaves plenty of room for stealing
+    return std::max(size/(std::max(numWorkers, (size_t)1)*64), (size_t)1);
+}
+
+inline
+StealingRange::Range StealingRange::take(Slot& slot)
+{
+    //========================= LOCKED SCOPE =========================
+    SpinLock::Guard lock(slot._lock);
+    size_t begin = slot._begin.load(std::memory_order_relaxed);
+    size_t end = std::min(slot._end.load(std::memory_order_relaxed), begin + _grainSize);
+    slot._begin.store(end, std::memory_order_relaxed);
+    return Range(begin, end);
+}
+
+inline
+bool StealingRange::steal(size_t thief)
+{
+    while (!_cancelled.load(std::memory_order_relaxed))
+    {
+        //find the victim with the most remaining work. This is only a hint since the
+        //slots are read without locking.
+        size_t victim = thief;
+        size_t mostRemaining = 0;
+        for (size_t i = 0; i < _slots.size(); ++i)
+        {
+            size_t begin = _slots[i]._begin.load(std::memory_order_relaxed);
+            size_t end = _slots[i]._end.load(std::memory_order_relaxed);
+            size_t remaining = (end > begin) ? end - begin : 0;
+            if ((i != thief) && (remaining > mostRemaining))
+            {
+                mostRemaining = remaining;
+                victim = i;
+            }
+        }
+        if (mostRemaining < 2)
+        {
+            //Whatever is left will be consumed by its owner
+            return false;
+        }
+        Range stolen(0, 0);
+        {
+            //========================= LOCKED SCOPE =========================
+            SpinLock::Guard lock(_slots[victim]._lock);
+            size_t begin = _slots[victim]._begin.load(std::memory_order_relaxed);
+            size_t end = _slots[victim]._end.load(std::memory_order_relaxed);
+            if (end > begin + 1)
+            {
+                //steal the back half, the victim keeps iterating over the front half
+                size_t middle = begin + (end - begin)/2;
+                _slots[victim]._end.store(middle, std::memory_order_relaxed);
+                stolen = Range(middle, end);
+            }
+        }
+        if (stolen.first != stolen.second)
+        {
+            //The thief's slot is empty and only the thief refills it. Locking is still needed since
+            //other thieves may be inspecting it.
+            //========================= LOCKED SCOPE =========================
+            SpinLock::Guard lock(_slots[thief]._lock);
+            _slots[thief]._begin.store(stolen.first, std::memory_order_relaxed);
+            _slots[thief]._end.store(stolen.second, std::memory_order_relaxed);
+            return true;
+        }
+        //lost the race against the owner or another thief, try again
+    }
+    return false;
+}
+
+}}
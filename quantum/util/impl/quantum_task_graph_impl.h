@@ -0,0 +1,377 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                      class TaskGraphInputs
+//==============================================================================================
+inline
+TaskGraphInputs::TaskGraphInputs(const TaskGraph& graph, size_t id) :
+    _graph(graph),
+    _id(id)
+{
+}
+
+template <class T>
+const T& TaskGraphInputs::get(const TaskGraphNode<T>& node) const
+{
+    static_assert(!std::is_void<T>::value, "Node does not return a result");
+    const std::vector<size_t>& predecessors = _graph._nodes[_id]->_predecessors;
+    if (std::find(predecessors.begin(), predecessors.end(), node.getId()) == predecessors.end())
+    {
+        throw std::invalid_argument("Node is not a predecessor");
+    }
+    return *std::static_pointer_cast<const T>(_graph._nodes[node.getId()]->_result);
+}
+
+inline
+size_t TaskGraphInputs::size() const
+{
+    return _graph._nodes[_id]->_predecessors.size();
+}
+
+//==============================================================================================
+//                                         class TaskGraph
+//==============================================================================================
+inline
+TaskGraph::TaskGraph(Dispatcher& dispatcher) :
+    _dispatcher(dispatcher)
+{
+}
+
+inline
+TaskGraph::~TaskGraph()
+{
+    PromisePtr<int> promise;
+    {//========= LOCKED SCOPE =========
+        std::lock_guard<std::mutex> lock(_runMutex);
+        promise = _promise;
+    }
+    if (promise)
+    {
+        promise->getIThreadFuture()->wait();
+    }
+}
+
+template <class FUNC>
+auto TaskGraph::addNode(FUNC&& func,
+                        int queueId,
+                        bool isHighPriority)->TaskGraphNode<decltype(resultOf2(func))>
+{
+    using RET = decltype(resultOf2(func));
+    return addNodeImpl<RET>(wrap<RET>(std::forward<FUNC>(func), std::is_void<RET>()),
+                            IQueue::QueueType::Coro, queueId, isHighPriority);
+}
+
+template <class FUNC>
+auto TaskGraph::addIoNode(FUNC&& func,
+                          int queueId,
+                          bool isHighPriority)->TaskGraphNode<decltype(resultOf2(func))>
+{
+    using RET = decltype(resultOf2(func));
+    auto ioFunc = [f = std::forward<FUNC>(func)](VoidContextPtr, const TaskGraphInputs& inputs) mutable->RET
+    {
+        return f(inputs);
+    };
+    return addNodeImpl<RET>(wrap<RET>(std::move(ioFunc), std::is_void<RET>()),
+                            IQueue::QueueType::IO, queueId, isHighPriority);
+}
+
+template <class FROM, class TO>
+void TaskGraph::addEdge(const TaskGraphNode<FROM>& from, const TaskGraphNode<TO>& to)
+{
+    checkIdle();
+    checkNode(from.getId());
+    checkNode(to.getId());
+    if (from.getId() == to.getId())
+    {
+        throw std::invalid_argument("Node cannot depend on itself");
+    }
+    std::vector<size_t>& successors = _nodes[from.getId()]->_successors;
+    if (std::find(successors.begin(), successors.end(), to.getId()) != successors.end())
+    {
+        return; //duplicate
+    }
+    successors.push_back(to.getId());
+    _nodes[to.getId()]->_predecessors.push_back(from.getId());
+    _isValidated = false;
+}
+
+inline
+ThreadFuturePtr<int> TaskGraph::run()
+{
+    std::vector<size_t> roots;
+    PromisePtr<int> promise = start(roots);
+    ThreadFuturePtr<int> future = promise->getIThreadFuture();
+    for (size_t id : roots)
+    {
+        schedule(id);
+    }
+    return future;
+}
+
+inline
+CoroFuturePtr<int> TaskGraph::run(ICoroSync::Ptr)
+{
+    std::vector<size_t> roots;
+    PromisePtr<int> promise = start(roots);
+    CoroFuturePtr<int> future = promise->getICoroFuture();
+    for (size_t id : roots)
+    {
+        schedule(id);
+    }
+    return future;
+}
+
+template <class RET>
+const RET& TaskGraph::getResult(const TaskGraphNode<RET>& node) const
+{
+    static_assert(!std::is_void<RET>::value, "Node does not return a result");
+    checkIdle();
+    checkNode(node.getId());
+    const std::shared_ptr<void>& result = _nodes[node.getId()]->_result;
+    if (!result)
+    {
+        throw std::runtime_error("Node has no result");
+    }
+    return *std::static_pointer_cast<const RET>(result);
+}
+
+inline
+size_t TaskGraph::getNumNodes() const
+{
+    return _nodes.size();
+}
+
+inline
+bool TaskGraph::isRunning() const
+{
+    return _isRunning;
+}
+
+template <class RET>
+TaskGraphNode<RET> TaskGraph::addNodeImpl(NodeFunc func,
+                                          IQueue::QueueType queueType,
+                                          int queueId,
+                                          bool isHighPriority)
+{
+    checkIdle();
+    std::unique_ptr<Node> node(new Node());
+    node->_func = std::move(func);
+    node->_queueType = queueType;
+    node->_queueId = queueId;
+    node->_isHighPriority = isHighPriority;
+    _nodes.push_back(std::move(node));
+    _isValidated = false;
+    return TaskGraphNode<RET>(_nodes.size() - 1);
+}
+
+template <class RET, class FUNC>
+TaskGraph::NodeFunc TaskGraph::wrap(FUNC&& func, std::true_type)
+{
+    return [f = std::forward<FUNC>(func)](VoidContextPtr ctx, const TaskGraphInputs& inputs) mutable->std::shared_ptr<void>
+    {
+        f(ctx, inputs);
+        return nullptr;
+    };
+}
+
+template <class RET, class FUNC>
+TaskGraph::NodeFunc TaskGraph::wrap(FUNC&& func, std::false_type)
+{
+    return [f = std::forward<FUNC>(func)](VoidContextPtr ctx, const TaskGraphInputs& inputs) mutable->std::shared_ptr<void>
+    {
+        return std::make_shared<RET>(f(ctx, inputs));
+    };
+}
+
+inline
+void TaskGraph::checkNode(size_t id) const
+{
+    if (id >= _nodes.size())
+    {
+        throw std::invalid_argument("Node does not belong to this graph");
+    }
+}
+
+inline
+void TaskGraph::checkIdle() const
+{
+    if (_isRunning)
+    {
+        throw std::runtime_error("TaskGraph is running");
+    }
+}
+
+inline
+void TaskGraph::validate()
+{
+    if (_isValidated)
+    {
+        return;
+    }
+    //Kahn's algorithm
+    std::vector<size_t> inDegree(_nodes.size());
+    std::vector<size_t> ready;
+    for (size_t id = 0; id < _nodes.size(); ++id)
+    {
+        inDegree[id] = _nodes[id]->_predecessors.size();
+        if (inDegree[id] == 0)
+        {
+            ready.push_back(id);
+        }
+    }
+    std::vector<size_t> roots = ready;
+    size_t numVisited = 0;
+    while (!ready.empty())
+    {
+        size_t id = ready.back();
+        ready.pop_back();
+        ++numVisited;
+        for (size_t successor : _nodes[id]->_successors)
+        {
+            if (--inDegree[successor] == 0)
+            {
+                ready.push_back(successor);
+            }
+        }
+    }
+    if (numVisited != _nodes.size())
+    {
+        throw std::runtime_error("TaskGraph contains a cycle");
+    }
+    _roots = std::move(roots);
+    _isValidated = true;
+}
+
+inline
+PromisePtr<int> TaskGraph::start(std::vector<size_t>& roots)
+{
+    auto promise = PromisePtr<int>(new Promise<int>(), Promise<int>::deleter);
+    std::lock_guard<std::mutex> lock(_runMutex);
+    if (_isRunning)
+    {
+        throw std::runtime_error("TaskGraph is already running");
+    }
+    validate();
+    if (_nodes.empty())
+    {
+        promise->set(0);
+        return promise;
+    }
+    for (auto&& node : _nodes)
+    {
+        node->_pending = node->_predecessors.size();
+        node->_isSkipped = false;
+        node->_result.reset();
+    }
+    _isFailed = false;
+    _error = nullptr;
+    _remaining = _nodes.size();
+    _promise = promise;
+    _isRunning = true;
+    roots = _roots; //a fast run may complete and the graph be modified before all roots are posted
+    return promise;
+}
+
+inline
+void TaskGraph::schedule(size_t id)
+{
+    const Node& node = *_nodes[id];
+    if (node._queueType == IQueue::QueueType::Coro)
+    {
+        _dispatcher.post2(node._queueId, node._isHighPriority, [this, id](VoidContextPtr ctx)->int
+        {
+            execute(ctx, id);
+            return 0;
+        });
+    }
+    else
+    {
+        _dispatcher.postAsyncIo2(node._queueId, node._isHighPriority, [this, id]()->int
+        {
+            execute(nullptr, id);
+            return 0;
+        });
+    }
+}
+
+inline
+void TaskGraph::execute(VoidContextPtr ctx, size_t id)
+{
+    Node& node = *_nodes[id];
+    std::exception_ptr error;
+    const bool isSkipped = node._isSkipped;
+    if (!isSkipped)
+    {
+        try
+        {
+            node._result = node._func(ctx, TaskGraphInputs(*this, id));
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+    }
+    if (error && !_isFailed.exchange(true))
+    {
+        _error = error; //first error wins
+    }
+    //Successors of a failed or skipped node are still released so that the run completes but their functions are skipped
+    for (size_t successor : node._successors)
+    {
+        if (error || isSkipped)
+        {
+            _nodes[successor]->_isSkipped = true; //published to the last predecessor by the decrement below
+        }
+        if (--_nodes[successor]->_pending == 0)
+        {
+            schedule(successor);
+        }
+    }
+    if (--_remaining > 0)
+    {
+        return;
+    }
+    //Last node. The graph may be destroyed or run again as soon as the lock is released.
+    PromisePtr<int> promise;
+    {//========= LOCKED SCOPE =========
+        std::lock_guard<std::mutex> lock(_runMutex);
+        promise = std::move(_promise);
+        error = _error;
+        _isRunning = false;
+    }
+    if (error)
+    {
+        promise->setException(error);
+    }
+    else
+    {
+        promise->set(0);
+    }
+}
+
+}}
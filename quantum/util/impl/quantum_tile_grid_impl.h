@@ -0,0 +1,90 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//NOTE: DO NOT INCLUDE DIRECTLY
+
+//##############################################################################################
+//#################################### IMPLEMENTATIONS #########################################
+//##############################################################################################
+#include <algorithm>
+
+namespace Bloomberg {
+namespace quantum {
+
+inline
+TileGrid::TileGrid(size_t rows,
+                   size_t cols,
+                   size_t tileRows,
+                   size_t tileCols) :
+    _rows(rows),
+    _cols(cols),
+    _tileRows(tileRows ? tileRows : DefaultTileSize),
+    _tileCols(tileCols ? tileCols : DefaultTileSize)
+{
+    if (!rows || !cols)
+    {
+        return; //empty range
+    }
+    size_t numTileRows = (rows + _tileRows - 1)/_tileRows;
+    size_t numTileCols = (cols + _tileCols - 1)/_tileCols;
+    _order.reserve(numTileRows*numTileCols);
+    for (size_t row = 0; row < numTileRows; ++row)
+    {
+        for (size_t col = 0; col < numTileCols; ++col)
+        {
+            _order.emplace_back((uint32_t)row, (uint32_t)col);
+        }
+    }
+    //The grid is not necessarily square nor a power of two so sort the tiles by their
+    //Z-order code rather than walking the curve.
+    std::sort(_order.begin(), _order.end(),
+        [](const std::pair<uint32_t, uint32_t>& lhs, const std::pair<uint32_t, uint32_t>& rhs)->bool
+    {
+        return mortonCode(lhs.first, lhs.second) < mortonCode(rhs.first, rhs.second);
+    });
+}
+
+inline
+size_t TileGrid::size() const
+{
+    return _order.size();
+}
+
+inline
+Tile2D TileGrid::tile(size_t index) const
+{
+    const std::pair<uint32_t, uint32_t>& position = _order[index];
+    size_t rowBegin = position.first*_tileRows;
+    size_t colBegin = position.second*_tileCols;
+    return {rowBegin, std::min(rowBegin + _tileRows, _rows), colBegin, std::min(colBegin + _tileCols, _cols)};
+}
+
+inline
+uint64_t TileGrid::mortonCode(uint32_t row, uint32_t col)
+{
+    //interleave the bits of both coordinates
+    auto spread = [](uint64_t value)->uint64_t
+    {
+        value = (value | (value << 16)) & 0x0000FFFF0000FFFFULL;
+        value = (value | (value << 8)) & 0x00FF00FF00FF00FFULL;
+        value = (value | (value << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+        value = (value | (value << 2)) & 0x3333333333333333ULL;
+        value = (value | (value << 1)) & 0x5555555555555555ULL;
+        return value;
+    };
+    return (spread(row) << 1) | spread(col);
+}
+
+}}
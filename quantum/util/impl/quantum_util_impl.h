@@ -18,7 +18,13 @@
 //##############################################################################################
 //#################################### IMPLEMENTATIONS #########################################
 //##############################################################################################
+#include <queue>
+#include <atomic>
+#include <unordered_map>
+#include <algorithm>
 #include <quantum/util/quantum_future_joiner.h>
+#include <quantum/util/quantum_stealing_range.h>
+#include <quantum/util/quantum_tile_grid.h>
 
 namespace Bloomberg {
 namespace quantum {
@@ -105,7 +111,7 @@ int bindCoro2(Traits::Yield& yield,
 }
 
 template <typename RET, typename CAPTURE>
-int bindIo(std::shared_ptr<Promise<RET>> promise,
+int bindIo(const std::shared_ptr<Promise<RET>>& promise,
            CAPTURE&& capture)
 {
     try
@@ -252,100 +258,1166 @@ Util::forEachBatchCoro(VoidContextPtr ctx,
     return FutureJoiner<std::vector<RET>>()(*ctx, std::move(asyncResults))->get(ctx);
 }
 
+template <class FUTURE_PTR>
+auto joinAll(VoidContextPtr ctx, std::vector<FUTURE_PTR>& asyncResults)->
+    std::vector<std::decay_t<decltype(asyncResults.front()->get(ctx))>>
+{
+    //Wait for all the tasks to finish before propagating any error since they reference the caller's frame
+    for (auto&& asyncResult : asyncResults)
+    {
+        asyncResult->wait(ctx);
+    }
+    std::vector<std::decay_t<decltype(asyncResults.front()->get(ctx))>> results;
+    results.reserve(asyncResults.size());
+    for (auto&& asyncResult : asyncResults)
+    {
+        results.emplace_back(asyncResult->get(ctx));
+    }
+    return results;
+}
+
+template <class RET, class INPUT_IT, class FUNC>
+std::vector<RET>
+Util::parallelForCoro(VoidContextPtr ctx,
+                      INPUT_IT first,
+                      size_t num,
+                      FUNC&& func,
+                      size_t grainSize)
+{
+    static_assert(!std::is_same<RET, bool>::value, "Concurrent writes to std::vector<bool> are not supported");
+    std::vector<RET> results(num);
+    if (num == 0)
+    {
+        return results;
+    }
+    
+    //One worker per coroutine thread covered by the 'Any' queue
+    const std::pair<int, int>& queueIdRange = ctx->getCoroQueueIdRangeForAny();
+    size_t numWorkers = std::min((size_t)(queueIdRange.second - queueIdRange.first + 1), num);
+    auto range = std::make_shared<StealingRange>(num,
+                                                 numWorkers,
+                                                 grainSize ? grainSize : StealingRange::defaultGrainSize(num, numWorkers));
+    std::vector<CoroContextPtr<int>> asyncResults;
+    asyncResults.reserve(numWorkers);
+    for (size_t worker = 0; worker < numWorkers; ++worker)
+    {
+        asyncResults.emplace_back(ctx->post2(queueIdRange.first + (int)worker, false,
+            [worker, first, range, &results, &func](VoidContextPtr ctx)->int
+        {
+            try
+            {
+                for (StealingRange::Range r = range->next(worker); r.first != r.second; r = range->next(worker))
+                {
+                    INPUT_IT it = first + r.first;
+                    for (size_t i = r.first; i < r.second; ++i, ++it)
+                    {
+                        results[i] = std::forward<FUNC>(func)(ctx, *it);
+                    }
+                }
+            }
+            catch (...)
+            {
+                range->cancel(); //stop all other workers
+                throw;
+            }
+            return 0;
+        }));
+    }
+    joinAll(ctx, asyncResults);
+    return results;
+}
+
+template <class FUNC>
+int Util::parallelFor2DCoro(VoidContextPtr ctx,
+                            size_t rows,
+                            size_t cols,
+                            size_t tileRows,
+                            size_t tileCols,
+                            FUNC&& func)
+{
+    auto grid = std::make_shared<TileGrid>(rows, cols, tileRows, tileCols);
+    size_t numTiles = grid->size();
+    if (numTiles == 0)
+    {
+        return 0;
+    }
+    
+    //Tiles are enumerated in Z-order so each worker starts on a contiguous block of neighbouring tiles
+    //and only leaves it when stealing from another worker.
+    const std::pair<int, int>& queueIdRange = ctx->getCoroQueueIdRangeForAny();
+    size_t numWorkers = std::min((size_t)(queueIdRange.second - queueIdRange.first + 1), numTiles);
+    auto range = std::make_shared<StealingRange>(numTiles, numWorkers, 1);
+    std::vector<CoroContextPtr<int>> asyncResults;
+    asyncResults.reserve(numWorkers);
+    for (size_t worker = 0; worker < numWorkers; ++worker)
+    {
+        asyncResults.emplace_back(ctx->post2(queueIdRange.first + (int)worker, false,
+            [worker, grid, range, &func](VoidContextPtr ctx)->int
+        {
+            try
+            {
+                for (StealingRange::Range r = range->next(worker); r.first != r.second; r = range->next(worker))
+                {
+                    for (size_t i = r.first; i < r.second; ++i)
+                    {
+                        std::forward<FUNC>(func)(ctx, grid->tile(i));
+                    }
+                }
+            }
+            catch (...)
+            {
+                range->cancel(); //stop all other workers
+                throw;
+            }
+            return 0;
+        }));
+    }
+    joinAll(ctx, asyncResults);
+    return 0;
+}
+
+//Worker body shared by runChunks() and runIoChunks(). Chunks are claimed from a shared cursor until none are left
+//and an error in any worker stops all the others.
+template <class BODY>
+void runChunkWorker(size_t num,
+                    size_t chunkSize,
+                    size_t numChunks,
+                    std::atomic<size_t>& nextChunk,
+                    const BODY& body)
+{
+    try
+    {
+        for (size_t chunk = nextChunk.fetch_add(1); chunk < numChunks; chunk = nextChunk.fetch_add(1))
+        {
+            size_t begin = chunk*chunkSize;
+            body(chunk, begin, std::min(begin + chunkSize, num));
+        }
+    }
+    catch (...)
+    {
+        nextChunk.store(numChunks); //stop all other workers
+        throw;
+    }
+}
+
+template <class BODY>
+void Util::runChunks(VoidContextPtr ctx,
+                     size_t num,
+                     size_t chunkSize,
+                     const BODY& body)
+{
+    const std::pair<int, int>& queueIdRange = ctx->getCoroQueueIdRangeForAny();
+    size_t numQueues = queueIdRange.second - queueIdRange.first + 1;
+    size_t numChunks = (num + chunkSize - 1)/chunkSize;
+    size_t numWorkers = std::min(numQueues, numChunks);
+    auto nextChunk = std::make_shared<std::atomic<size_t>>(0);
+    std::vector<CoroContextPtr<int>> asyncResults;
+    asyncResults.reserve(numWorkers);
+    for (size_t worker = 0; worker < numWorkers; ++worker)
+    {
+        asyncResults.emplace_back(ctx->post2(queueIdRange.first + (int)worker, false,
+            [num, chunkSize, numChunks, nextChunk, &body](VoidContextPtr ctx)->int
+        {
+            runChunkWorker(num, chunkSize, numChunks, *nextChunk, [&ctx, &body](size_t chunk, size_t begin, size_t end)
+            {
+                body(ctx, chunk, begin, end);
+            });
+            return 0;
+        }));
+    }
+    joinAll(ctx, asyncResults);
+}
+
+inline
+size_t chunkSizeOf(VoidContextPtr ctx, size_t num, size_t chunkSize)
+{
+    if (chunkSize)
+    {
+        return chunkSize;
+    }
+    //One chunk per coroutine thread
+    const std::pair<int, int>& queueIdRange = ctx->getCoroQueueIdRangeForAny();
+    size_t numQueues = queueIdRange.second - queueIdRange.first + 1;
+    return std::max((num + numQueues - 1)/numQueues, (size_t)1);
+}
+
+template <class RET, class INPUT_IT, class FUNC>
+std::vector<RET> forEachChunkImpl(VoidContextPtr ctx,
+                                  INPUT_IT first,
+                                  size_t num,
+                                  size_t chunkSize,
+                                  FUNC&& func,
+                                  std::false_type) //non-void
+{
+    static_assert(!std::is_same<RET, bool>::value, "Concurrent writes to std::vector<bool> are not supported");
+    std::vector<RET> results((num + chunkSize - 1)/chunkSize);
+    Util::runChunks(ctx, num, chunkSize, [first, &results, &func](VoidContextPtr ctx, size_t chunk, size_t begin, size_t end)
+    {
+        results[chunk] = std::forward<FUNC>(func)(ctx, first + begin, first + end);
+    });
+    return results;
+}
+
+template <class RET, class INPUT_IT, class FUNC>
+int forEachChunkImpl(VoidContextPtr ctx,
+                     INPUT_IT first,
+                     size_t num,
+                     size_t chunkSize,
+                     FUNC&& func,
+                     std::true_type) //void
+{
+    Util::runChunks(ctx, num, chunkSize, [first, &func](VoidContextPtr ctx, size_t, size_t begin, size_t end)
+    {
+        std::forward<FUNC>(func)(ctx, first + begin, first + end);
+    });
+    return 0;
+}
+
+template <class RET, class INPUT_IT, class FUNC>
+typename Traits::ChunkResults<RET>::Type
+Util::forEachChunkCoro(VoidContextPtr ctx,
+                       INPUT_IT first,
+                       size_t num,
+                       size_t chunkSize,
+                       FUNC&& func)
+{
+    return forEachChunkImpl<RET>(ctx, first, num, chunkSizeOf(ctx, num, chunkSize), std::forward<FUNC>(func),
+                                 std::is_void<RET>());
+}
+
+template <class INPUT_IT, class OUTPUT_IT, class FUNC>
+int Util::forEachChunkOutputCoro(VoidContextPtr ctx,
+                                 INPUT_IT first,
+                                 size_t num,
+                                 size_t chunkSize,
+                                 OUTPUT_IT outFirst,
+                                 FUNC&& func)
+{
+    runChunks(ctx, num, chunkSizeOf(ctx, num, chunkSize), [first, outFirst, &func](VoidContextPtr ctx, size_t, size_t begin, size_t end)
+    {
+        std::forward<FUNC>(func)(ctx, first + begin, first + end, outFirst + begin);
+    });
+    return 0;
+}
+
+template <class BODY>
+void Util::runIoChunks(VoidContextPtr ctx,
+                       size_t num,
+                       size_t chunkSize,
+                       const BODY& body)
+{
+    size_t numChunks = (num + chunkSize - 1)/chunkSize;
+    size_t numWorkers = std::min((size_t)std::max(ctx->getNumIoThreads(), 1), numChunks);
+    auto nextChunk = std::make_shared<std::atomic<size_t>>(0);
+    std::vector<CoroFuturePtr<int>> asyncResults;
+    asyncResults.reserve(numWorkers);
+    for (size_t worker = 0; worker < numWorkers; ++worker)
+    {
+        asyncResults.emplace_back(ctx->postAsyncIo2((int)worker, false,
+            [num, chunkSize, numChunks, nextChunk, &body]()->int
+        {
+            runChunkWorker(num, chunkSize, numChunks, *nextChunk, body);
+            return 0;
+        }));
+    }
+    joinAll(ctx, asyncResults);
+}
+
+inline
+size_t ioChunkSizeOf(VoidContextPtr ctx, size_t num, size_t chunkSize)
+{
+    if (chunkSize)
+    {
+        return chunkSize;
+    }
+    //Blocking calls tend to have uneven latencies so hand out several chunks per IO thread
+    size_t numChunks = 4*std::max(ctx->getNumIoThreads(), 1);
+    return std::max((num + numChunks - 1)/numChunks, (size_t)1);
+}
+
+template <class RET, class INPUT_IT, class FUNC>
+std::vector<RET> forEachAsyncIoImpl(VoidContextPtr ctx,
+                                    INPUT_IT first,
+                                    size_t num,
+                                    size_t chunkSize,
+                                    FUNC&& func,
+                                    std::false_type) //non-void
+{
+    static_assert(!std::is_same<RET, bool>::value, "Concurrent writes to std::vector<bool> are not supported");
+    std::vector<RET> results(num);
+    Util::runIoChunks(ctx, num, chunkSize, [first, &results, &func](size_t, size_t begin, size_t end)
+    {
+        INPUT_IT it = first + begin;
+        for (size_t i = begin; i < end; ++i, ++it)
+        {
+            results[i] = std::forward<FUNC>(func)(*it);
+        }
+    });
+    return results;
+}
+
+template <class RET, class INPUT_IT, class FUNC>
+int forEachAsyncIoImpl(VoidContextPtr ctx,
+                       INPUT_IT first,
+                       size_t num,
+                       size_t chunkSize,
+                       FUNC&& func,
+                       std::true_type) //void
+{
+    Util::runIoChunks(ctx, num, chunkSize, [first, &func](size_t, size_t begin, size_t end)
+    {
+        INPUT_IT it = first + begin;
+        for (size_t i = begin; i < end; ++i, ++it)
+        {
+            std::forward<FUNC>(func)(*it);
+        }
+    });
+    return 0;
+}
+
+template <class RET, class INPUT_IT, class FUNC>
+typename Traits::ChunkResults<RET>::Type
+Util::forEachAsyncIoCoro(VoidContextPtr ctx,
+                         INPUT_IT first,
+                         size_t num,
+                         size_t chunkSize,
+                         FUNC&& func)
+{
+    return forEachAsyncIoImpl<RET>(ctx, first, num, ioChunkSizeOf(ctx, num, chunkSize), std::forward<FUNC>(func),
+                                   std::is_void<RET>());
+}
+
+template <class T, class INPUT_IT, class REDUCE_FUNC, class TRANSFORM_FUNC>
+T Util::transformReduceCoro(VoidContextPtr ctx,
+                            INPUT_IT first,
+                            size_t num,
+                            T init,
+                            const REDUCE_FUNC& reduceFunc,
+                            const TRANSFORM_FUNC& transformFunc,
+                            size_t grainSize)
+{
+    if (num == 0)
+    {
+        return init;
+    }
+    if (grainSize == 0)
+    {
+        //Create a few leaves per coroutine thread to absorb uneven costs
+        grainSize = std::max(num/(4*std::max(ctx->getNumCoroutineThreads(), 1)), (size_t)1);
+    }
+    return reduceFunc(init, treeReduceCoro<T>(ctx, first, num, reduceFunc, transformFunc, grainSize));
+}
+
+template <class T, class INPUT_IT, class REDUCE_FUNC, class TRANSFORM_FUNC>
+T Util::treeReduceCoro(VoidContextPtr ctx,
+                       INPUT_IT first,
+                       size_t num,
+                       const REDUCE_FUNC& reduceFunc,
+                       const TRANSFORM_FUNC& transformFunc,
+                       size_t grainSize)
+{
+    if (num <= grainSize)
+    {
+        T result = transformFunc(*first);
+        for (size_t i = 1; i < num; ++i)
+        {
+            result = reduceFunc(result, transformFunc(*++first));
+        }
+        return result;
+    }
+    size_t half = num/2;
+    CoroContextPtr<T> left = ctx->template post2([first, half, grainSize, &reduceFunc, &transformFunc](VoidContextPtr ctx)->T
+    {
+        return treeReduceCoro<T>(ctx, first, half, reduceFunc, transformFunc, grainSize);
+    });
+    std::exception_ptr error;
+    try
+    {
+        T right = treeReduceCoro<T>(ctx, std::next(first, half), num - half, reduceFunc, transformFunc, grainSize);
+        return reduceFunc(left->get(ctx), right);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    //The left half references the reduce and transform functions. Wait outside the handler since
+    //this coroutine may resume on another thread which does not share the active exception.
+    left->wait(ctx);
+    std::rethrow_exception(error);
+}
+
+template <class T, class INPUT_IT, class FUNC>
+std::vector<T>
+Util::scanCoro(VoidContextPtr ctx,
+               INPUT_IT first,
+               size_t num,
+               T init,
+               const FUNC& func,
+               bool isInclusive)
+{
+    std::vector<T> results(num);
+    if (num == 0)
+    {
+        return results;
+    }
+    size_t numChunks = std::min((size_t)std::max(ctx->getNumCoroutineThreads(), 1), num);
+    std::vector<std::pair<size_t, size_t>> chunks; //[begin, end) offsets
+    chunks.reserve(numChunks);
+    for (size_t i = 0, begin = 0; i < numChunks; ++i)
+    {
+        size_t end = begin + num/numChunks + ((i < num%numChunks) ? 1 : 0);
+        chunks.emplace_back(begin, end);
+        begin = end;
+    }
+    
+    // Up-sweep : reduce every chunk except the last one in parallel
+    std::vector<CoroContextPtr<T>> totals;
+    totals.reserve(numChunks - 1);
+    for (size_t i = 0; i + 1 < numChunks; ++i)
+    {
+        INPUT_IT chunkFirst = std::next(first, chunks[i].first);
+        size_t chunkSize = chunks[i].second - chunks[i].first;
+        totals.emplace_back(ctx->template post2([chunkFirst, chunkSize, &func](VoidContextPtr)->T
+        {
+            INPUT_IT it = chunkFirst;
+            T total = *it;
+            for (size_t j = 1; j < chunkSize; ++j)
+            {
+                total = func(total, *++it);
+            }
+            return total;
+        }));
+    }
+    std::vector<T> carries = joinAll(ctx, totals);
+    
+    // Combine the chunk totals into the value carried into each chunk. Only the first chunk of an inclusive
+    // scan has no carry.
+    for (size_t i = 0; i < carries.size(); ++i)
+    {
+        if (i > 0)
+        {
+            carries[i] = func(carries[i-1], carries[i]);
+        }
+        else if (!isInclusive)
+        {
+            carries[i] = func(init, carries[i]);
+        }
+    }
+    carries.insert(carries.begin(), init);
+    
+    // Down-sweep : scan every chunk in parallel starting from its carry
+    std::vector<CoroContextPtr<int>> scans;
+    scans.reserve(numChunks);
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+        scans.emplace_back(ctx->template post2([i, first, isInclusive, &chunks, &carries, &results, &func](VoidContextPtr)->int
+        {
+            INPUT_IT it = std::next(first, chunks[i].first);
+            size_t j = chunks[i].first;
+            if (isInclusive)
+            {
+                T current = (i == 0) ? T(*it) : func(carries[i], *it);
+                results[j] = current;
+                for (++j, ++it; j < chunks[i].second; ++j, ++it)
+                {
+                    current = func(current, *it);
+                    results[j] = current;
+                }
+            }
+            else
+            {
+                T current = carries[i];
+                for (; j < chunks[i].second; ++j, ++it)
+                {
+                    results[j] = current;
+                    current = func(current, *it);
+                }
+            }
+            return 0;
+        }));
+    }
+    joinAll(ctx, scans);
+    return results;
+}
+
+//==============================================================================================
+//                                      Sort Helpers
+//==============================================================================================
+/// Returns how many of the first 'pos' elements of the stable merge of [a, a+lenA) and [b, b+lenB) come from 'a'.
+template <class IT, class COMPARE>
+size_t sortCoRank(IT a, size_t lenA, IT b, size_t lenB, size_t pos, const COMPARE& compare)
+{
+    size_t low = (pos > lenB) ? pos - lenB : 0;
+    size_t high = std::min(pos, lenA);
+    while (low < high)
+    {
+        size_t i = low + (high - low)/2;
+        if (!compare(b[pos-i-1], a[i]))
+        {
+            low = i + 1; //a[i] is merged before b[pos-i-1]
+        }
+        else
+        {
+            high = i;
+        }
+    }
+    return low;
+}
+
+/// Merges pairs of consecutive sorted runs from 'src' into 'dst' and returns the bounds of the merged runs.
+template <class SRC_IT, class DST_IT, class COMPARE>
+std::vector<size_t> sortMergeRound(VoidContextPtr ctx,
+                                   SRC_IT src,
+                                   DST_IT dst,
+                                   const std::vector<size_t>& bounds,
+                                   const COMPARE& compare,
+                                   size_t numPieces)
+{
+    size_t num = bounds.back();
+    std::vector<size_t> merged;
+    merged.reserve(bounds.size()/2 + 2);
+    //Split every merge before starting any of them since the merges move elements out of 'src'
+    struct Piece
+    {
+        size_t _begin, _middle, _from, _to, _fromA, _toA;
+    };
+    std::vector<Piece> pieces;
+    for (size_t run = 0; run + 1 < bounds.size(); run += 2)
+    {
+        //a trailing run without a pair is merged with an empty one i.e. moved
+        size_t begin = bounds[run];
+        size_t middle = bounds[run+1];
+        size_t end = (run + 2 < bounds.size()) ? bounds[run+2] : middle;
+        size_t numRunPieces = std::max((size_t)1, numPieces*(end - begin)/num);
+        size_t from = 0;
+        size_t fromA = 0;
+        merged.push_back(begin);
+        for (size_t piece = 1; piece <= numRunPieces; ++piece)
+        {
+            size_t to = (end - begin)*piece/numRunPieces;
+            size_t toA = sortCoRank(src + begin, middle - begin, src + middle, end - middle, to, compare);
+            pieces.push_back({begin, middle, from, to, fromA, toA});
+            from = to;
+            fromA = toA;
+        }
+    }
+    std::vector<CoroContextPtr<int>> asyncResults;
+    asyncResults.reserve(pieces.size());
+    for (const Piece& piece : pieces)
+    {
+        asyncResults.emplace_back(ctx->template post2([src, dst, piece, &compare](VoidContextPtr)->int
+        {
+            std::merge(std::make_move_iterator(src + piece._begin + piece._fromA),
+                       std::make_move_iterator(src + piece._begin + piece._toA),
+                       std::make_move_iterator(src + piece._middle + (piece._from - piece._fromA)),
+                       std::make_move_iterator(src + piece._middle + (piece._to - piece._toA)),
+                       dst + piece._begin + piece._from,
+                       compare);
+            return 0;
+        }));
+    }
+    merged.push_back(num);
+    joinAll(ctx, asyncResults);
+    return merged;
+}
+
+template <class RANDOM_IT, class COMPARE>
+int Util::sortCoro(VoidContextPtr ctx,
+                   RANDOM_IT first,
+                   size_t num,
+                   const COMPARE& compare,
+                   bool isStable)
+{
+    using T = typename std::iterator_traits<RANDOM_IT>::value_type;
+    //Below this size splitting the range costs more than it saves
+    const size_t minChunkSize = 1024;
+    size_t numChunks = std::min((size_t)std::max(ctx->getNumCoroutineThreads(), 1), num/minChunkSize);
+    if (numChunks <= 1)
+    {
+        if (isStable)
+        {
+            std::stable_sort(first, first + num, compare);
+        }
+        else
+        {
+            std::sort(first, first + num, compare);
+        }
+        return 0;
+    }
+    
+    // Sort each chunk in parallel
+    std::vector<size_t> bounds;
+    bounds.reserve(numChunks + 1);
+    std::vector<CoroContextPtr<int>> asyncResults;
+    asyncResults.reserve(numChunks);
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+        size_t begin = num*i/numChunks;
+        size_t end = num*(i + 1)/numChunks;
+        bounds.push_back(begin);
+        asyncResults.emplace_back(ctx->template post2([first, begin, end, isStable, &compare](VoidContextPtr)->int
+        {
+            if (isStable)
+            {
+                std::stable_sort(first + begin, first + end, compare);
+            }
+            else
+            {
+                std::sort(first + begin, first + end, compare);
+            }
+            return 0;
+        }));
+    }
+    bounds.push_back(num);
+    joinAll(ctx, asyncResults);
+    
+    // Merge the sorted runs, alternating between the input range and a temporary buffer
+    std::vector<T> buffer(num);
+    bool inBuffer = false;
+    while (bounds.size() > 2)
+    {
+        bounds = inBuffer ? sortMergeRound(ctx, buffer.begin(), first, bounds, compare, numChunks) :
+                            sortMergeRound(ctx, first, buffer.begin(), bounds, compare, numChunks);
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer)
+    {
+        asyncResults.clear();
+        for (size_t i = 0; i < numChunks; ++i)
+        {
+            size_t begin = num*i/numChunks;
+            size_t end = num*(i + 1)/numChunks;
+            asyncResults.emplace_back(ctx->template post2([first, begin, end, &buffer](VoidContextPtr)->int
+            {
+                std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+                return 0;
+            }));
+        }
+        joinAll(ctx, asyncResults);
+    }
+    return 0;
+}
+
+//==============================================================================================
+//                                      Shuffle Helpers
+//==============================================================================================
+template <class KEY>
+size_t shufflePartitionOf(const KEY& key, size_t numPartitions, std::true_type)
+{
+    return std::hash<KEY>()(key) % numPartitions;
+}
+
+template <class KEY>
+size_t shufflePartitionOf(const KEY&, size_t, std::false_type)
+{
+    return 0;
+}
+
+template <class SOURCE>
+auto streamPull(const SOURCE& source, ICoroSync::Ptr sync, bool& isBufferClosed)->
+    decltype(source->pull(sync, isBufferClosed))
+{
+    return source->pull(sync, isBufferClosed);
+}
+
+template <class T>
+T streamPull(const std::shared_ptr<IThreadContext<Buffer<T>>>& source, ICoroSync::Ptr sync, bool& isBufferClosed)
+{
+    //thread contexts are always implemented by a Context which can also be pulled from a coroutine
+    return std::static_pointer_cast<Context<Buffer<T>>>(source)->pull(sync, isBufferClosed);
+}
+
+template <class KEY, class MAPPED_TYPE, class INDEX>
+void shuffleCombine(INDEX& index,
+                    std::pair<KEY, MAPPED_TYPE>&& mapperResult,
+                    const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner)
+{
+    auto it = index.find(mapperResult.first);
+    if (it == index.end())
+    {
+        index.emplace(std::move(mapperResult.first), std::move(mapperResult.second));
+    }
+    else
+    {
+        it->second = combiner(it->first, std::move(it->second), std::move(mapperResult.second));
+    }
+}
+
+template <class KEY, class MAPPED_TYPE, class OUTPUT, class MAPPER_OUTPUT_IT>
+std::vector<std::vector<std::pair<KEY, MAPPED_TYPE>>>
+shuffleScatter(MAPPER_OUTPUT_IT first,
+               MAPPER_OUTPUT_IT last,
+               size_t numPartitions,
+               const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner)
+{
+    using IsHashable = MapReduceOutput::IsHashable<KEY>;
+    std::vector<std::vector<std::pair<KEY, MAPPED_TYPE>>> partitions(numPartitions);
+    if (!combiner)
+    {
+        for (; first != last; ++first)
+        {
+            for (auto&& mapperResult : *first)
+            {
+                size_t partition = shufflePartitionOf(mapperResult.first, numPartitions, IsHashable{});
+                partitions[partition].emplace_back(std::move(mapperResult));
+            }
+        }
+        return partitions;
+    }
+    //Pre-reduce all the values mapped to the same key in this chunk so that less data gets shuffled
+    typename OUTPUT::template Index<KEY, MAPPED_TYPE> combined;
+    for (; first != last; ++first)
+    {
+        for (auto&& mapperResult : *first)
+        {
+            shuffleCombine(combined, std::move(mapperResult), combiner);
+        }
+    }
+    for (auto&& combinedResult : combined)
+    {
+        size_t partition = shufflePartitionOf(combinedResult.first, numPartitions, IsHashable{});
+        partitions[partition].emplace_back(combinedResult.first, std::move(combinedResult.second));
+    }
+    return partitions;
+}
+
+template <class KEY, class VALUE, class EMIT>
+void shuffleMergeSorted(std::vector<std::vector<std::pair<KEY, VALUE>>>& runs, EMIT&& emit)
+{
+    //Keys are unique across all runs since each key belongs to a single partition
+    using Cursor = std::pair<size_t, size_t>; //run, position
+    auto isAfter = [&runs](const Cursor& lhs, const Cursor& rhs)->bool
+    {
+        return runs[rhs.first][rhs.second].first < runs[lhs.first][lhs.second].first;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(isAfter)> heap(isAfter);
+    for (size_t run = 0; run < runs.size(); ++run)
+    {
+        if (!runs[run].empty())
+        {
+            heap.emplace(run, 0);
+        }
+    }
+    while (!heap.empty())
+    {
+        Cursor cursor = heap.top();
+        heap.pop();
+        emit(std::move(runs[cursor.first][cursor.second]));
+        if (++cursor.second < runs[cursor.first].size())
+        {
+            heap.push(cursor);
+        }
+    }
+}
+
+template <class KEY, class VALUE>
+std::map<KEY, VALUE>
+shuffleAssemble(MapReduceOutput::Ordered, std::vector<std::vector<std::pair<KEY, VALUE>>>& runs)
+{
+    std::map<KEY, VALUE> output;
+    shuffleMergeSorted(runs, [&output](std::pair<KEY, VALUE>&& result)
+    {
+        output.emplace_hint(output.end(), std::move(result));
+    });
+    return output;
+}
+
+template <class KEY, class VALUE>
+std::vector<std::pair<KEY, VALUE>>
+shuffleAssemble(MapReduceOutput::Sorted, std::vector<std::vector<std::pair<KEY, VALUE>>>& runs)
+{
+    size_t size = 0;
+    for (auto&& run : runs)
+    {
+        size += run.size();
+    }
+    std::vector<std::pair<KEY, VALUE>> output;
+    output.reserve(size);
+    shuffleMergeSorted(runs, [&output](std::pair<KEY, VALUE>&& result)
+    {
+        output.emplace_back(std::move(result));
+    });
+    return output;
+}
+
+template <class KEY, class VALUE>
+std::unordered_map<KEY, VALUE>
+shuffleAssemble(MapReduceOutput::Unordered, std::vector<std::vector<std::pair<KEY, VALUE>>>& runs)
+{
+    size_t size = 0;
+    for (auto&& run : runs)
+    {
+        size += run.size();
+    }
+    std::unordered_map<KEY, VALUE> output;
+    output.reserve(size);
+    for (auto&& run : runs)
+    {
+        for (auto&& result : run)
+        {
+            output.emplace(std::move(result));
+        }
+    }
+    return output;
+}
+
+//==============================================================================================
+//                                      MapReduce
+//==============================================================================================
+template <class KEY,
+          class MAPPED_TYPE,
+          class REDUCED_TYPE,
+          class OUTPUT,
+          class MAPPER_OUTPUT_IT>
+typename OUTPUT::template Container<KEY, REDUCED_TYPE>
+Util::shuffleReduceCoro(VoidContextPtr ctx,
+                        const std::vector<std::pair<MAPPER_OUTPUT_IT, MAPPER_OUTPUT_IT>>& mapperOutputs,
+                        const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                        const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner,
+                        bool reduceInBatch)
+{
+    static_assert(!std::is_same<OUTPUT, MapReduceOutput::Unordered>::value || MapReduceOutput::IsHashable<KEY>::value,
+                  "Unordered map-reduce output requires a hashable key");
+    // Typedefs
+    using MappedResult = std::pair<KEY, MAPPED_TYPE>;
+    using Partitions = std::vector<std::vector<MappedResult>>;
+    using IndexerOutput = typename OUTPUT::template Index<KEY, std::vector<MAPPED_TYPE>>;
+    using IndexerEntry = typename IndexerOutput::value_type;
+    using ReducedResult = std::pair<KEY, REDUCED_TYPE>;
+    using ReducedResults = std::vector<ReducedResult>;
+    
+    size_t numPartitions = MapReduceOutput::IsHashable<KEY>::value ?
+                           std::max(ctx->getNumCoroutineThreads(), 1) : 1;
+    
+    // Scatter stage : each chunk of mapper outputs is split into partitions
+    std::vector<CoroContextPtr<Partitions>> scatterResults;
+    scatterResults.reserve(mapperOutputs.size());
+    for (auto&& chunk : mapperOutputs)
+    {
+        scatterResults.emplace_back(ctx->template post2([chunk, numPartitions, &combiner](VoidContextPtr)->Partitions
+        {
+            return shuffleScatter<KEY, MAPPED_TYPE, OUTPUT>(chunk.first, chunk.second, numPartitions, combiner);
+        }));
+    }
+    std::vector<Partitions> scattered = joinAll(ctx, scatterResults);
+    
+    // Gather and reduce stage : each partition is indexed and reduced independently
+    std::vector<CoroContextPtr<ReducedResults>> reduceResults;
+    reduceResults.reserve(numPartitions);
+    for (size_t partition = 0; partition < numPartitions; ++partition)
+    {
+        reduceResults.emplace_back(ctx->template post2([partition, reduceInBatch, &scattered, &reducer](VoidContextPtr ctx)->ReducedResults
+        {
+            IndexerOutput indexerOutput;
+            for (auto&& chunk : scattered)
+            {
+                for (auto&& mapperResult : chunk[partition])
+                {
+                    indexerOutput[std::move(mapperResult.first)].emplace_back(std::move(mapperResult.second));
+                }
+            }
+            if (reduceInBatch)
+            {
+                ReducedResults reducedResults;
+                reducedResults.reserve(indexerOutput.size());
+                for (auto&& entry : indexerOutput)
+                {
+                    reducedResults.emplace_back(reducer(ctx, std::make_pair(entry.first, std::move(entry.second))));
+                }
+                return reducedResults;
+            }
+            return ctx->forEach(indexerOutput.begin(), indexerOutput.size(),
+                [&reducer](VoidContextPtr ctx, IndexerEntry& entry)->ReducedResult
+            {
+                return reducer(ctx, std::make_pair(entry.first, std::move(entry.second)));
+            })->get(ctx);
+        }));
+    }
+    std::vector<ReducedResults> reduced = joinAll(ctx, reduceResults);
+    
+    // Assemble the output
+    return shuffleAssemble(OUTPUT{}, reduced);
+}
+
 template <class KEY,
           class MAPPED_TYPE,
           class REDUCED_TYPE,
-          class INPUT_IT>
-std::map<KEY, REDUCED_TYPE>
+          class INPUT_IT,
+          class OUTPUT>
+typename OUTPUT::template Container<KEY, REDUCED_TYPE>
 Util::mapReduceCoro(VoidContextPtr ctx,
                     INPUT_IT inputIt,
                     size_t num,
                     const Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
-                    const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer)
+                    const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                    const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner)
 {
     // Typedefs
     using MappedResult = std::pair<KEY, MAPPED_TYPE>;
     using MapperOutput = std::vector<MappedResult>;
     using IndexerInput = std::vector<MapperOutput>;
-    using IndexerOutput = std::map<KEY, std::vector<MAPPED_TYPE>>;
-    using ReducedResult = std::pair<KEY, REDUCED_TYPE>;
-    using ReducedResults = std::vector<ReducedResult>;
-    using ReducerOutput = std::map<KEY, REDUCED_TYPE>;
+    using MapperOutputIt = typename IndexerInput::iterator;
     
     // Map stage
     IndexerInput indexerInput = ctx->forEach(inputIt, num, mapper)->get(ctx);
     
-    // Index stage
-    IndexerOutput indexerOutput;
-    for (auto&& mapperOutput : indexerInput)
+    // Split the mapper outputs into one chunk per coroutine thread
+    size_t numChunks = std::min((size_t)std::max(ctx->getNumCoroutineThreads(), 1), indexerInput.size());
+    std::vector<std::pair<MapperOutputIt, MapperOutputIt>> chunks;
+    chunks.reserve(numChunks);
+    MapperOutputIt chunkBegin = indexerInput.begin();
+    for (size_t i = 0; i < numChunks; ++i)
     {
-        for (auto&& mapperResult : mapperOutput) {
-            indexerOutput[std::move(mapperResult.first)].emplace_back(std::move(mapperResult.second));
-        }
-    }
-    
-    // Reduce stage
-    ReducedResults reducedResults = ctx->forEach
-        (indexerOutput.begin(), indexerOutput.size(), reducer)->get(ctx);
-    
-    ReducerOutput reducerOutput;
-    for (auto&& reducedResult : reducedResults)
-    {
-        reducerOutput.emplace(std::move(reducedResult.first), std::move(reducedResult.second));
+        size_t chunkSize = indexerInput.size()/numChunks + ((i < indexerInput.size()%numChunks) ? 1 : 0);
+        chunks.emplace_back(chunkBegin, chunkBegin + chunkSize);
+        chunkBegin += chunkSize;
     }
     
-    return reducerOutput;
+    // Shuffle and reduce stages
+    return shuffleReduceCoro<KEY, MAPPED_TYPE, REDUCED_TYPE, OUTPUT>(ctx, chunks, reducer, combiner, false);
 }
 
 template <class KEY,
           class MAPPED_TYPE,
           class REDUCED_TYPE,
-          class INPUT_IT>
-std::map<KEY, REDUCED_TYPE>
+          class INPUT_IT,
+          class OUTPUT>
+typename OUTPUT::template Container<KEY, REDUCED_TYPE>
 Util::mapReduceBatchCoro(VoidContextPtr ctx,
                          INPUT_IT inputIt,
                          size_t num,
                          const Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
-                         const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer)
+                         const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                         const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner)
 {
     // Typedefs
     using MappedResult = std::pair<KEY, MAPPED_TYPE>;
     using MapperOutput = std::vector<MappedResult>;
     using IndexerInput = std::vector<std::vector<MapperOutput>>;
-    using IndexerOutput = std::map<KEY, std::vector<MAPPED_TYPE>>;
-    using ReducedResult = std::pair<KEY, REDUCED_TYPE>;
-    using ReducedResults = std::vector<std::vector<ReducedResult>>;
-    using ReducerOutput = std::map<KEY, REDUCED_TYPE>;
+    using MapperOutputIt = typename std::vector<MapperOutput>::iterator;
     
     // Map stage
     IndexerInput indexerInput = ctx->forEachBatch(inputIt, num, mapper)->get(ctx);
     
-    // Index stage
-    IndexerOutput indexerOutput;
+    // Each batch of mapper outputs is shuffled as one chunk
+    std::vector<std::pair<MapperOutputIt, MapperOutputIt>> chunks;
+    chunks.reserve(indexerInput.size());
     for (auto&& partialMapOutput : indexerInput)
     {
-        for (auto&& mapperOutput : partialMapOutput)
+        chunks.emplace_back(partialMapOutput.begin(), partialMapOutput.end());
+    }
+    
+    // Shuffle and reduce stages
+    return shuffleReduceCoro<KEY, MAPPED_TYPE, REDUCED_TYPE, OUTPUT>(ctx, chunks, reducer, combiner, true);
+}
+
+template <class KEY,
+          class MAPPED_TYPE,
+          class REDUCED_TYPE,
+          class INPUT_IT,
+          class OUTPUT>
+typename OUTPUT::template Container<KEY, REDUCED_TYPE>
+Util::mapReduceAsyncIoCoro(VoidContextPtr ctx,
+                           INPUT_IT inputIt,
+                           size_t num,
+                           const Functions::IoMapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
+                           const Functions::IoReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                           const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner,
+                           size_t chunkSize)
+{
+    static_assert(!std::is_same<OUTPUT, MapReduceOutput::Unordered>::value || MapReduceOutput::IsHashable<KEY>::value,
+                  "Unordered map-reduce output requires a hashable key");
+    // Typedefs
+    using MappedResult = std::pair<KEY, MAPPED_TYPE>;
+    using MapperOutput = std::vector<MappedResult>;
+    using Partitions = std::vector<std::vector<MappedResult>>;
+    using IndexerOutput = typename OUTPUT::template Index<KEY, std::vector<MAPPED_TYPE>>;
+    using ReducedResults = std::vector<std::pair<KEY, REDUCED_TYPE>>;
+    
+    size_t numPartitions = MapReduceOutput::IsHashable<KEY>::value ?
+                           std::max(ctx->getNumIoThreads(), 1) : 1;
+    chunkSize = ioChunkSizeOf(ctx, num, chunkSize);
+    
+    // Map and scatter stage : each chunk is mapped and split into partitions by the same IO worker
+    std::vector<Partitions> scattered((num + chunkSize - 1)/chunkSize);
+    runIoChunks(ctx, num, chunkSize, [inputIt, numPartitions, &scattered, &mapper, &combiner](size_t chunk, size_t begin, size_t end)
+    {
+        std::vector<MapperOutput> mapperOutputs;
+        mapperOutputs.reserve(end - begin);
+        INPUT_IT it = inputIt + begin;
+        for (size_t i = begin; i < end; ++i, ++it)
+        {
+            mapperOutputs.emplace_back(mapper(*it));
+        }
+        scattered[chunk] = shuffleScatter<KEY, MAPPED_TYPE, OUTPUT>(mapperOutputs.begin(), mapperOutputs.end(),
+                                                                    numPartitions, combiner);
+    });
+    
+    // Gather and reduce stage : each partition is indexed and reduced by a single IO worker
+    std::vector<ReducedResults> reduced(numPartitions);
+    runIoChunks(ctx, numPartitions, 1, [&scattered, &reduced, &reducer](size_t partition, size_t, size_t)
+    {
+        IndexerOutput indexerOutput;
+        for (auto&& chunk : scattered)
         {
-            for (auto&& mapperResult : mapperOutput) {
+            for (auto&& mapperResult : chunk[partition])
+            {
                 indexerOutput[std::move(mapperResult.first)].emplace_back(std::move(mapperResult.second));
             }
         }
+        ReducedResults& reducedResults = reduced[partition];
+        reducedResults.reserve(indexerOutput.size());
+        for (auto&& entry : indexerOutput)
+        {
+            reducedResults.emplace_back(reducer(std::make_pair(entry.first, std::move(entry.second))));
+        }
+    });
+    
+    // Assemble the output
+    return shuffleAssemble(OUTPUT{}, reduced);
+}
+
+template <class KEY,
+          class MAPPED_TYPE,
+          class RECORD,
+          class SOURCE,
+          class OUTPUT>
+typename OUTPUT::template Container<KEY, MAPPED_TYPE>
+Util::mapReduceStreamCoro(VoidContextPtr ctx,
+                          SOURCE source,
+                          const Functions::StreamMapFunc<KEY, MAPPED_TYPE, RECORD>& mapper,
+                          const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner,
+                          size_t batchSize)
+{
+    static_assert(!std::is_same<OUTPUT, MapReduceOutput::Unordered>::value || MapReduceOutput::IsHashable<KEY>::value,
+                  "Unordered map-reduce output requires a hashable key");
+    if (!source)
+    {
+        throw std::runtime_error("Source pointer is null");
+    }
+    if (!combiner)
+    {
+        throw std::runtime_error("Combiner function is required");
     }
+    // Typedefs
+    using IsHashable = MapReduceOutput::IsHashable<KEY>;
+    using MappedResult = std::pair<KEY, MAPPED_TYPE>;
+    using Aggregates = typename OUTPUT::template Index<KEY, MAPPED_TYPE>;
+    using Partitions = std::vector<Aggregates>;
+    using Batch = std::vector<RECORD>;
     
-    // Reduce stage
-    ReducedResults reducedResults = ctx->forEachBatch
-        (indexerOutput.begin(), indexerOutput.size(), reducer)->get(ctx);
+    size_t numSlots = std::max(ctx->getNumCoroutineThreads(), 1);
+    size_t numPartitions = IsHashable::value ? numSlots : 1;
+    batchSize = (batchSize == 0) ? 64 : batchSize;
     
-    ReducerOutput reducerOutput;
-    for (auto&& partialReducedResult : reducedResults)
+    // Map and combine stage : each slot owns its aggregates and processes at most one batch at a time
+    std::vector<Partitions> slots(numSlots, Partitions(numPartitions));
+    std::vector<CoroContextPtr<int>> pending(numSlots);
+    size_t slot = 0;
+    Batch batch;
+    batch.reserve(batchSize);
+    auto dispatch = [&]()
+    {
+        CoroContextPtr<int> previous = std::move(pending[slot]);
+        if (previous)
+        {
+            previous->get(ctx); //wait until the slot is free
+        }
+        pending[slot] = ctx->template post2([batch = std::move(batch), &aggregates = slots[slot], &mapper, &combiner,
+                                             numPartitions](VoidContextPtr ctx)->int
+        {
+            for (auto&& record : batch)
+            {
+                for (auto&& mapperResult : mapper(ctx, record))
+                {
+                    size_t partition = shufflePartitionOf(mapperResult.first, numPartitions, IsHashable{});
+                    shuffleCombine(aggregates[partition], std::move(mapperResult), combiner);
+                }
+            }
+            return 0;
+        });
+        batch = Batch();
+        batch.reserve(batchSize);
+        slot = (slot + 1) % numSlots;
+    };
+    std::exception_ptr error;
+    try
+    {
+        bool isBufferClosed = false;
+        while (true)
+        {
+            RECORD record = streamPull(source, ctx, isBufferClosed);
+            if (isBufferClosed)
+            {
+                break;
+            }
+            batch.emplace_back(std::move(record));
+            if (batch.size() == batchSize)
+            {
+                dispatch();
+            }
+        }
+        if (!batch.empty())
+        {
+            dispatch();
+        }
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    if (error)
+    {
+        //the slots reference this frame so they must complete before unwinding
+        for (auto&& asyncResult : pending)
+        {
+            if (asyncResult)
+            {
+                asyncResult->wait(ctx);
+            }
+        }
+        std::rethrow_exception(error);
+    }
+    std::vector<CoroContextPtr<int>> asyncResults;
+    for (auto&& asyncResult : pending)
     {
-        for (auto&& reducedResult : partialReducedResult)
+        if (asyncResult)
         {
-            reducerOutput.emplace(std::move(reducedResult.first), std::move(reducedResult.second));
+            asyncResults.emplace_back(std::move(asyncResult));
         }
     }
+    joinAll(ctx, asyncResults);
+    
+    // Merge stage : the aggregates of each partition are merged across all slots
+    std::vector<CoroContextPtr<std::vector<MappedResult>>> mergeResults;
+    mergeResults.reserve(numPartitions);
+    for (size_t partition = 0; partition < numPartitions; ++partition)
+    {
+        mergeResults.emplace_back(ctx->template post2([partition, &slots, &combiner](VoidContextPtr)->std::vector<MappedResult>
+        {
+            Aggregates& merged = slots.front()[partition];
+            for (size_t slot = 1; slot < slots.size(); ++slot)
+            {
+                Aggregates aggregates = std::move(slots[slot][partition]);
+                for (auto&& entry : aggregates)
+                {
+                    shuffleCombine(merged, MappedResult(entry.first, std::move(entry.second)), combiner);
+                }
+            }
+            std::vector<MappedResult> run;
+            run.reserve(merged.size());
+            for (auto&& entry : merged)
+            {
+                run.emplace_back(entry.first, std::move(entry.second));
+            }
+            Aggregates().swap(merged);
+            return run;
+        }));
+    }
+    std::vector<std::vector<MappedResult>> merged = joinAll(ctx, mergeResults);
     
-    return reducerOutput;
+    // Assemble the output
+    return shuffleAssemble(OUTPUT{}, merged);
 }
 
 template <typename RET>
@@ -16,6 +16,7 @@
 #ifndef BLOOMBERG_QUANTUM_LOCAL_VARIABLE_GUARD_H
 #define BLOOMBERG_QUANTUM_LOCAL_VARIABLE_GUARD_H
 
+#include <quantum/quantum_local.h>
 #include <string>
 
 namespace Bloomberg {
@@ -37,6 +38,10 @@ public:
     // @param[in] key variable name
     // @param[in] value value to be saved to the variable with the name @see key
     VariableGuard(const std::string& key, T* value);
+    // @brief Constructs an instance of guard saving a value into a coro-local-storage variable.
+    // @param[in] slot variable slot as returned by registerSlot()
+    // @param[in] value value to be saved to the variable in @see slot
+    VariableGuard(Slot slot, T* value);
     // @brief Destroys the guard instance recovering the previous variable value
     ~VariableGuard();
 
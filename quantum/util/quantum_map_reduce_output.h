@@ -0,0 +1,76 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_MAP_REDUCE_OUTPUT_H
+#define BLOOMBERG_QUANTUM_MAP_REDUCE_OUTPUT_H
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                 struct MapReduceOutput
+//==============================================================================================
+/// @struct MapReduceOutput
+/// @brief Selects the container returned by mapReduce() and mapReduceBatch().
+/// @details Each tag also selects the container used to index the mapped values inside each
+///          shuffle partition.
+struct MapReduceOutput
+{
+    /// @brief Results are returned in an std::map. This is the default.
+    struct Ordered
+    {
+        template <class KEY, class VALUE>
+        using Container = std::map<KEY, VALUE>;
+        template <class KEY, class VALUE>
+        using Index = std::map<KEY, VALUE>;
+    };
+    
+    /// @brief Results are returned in an std::unordered_map. KEY must be hashable.
+    struct Unordered
+    {
+        template <class KEY, class VALUE>
+        using Container = std::unordered_map<KEY, VALUE>;
+        template <class KEY, class VALUE>
+        using Index = std::unordered_map<KEY, VALUE>;
+    };
+    
+    /// @brief Results are returned in an std::vector of key-value pairs, sorted by key.
+    struct Sorted
+    {
+        template <class KEY, class VALUE>
+        using Container = std::vector<std::pair<KEY, VALUE>>;
+        template <class KEY, class VALUE>
+        using Index = std::map<KEY, VALUE>;
+    };
+    
+    /// @brief Indicates if the mapped keys can be hash-partitioned between coroutine threads.
+    ///        Keys which cannot be hashed are indexed in a single partition.
+    template <class KEY, class = void>
+    struct IsHashable : std::false_type {};
+    
+    template <class KEY>
+    struct IsHashable<KEY, decltype((void)std::hash<KEY>()(std::declval<const KEY&>()))> : std::true_type {};
+};
+
+}}
+
+#endif //BLOOMBERG_QUANTUM_MAP_REDUCE_OUTPUT_H
@@ -0,0 +1,355 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_PIPELINE_H
+#define BLOOMBERG_QUANTUM_PIPELINE_H
+
+#include <quantum/quantum_dispatcher.h>
+#include <quantum/util/quantum_pipeline_configuration.h>
+#include <quantum/util/quantum_pipeline_queue.h>
+#include <quantum/util/quantum_pipeline_statistics.h>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Bloomberg {
+namespace quantum {
+
+/// @brief An item flowing through a pipeline, tagged with the order in which it entered the pipeline.
+template <class T>
+using PipelineItem = std::pair<size_t, T>;
+
+/// @brief The queue type feeding a stage which consumes values of type T.
+template <class T>
+struct PipelineQueueOf
+{
+    using Ptr = typename PipelineQueue<PipelineItem<T>>::Ptr;
+};
+
+/// @brief Sink stages have no output queue.
+template <>
+struct PipelineQueueOf<void>
+{
+    using Ptr = std::shared_ptr<void>;
+};
+
+//==============================================================================================
+//                                    class PipelineState
+//==============================================================================================
+/// @class PipelineState.
+/// @brief State shared between a Pipeline and all the workers of its stages. For internal use only.
+class PipelineState
+{
+public:
+    using Ptr = std::shared_ptr<PipelineState>;
+    using Aborter = std::function<void(ICoroSync::Ptr)>;
+
+    explicit PipelineState(PipelineOrdering ordering);
+
+    /// @brief Indicates if stage outputs must be emitted in input order.
+    bool isOrdered() const;
+
+    /// @brief Indicates if the pipeline was aborted, either explicitly or because a stage failed.
+    bool isAborted() const;
+
+    /// @brief Registers a function which releases all the waiters of a stage on abort.
+    void addAborter(Aborter aborter);
+
+    /// @brief Aborts all stages. Pending items are discarded.
+    void abort(ICoroSync::Ptr sync);
+
+    /// @brief Records the first error thrown by a stage and aborts the pipeline.
+    void fail(ICoroSync::Ptr sync, std::exception_ptr error);
+
+    /// @brief Tracks the lifetime of the stage workers.
+    void workerStarted();
+    void workerFinished(ICoroSync::Ptr sync);
+
+    /// @brief Waits until all the stage workers have exited.
+    /// @return The first error thrown by a stage, if any.
+    std::exception_ptr wait(ICoroSync::Ptr sync);
+
+    /// @brief Marks the pipeline as started. Returns false if it was already started.
+    bool start();
+
+    /// @brief Gets the time elapsed since the pipeline was started.
+    std::chrono::microseconds getElapsedTime() const;
+
+private:
+    const PipelineOrdering                  _ordering;
+    std::atomic_bool                        _isAborted{false};
+    std::atomic_bool                        _isStarted{false};
+    std::chrono::steady_clock::time_point   _startTime;
+    mutable Mutex                           _mutex;
+    ConditionVariable                       _workersDone;
+    size_t                                  _numWorkers{0};
+    std::exception_ptr                      _error;
+    std::vector<Aborter>                    _aborters;
+};
+
+//==============================================================================================
+//                                    interface IPipelineStage
+//==============================================================================================
+/// @interface IPipelineStage.
+/// @brief Type-erased interface to a pipeline stage. For internal use only.
+struct IPipelineStage
+{
+    using Ptr = std::shared_ptr<IPipelineStage>;
+
+    virtual ~IPipelineStage() = default;
+
+    /// @brief Posts all the workers of this stage.
+    virtual void start(Dispatcher& dispatcher) = 0;
+
+    /// @brief Returns a snapshot of the stage metrics.
+    virtual PipelineStageStatistics getStatistics() const = 0;
+};
+
+//==============================================================================================
+//                                    class PipelineStage
+//==============================================================================================
+/// @class PipelineStage.
+/// @brief A pipeline stage transforming values of type IN into values of type OUT. For internal use only.
+/// @details Each worker pulls from the input queue of the stage, invokes the stage function and pushes the
+///          result into the input queue of the next stage. The last worker to exit closes the next queue so
+///          that the end of the stream propagates stage by stage. In ordered mode, workers push their results
+///          in input order which limits the reordering window to the stage parallelism. Sink stages
+///          have no output and always consume items as soon as they are available.
+/// @tparam OUT The output type of the stage or void if this is a sink stage.
+template <class IN, class OUT>
+class PipelineStage : public IPipelineStage,
+                      public std::enable_shared_from_this<PipelineStage<IN, OUT>>
+{
+public:
+    using Func = std::function<OUT(VoidContextPtr, IN&&)>;
+    using InputQueuePtr = typename PipelineQueueOf<IN>::Ptr;
+    using OutputQueuePtr = typename PipelineQueueOf<OUT>::Ptr;
+
+    PipelineStage(PipelineState::Ptr state,
+                  const PipelineStageConfiguration& configuration,
+                  IQueue::QueueType queueType,
+                  InputQueuePtr input,
+                  Func func);
+
+    void setOutput(OutputQueuePtr output);
+
+    void start(Dispatcher& dispatcher) final;
+
+    PipelineStageStatistics getStatistics() const final;
+
+private:
+    void run(VoidContextPtr ctx);
+    bool process(VoidContextPtr ctx, PipelineItem<IN>&& item, std::true_type);  //sink stage
+    bool process(VoidContextPtr ctx, PipelineItem<IN>&& item, std::false_type);
+    void closeOutput(ICoroSync::Ptr sync, std::true_type);  //sink stage
+    void closeOutput(ICoroSync::Ptr sync, std::false_type);
+    void waitTurn(ICoroSync::Ptr sync, size_t sequence);
+    void endTurn(ICoroSync::Ptr sync);
+    void releaseTurns(ICoroSync::Ptr sync);
+
+    PipelineState::Ptr              _state;
+    PipelineStageConfiguration      _configuration;
+    IQueue::QueueType               _queueType;
+    InputQueuePtr                   _input;
+    OutputQueuePtr                  _output;
+    Func                            _func;
+    std::atomic<size_t>             _numRunningWorkers{0};
+    std::atomic<size_t>             _processedCount{0};
+    std::atomic<int64_t>            _busyTimeUs{0};
+    //Ordered mode
+    Mutex                           _turnMutex;
+    ConditionVariable               _turnCond;
+    size_t                          _nextSequence{0};
+};
+
+//==============================================================================================
+//                                        class Pipeline
+//==============================================================================================
+/// @class Pipeline.
+/// @brief Multi-stage dataflow pipeline running on a Dispatcher.
+/// @details Items pushed into the pipeline flow through each stage in turn. Stages run on coroutine or IO queues
+///          with their own parallelism and are connected by bounded queues. When a stage falls behind, its input
+///          queue fills up and the previous stage (and ultimately the producer calling push()) is suspended, so
+///          memory stays bounded by the sum of the queue capacities. Pipelines are created with PipelineBuilder.
+/// @tparam IN The type of items pushed into the pipeline.
+/// @tparam OUT The type of items produced by the last stage, or void if the last stage is a sink.
+template <class IN, class OUT>
+class Pipeline
+{
+public:
+    using Ptr = std::shared_ptr<Pipeline<IN, OUT>>;
+    using InputQueuePtr = typename PipelineQueueOf<IN>::Ptr;
+    using OutputQueuePtr = typename PipelineQueueOf<OUT>::Ptr;
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    /// @brief Destructor. Aborts the pipeline if it was not drained and waits for all the stage workers to exit.
+    /// @note This function blocks the calling thread. When the pipeline is owned by a coroutine, call wait(sync)
+    ///       before releasing it.
+    ~Pipeline();
+
+    /// @brief Pushes an item into the first stage. Blocks while the first stage queue is full.
+    /// @param[in] value The item to push.
+    /// @return True if the item was accepted, false if the pipeline was closed or aborted.
+    /// @note This function must be called from a thread. Use the ICoroSync overload from a coroutine.
+    bool push(IN value);
+
+    /// @brief Same as above but yields the calling coroutine while the first stage queue is full.
+    /// @param[in] sync Pointer to the coroutine synchronization object.
+    bool push(ICoroSync::Ptr sync, IN value);
+
+    /// @brief Signals that no more items will be pushed. The stages finish processing all pending items.
+    void close();
+
+    /// @brief Same as above but called from a coroutine.
+    void close(ICoroSync::Ptr sync);
+
+    /// @brief Stops the pipeline immediately. All pending items are discarded.
+    void abort();
+
+    /// @brief Pulls the next item produced by the last stage. Blocks until one is available.
+    /// @param[out] value The produced item.
+    /// @return True if an item was pulled, false if the pipeline is done (i.e. closed and drained, or aborted).
+    /// @note Not available when the last stage is a sink.
+    template <class V = OUT, class = std::enable_if_t<!std::is_void<V>::value>>
+    bool pull(V& value);
+
+    /// @brief Same as above but yields the calling coroutine until an item is available.
+    /// @param[in] sync Pointer to the coroutine synchronization object.
+    template <class V = OUT, class = std::enable_if_t<!std::is_void<V>::value>>
+    bool pull(ICoroSync::Ptr sync, V& value);
+
+    /// @brief Waits until all stage workers have exited. Rethrows the first error thrown by any stage.
+    /// @note When the last stage is not a sink, its output must be pulled or the last stage may block forever.
+    void wait();
+
+    /// @brief Same as above but yields the calling coroutine while waiting.
+    /// @param[in] sync Pointer to the coroutine synchronization object.
+    void wait(ICoroSync::Ptr sync);
+
+    /// @brief Returns a snapshot of the metrics of each stage in pipeline order.
+    std::vector<PipelineStageStatistics> getStatistics() const;
+
+private:
+    template <class, class> friend class PipelineBuilder;
+
+    Pipeline(PipelineState::Ptr state,
+             InputQueuePtr input,
+             OutputQueuePtr output,
+             std::vector<IPipelineStage::Ptr> stages);
+
+    void abort(ICoroSync::Ptr sync);
+
+    PipelineState::Ptr                  _state;
+    InputQueuePtr                       _input;
+    OutputQueuePtr                      _output;
+    std::vector<IPipelineStage::Ptr>    _stages;
+    Mutex                               _inputMutex;
+    size_t                              _nextSequence{0};
+};
+
+//==============================================================================================
+//                                     class PipelineBuilder
+//==============================================================================================
+/// @class PipelineBuilder.
+/// @brief Builds a Pipeline one stage at a time.
+/// @details Example:
+/// @code
+///    auto pipeline = PipelineBuilder<std::string>(dispatcher, PipelineOrdering::Ordered)
+///        .addStage(parse, parseConfig)       //coroutine stage: Record(VoidContextPtr, std::string&&)
+///        .addIoStage(enrich, enrichConfig)   //IO stage: Record(Record&&)
+///        .addStage(publish)                  //sink stage: void(VoidContextPtr, Record&&)
+///        .build();
+///    pipeline->push("...");
+///    pipeline->close();
+///    pipeline->wait();
+/// @endcode
+/// @tparam IN The type of items pushed into the pipeline.
+/// @tparam OUT The output type of the last stage added so far.
+template <class IN, class OUT = IN>
+class PipelineBuilder
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] dispatcher The dispatcher running all stages.
+    /// @param[in] ordering Determines if stage outputs are emitted in input order.
+    explicit PipelineBuilder(Dispatcher& dispatcher,
+                             PipelineOrdering ordering = PipelineOrdering::Unordered);
+
+    /// @brief Adds a stage running on coroutine queues.
+    /// @tparam FUNC Callable object with signature 'NEXT(VoidContextPtr, OUT&&)'. If NEXT is void, this stage
+    ///         is a sink and no other stage can be added after it.
+    /// @param[in] func The stage function.
+    /// @param[in] configuration The stage configuration.
+    /// @return A builder whose last stage produces values of type NEXT.
+    template <class FUNC>
+    auto addStage(FUNC&& func,
+                  const PipelineStageConfiguration& configuration = PipelineStageConfiguration())
+        ->PipelineBuilder<IN, decltype(resultOf2(func))>;
+
+    /// @brief Adds a stage running on IO queues. Use this for blocking calls.
+    /// @note Each IO worker holds an IO thread until the pipeline completes, so the total parallelism of all
+    ///       IO stages must not exceed the number of IO threads.
+    /// @tparam FUNC Callable object with signature 'NEXT(OUT&&)'. If NEXT is void, this stage is a sink.
+    /// @param[in] func The stage function.
+    /// @param[in] configuration The stage configuration.
+    /// @return A builder whose last stage produces values of type NEXT.
+    template <class FUNC>
+    auto addIoStage(FUNC&& func,
+                    const PipelineStageConfiguration& configuration = PipelineStageConfiguration())
+        ->PipelineBuilder<IN, decltype(resultOf2(func))>;
+
+    /// @brief Starts all stages and returns the pipeline.
+    /// @param[in] outputQueueCapacity The capacity of the queue holding the outputs of the last stage.
+    ///            Not used if the last stage is a sink.
+    /// @return The running pipeline.
+    typename Pipeline<IN, OUT>::Ptr build(size_t outputQueueCapacity = 64);
+
+private:
+    template <class, class> friend class PipelineBuilder;
+    using InputQueuePtr = typename PipelineQueueOf<IN>::Ptr;
+    using OutputQueuePtr = typename PipelineQueueOf<OUT>::Ptr;
+    using Connector = std::function<void(OutputQueuePtr)>;
+
+    PipelineBuilder(Dispatcher& dispatcher,
+                    PipelineState::Ptr state,
+                    std::shared_ptr<InputQueuePtr> input,
+                    std::vector<IPipelineStage::Ptr> stages,
+                    Connector connector);
+
+    template <class NEXT>
+    PipelineBuilder<IN, NEXT> addStageImpl(typename PipelineStage<OUT, NEXT>::Func func,
+                                           const PipelineStageConfiguration& configuration,
+                                           IQueue::QueueType queueType);
+
+    OutputQueuePtr makeOutput(size_t capacity, std::true_type);
+    OutputQueuePtr makeOutput(size_t capacity, std::false_type);
+
+    Dispatcher&                         _dispatcher;
+    PipelineState::Ptr                  _state;
+    std::shared_ptr<InputQueuePtr>      _input;     //set once the first stage is added
+    std::vector<IPipelineStage::Ptr>    _stages;
+    Connector                           _connector; //connects the last stage to the next queue
+};
+
+}}
+
+#include <quantum/util/impl/quantum_pipeline_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_PIPELINE_H
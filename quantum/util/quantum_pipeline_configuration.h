@@ -0,0 +1,91 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_PIPELINE_CONFIGURATION_H
+#define BLOOMBERG_QUANTUM_PIPELINE_CONFIGURATION_H
+
+#include <quantum/interface/quantum_iqueue.h>
+#include <string>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                  enum PipelineOrdering
+//==============================================================================================
+/// @enum PipelineOrdering
+/// @brief Determines the order in which each pipeline stage emits its outputs.
+enum class PipelineOrdering : int
+{
+    Unordered,  ///< Outputs are emitted as soon as they are produced. This yields the best throughput.
+    Ordered     ///< Outputs are emitted in the same order as the inputs were pushed into the pipeline.
+};
+
+//==============================================================================================
+//                                class PipelineStageConfiguration
+//==============================================================================================
+/// @class PipelineStageConfiguration.
+/// @brief Configuration of a single Pipeline stage.
+class PipelineStageConfiguration
+{
+public:
+    /// @brief Sets the name of this stage which is reported in the statistics.
+    /// @param name The stage name.
+    void setName(const std::string& name);
+
+    /// @brief Gets the name of this stage.
+    /// @return The stage name.
+    const std::string& getName() const;
+
+    /// @brief Sets the number of coroutines or IO tasks processing this stage concurrently.
+    /// @param parallelism The number of workers. Must be greater than 0. Default is 1.
+    /// @note Each IO worker occupies an IO thread while the pipeline runs, so the total parallelism of
+    ///       all IO stages must not exceed the number of IO threads.
+    void setParallelism(size_t parallelism);
+
+    /// @brief Gets the number of workers processing this stage.
+    /// @return The number of workers.
+    size_t getParallelism() const;
+
+    /// @brief Sets the maximum number of items waiting in the input queue of this stage.
+    /// @param capacity The queue capacity. Must be greater than 0. Default is 64.
+    /// @note When the queue is full, the upstream stage (or the pipeline producer) is suspended until space is
+    ///       available. This throttles producers down to the speed of the slowest stage.
+    void setQueueCapacity(size_t capacity);
+
+    /// @brief Gets the maximum number of items waiting in the input queue of this stage.
+    /// @return The queue capacity.
+    size_t getQueueCapacity() const;
+
+    /// @brief Sets the queue on which the workers of this stage are posted.
+    /// @param queueId The coroutine or IO queue id depending on the stage type. Default is IQueue::QueueId::Any.
+    void setQueueId(int queueId);
+
+    /// @brief Gets the queue on which the workers of this stage are posted.
+    /// @return The queue id.
+    int getQueueId() const;
+
+private:
+    std::string     _name;
+    size_t          _parallelism{1};
+    size_t          _queueCapacity{64};
+    int             _queueId{(int)IQueue::QueueId::Any};
+};
+
+}}
+
+#include <quantum/util/impl/quantum_pipeline_configuration_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_PIPELINE_CONFIGURATION_H
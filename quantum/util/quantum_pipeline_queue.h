@@ -0,0 +1,94 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_PIPELINE_QUEUE_H
+#define BLOOMBERG_QUANTUM_PIPELINE_QUEUE_H
+
+#include <quantum/quantum_mutex.h>
+#include <quantum/quantum_condition_variable.h>
+#include <quantum/interface/quantum_icoro_sync.h>
+#include <deque>
+#include <memory>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                    class PipelineQueue
+//==============================================================================================
+/// @class PipelineQueue.
+/// @brief Bounded multi-producer multi-consumer queue connecting two Pipeline stages.
+/// @details Producers are suspended while the queue is full and consumers are suspended while it is empty.
+///          All blocking operations take an optional ICoroSync pointer so that coroutines yield while waiting
+///          and regular threads (incl. IO threads) pass a nullptr.
+/// @tparam T The type of item stored in the queue.
+template <class T>
+class PipelineQueue
+{
+public:
+    using Ptr = std::shared_ptr<PipelineQueue<T>>;
+
+    /// @brief Constructor.
+    /// @param[in] capacity The maximum number of items the queue can hold.
+    explicit PipelineQueue(size_t capacity);
+
+    /// @brief Pushes an item at the back of the queue, waiting for space to become available if needed.
+    /// @param[in] sync Pointer to the coroutine synchronization object or nullptr if called from a thread.
+    /// @param[in] item The item to push.
+    /// @return True if the item was pushed, false if the queue was closed or aborted.
+    bool push(ICoroSync::Ptr sync, T&& item);
+
+    /// @brief Pulls an item from the front of the queue, waiting for one to become available if needed.
+    /// @param[in] sync Pointer to the coroutine synchronization object or nullptr if called from a thread.
+    /// @param[out] item The pulled item.
+    /// @return True if an item was pulled, false if the queue is closed and empty or it was aborted.
+    bool pull(ICoroSync::Ptr sync, T& item);
+
+    /// @brief Closes the queue. Subsequent pushes fail while the remaining items can still be pulled.
+    /// @param[in] sync Pointer to the coroutine synchronization object or nullptr if called from a thread.
+    void close(ICoroSync::Ptr sync);
+
+    /// @brief Closes the queue and discards all remaining items. All waiting producers and consumers are released.
+    /// @param[in] sync Pointer to the coroutine synchronization object or nullptr if called from a thread.
+    void abort(ICoroSync::Ptr sync);
+
+    /// @brief Gets the number of items currently in the queue.
+    size_t size() const;
+
+    /// @brief Gets the maximum number of items the queue can hold.
+    size_t capacity() const;
+
+    /// @brief Gets the highest number of items the queue ever held.
+    size_t maxSize() const;
+
+    /// @brief Gets the number of pushes which had to wait because the queue was full.
+    size_t blockedPushCount() const;
+
+private:
+    mutable Mutex       _mutex;
+    ConditionVariable   _notFull;
+    ConditionVariable   _notEmpty;
+    std::deque<T>       _items;
+    size_t              _capacity;
+    size_t              _maxSize{0};
+    size_t              _blockedPushCount{0};
+    bool                _isClosed{false};
+};
+
+}}
+
+#include <quantum/util/impl/quantum_pipeline_queue_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_PIPELINE_QUEUE_H
@@ -0,0 +1,85 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_PIPELINE_STATISTICS_H
+#define BLOOMBERG_QUANTUM_PIPELINE_STATISTICS_H
+
+#include <string>
+#include <chrono>
+#include <iostream>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                class PipelineStageStatistics
+//==============================================================================================
+/// @class PipelineStageStatistics.
+/// @brief Point-in-time snapshot of the metrics collected for a single Pipeline stage.
+class PipelineStageStatistics
+{
+public:
+    /// @brief Gets the name of the stage as configured.
+    const std::string& getName() const;
+
+    /// @brief Gets the number of workers processing the stage.
+    size_t getParallelism() const;
+
+    /// @brief Gets the number of items processed by the stage.
+    size_t getProcessedCount() const;
+
+    /// @brief Gets the number of items currently waiting in the input queue of the stage.
+    size_t getQueueDepth() const;
+
+    /// @brief Gets the highest number of items ever waiting in the input queue of the stage.
+    size_t getMaxQueueDepth() const;
+
+    /// @brief Gets the capacity of the input queue of the stage.
+    size_t getQueueCapacity() const;
+
+    /// @brief Gets the number of times a producer had to wait because the input queue of the stage was full.
+    /// @remark A high value indicates that this stage is throttling the stages before it.
+    size_t getBlockedPushCount() const;
+
+    /// @brief Gets the total time spent by all workers inside the stage function.
+    std::chrono::microseconds getBusyTime() const;
+
+    /// @brief Gets the time elapsed since the pipeline was started.
+    std::chrono::microseconds getElapsedTime() const;
+
+    /// @brief Gets the average number of items processed per second since the pipeline was started.
+    double getThroughput() const;
+
+private:
+    template <class IN, class OUT> friend class PipelineStage;
+
+    std::string                 _name;
+    size_t                      _parallelism{0};
+    size_t                      _processedCount{0};
+    size_t                      _queueDepth{0};
+    size_t                      _maxQueueDepth{0};
+    size_t                      _queueCapacity{0};
+    size_t                      _blockedPushCount{0};
+    std::chrono::microseconds   _busyTime{0};
+    std::chrono::microseconds   _elapsedTime{0};
+};
+
+std::ostream& operator<<(std::ostream& out, const PipelineStageStatistics& stats);
+
+}}
+
+#include <quantum/util/impl/quantum_pipeline_statistics_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_PIPELINE_STATISTICS_H
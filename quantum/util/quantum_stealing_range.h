@@ -0,0 +1,91 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_STEALING_RANGE_H
+#define BLOOMBERG_QUANTUM_STEALING_RANGE_H
+
+#include <quantum/quantum_spinlock.h>
+#include <quantum/quantum_macros.h>
+#include <atomic>
+#include <vector>
+#include <utility>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                 class StealingRange
+//==============================================================================================
+/// @class StealingRange
+/// @brief Distributes the index range [0, size) among a fixed number of workers.
+/// @details Each worker starts with an equal contiguous share and consumes it from the front,
+///          one grain at a time. When a worker runs out of work it steals the back half of the
+///          largest remaining share. Ranges are therefore only split lazily, when some worker
+///          is idle, and each worker keeps iterating over contiguous indexes.
+/// @note For internal use only.
+class StealingRange
+{
+public:
+    using Range = std::pair<size_t, size_t>;
+    
+    /// @brief Constructor.
+    /// @param[in] size The total number of indexes to distribute.
+    /// @param[in] numWorkers The number of workers. Must be greater than 0.
+    /// @param[in] grainSize The maximum number of indexes handed out per call to next().
+    StealingRange(size_t size, size_t numWorkers, size_t grainSize);
+    
+    /// @brief Get the next range of indexes to process.
+    /// @param[in] worker The worker id in the range [0, numWorkers).
+    /// @return A range [first, second) of indexes. An empty range indicates there is no more work.
+    Range next(size_t worker);
+    
+    /// @brief Stop handing out work. Subsequent calls to next() return an empty range.
+    void cancel();
+    
+    /// @brief Get the number of workers.
+    size_t numWorkers() const;
+    
+    /// @brief Get the grain size.
+    size_t grainSize() const;
+    
+    /// @brief Computes a grain size which gives each worker enough chunks to balance the load
+    ///        while keeping the per-chunk overhead negligible.
+    static size_t defaultGrainSize(size_t size, size_t numWorkers);
+    
+private:
+    struct Slot
+    {
+        Slot();
+        
+        SpinLock            _lock;
+        std::atomic<size_t> _begin;
+        std::atomic<size_t> _end;
+        char                _padding[__QUANTUM_CACHE_LINE_SIZE]; //avoid false sharing between workers
+    };
+    
+    Range take(Slot& slot);
+    bool steal(size_t thief);
+    
+    //Members
+    std::vector<Slot>   _slots;
+    size_t              _grainSize;
+    std::atomic_bool    _cancelled;
+};
+
+}}
+
+#include <quantum/util/impl/quantum_stealing_range_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_STEALING_RANGE_H
@@ -0,0 +1,207 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_TASK_GRAPH_H
+#define BLOOMBERG_QUANTUM_TASK_GRAPH_H
+
+#include <quantum/quantum_dispatcher.h>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Bloomberg {
+namespace quantum {
+
+class TaskGraph;
+
+//==============================================================================================
+//                                      class TaskGraphNode
+//==============================================================================================
+/// @class TaskGraphNode.
+/// @brief Handle to a node of a TaskGraph. Used to declare edges and to access the node result.
+/// @tparam RET The type returned by the node function.
+template <class RET>
+class TaskGraphNode
+{
+public:
+    /// @brief Gets the index of this node inside its graph.
+    size_t getId() const { return _id; }
+
+private:
+    friend class TaskGraph;
+    explicit TaskGraphNode(size_t id) : _id(id) {}
+
+    size_t _id;
+};
+
+//==============================================================================================
+//                                      class TaskGraphInputs
+//==============================================================================================
+/// @class TaskGraphInputs.
+/// @brief Gives a running node read access to the results of its predecessors.
+class TaskGraphInputs
+{
+public:
+    /// @brief Gets the result of a predecessor node.
+    /// @tparam T The type returned by the predecessor.
+    /// @param[in] node The predecessor node.
+    /// @return A reference to the predecessor result, valid until the graph is run again.
+    /// @note Throws std::invalid_argument if 'node' is not a direct predecessor of the running node.
+    template <class T>
+    const T& get(const TaskGraphNode<T>& node) const;
+
+    /// @brief Gets the number of direct predecessors of the running node.
+    size_t size() const;
+
+private:
+    friend class TaskGraph;
+    TaskGraphInputs(const TaskGraph& graph, size_t id);
+
+    const TaskGraph&    _graph;
+    size_t              _id;
+};
+
+//==============================================================================================
+//                                         class TaskGraph
+//==============================================================================================
+/// @class TaskGraph.
+/// @brief Directed acyclic graph of tasks executed on a Dispatcher.
+/// @details Nodes and edges are declared up-front and the graph is then submitted with run(). Each node keeps an
+///          atomic count of its unfinished predecessors and is posted by the predecessor which brings it to zero,
+///          so no coroutine is ever blocked waiting on a dependency. Node results are passed along edges via
+///          TaskGraphInputs. The graph can be run again once the previous run completes, which makes it suitable
+///          for repeated workloads with the same shape.
+/// @code
+///    TaskGraph graph(dispatcher);
+///    auto load = graph.addIoNode([](const TaskGraphInputs&)->std::string { return readFile(); });
+///    auto parse = graph.addNode([&](VoidContextPtr, const TaskGraphInputs& in)->Doc { return parse(in.get(load)); });
+///    graph.addEdge(load, parse);
+///    graph.run()->get(); //rethrows the first node error
+///    const Doc& doc = graph.getResult(parse);
+/// @endcode
+/// @note The graph topology cannot be modified while it is running.
+class TaskGraph
+{
+public:
+    /// @brief Constructor.
+    /// @param[in] dispatcher Dispatcher running all the nodes.
+    explicit TaskGraph(Dispatcher& dispatcher);
+
+    TaskGraph(const TaskGraph&) = delete;
+    TaskGraph& operator=(const TaskGraph&) = delete;
+
+    /// @brief Destructor. Waits for the current run to complete, if any.
+    ~TaskGraph();
+
+    /// @brief Adds a node which runs as a coroutine.
+    /// @tparam FUNC Callable object with signature 'RET(VoidContextPtr, const TaskGraphInputs&)'.
+    /// @param[in] func The node function.
+    /// @param[in] queueId The coroutine queue on which the node is posted. Default is any queue.
+    /// @param[in] isHighPriority If set to true, the node is posted at the front of the queue.
+    /// @return A handle to the new node.
+    template <class FUNC>
+    auto addNode(FUNC&& func,
+                 int queueId = (int)IQueue::QueueId::Any,
+                 bool isHighPriority = false)->TaskGraphNode<decltype(resultOf2(func))>;
+
+    /// @brief Adds a node which runs on an IO thread. Use this for blocking calls.
+    /// @tparam FUNC Callable object with signature 'RET(const TaskGraphInputs&)'.
+    /// @param[in] func The node function.
+    /// @param[in] queueId The IO queue on which the node is posted. Default is any queue.
+    /// @param[in] isHighPriority If set to true, the node is posted at the front of the queue.
+    /// @return A handle to the new node.
+    template <class FUNC>
+    auto addIoNode(FUNC&& func,
+                   int queueId = (int)IQueue::QueueId::Any,
+                   bool isHighPriority = false)->TaskGraphNode<decltype(resultOf2(func))>;
+
+    /// @brief Declares that 'to' depends on 'from'. 'to' will only run once 'from' completes and can read its result.
+    /// @note Throws std::invalid_argument if either node does not belong to this graph or if both are the same node.
+    ///       Duplicate edges are ignored. Cycles are detected when the graph is run.
+    template <class FROM, class TO>
+    void addEdge(const TaskGraphNode<FROM>& from, const TaskGraphNode<TO>& to);
+
+    /// @brief Runs the graph. Nodes without predecessors are posted immediately.
+    /// @return A future which completes once all nodes have run. Calling get() on it rethrows the first error
+    ///         thrown by any node. Nodes depending directly or indirectly on a failed
+    ///         node are skipped while independent nodes still run.
+    /// @note Throws std::runtime_error if the graph is already running or contains a cycle.
+    ThreadFuturePtr<int> run();
+
+    /// @brief Same as above but returns a future which can be waited on from a coroutine.
+    /// @param[in] sync Pointer to the coroutine synchronization object.
+    CoroFuturePtr<int> run(ICoroSync::Ptr sync);
+
+    /// @brief Gets the result of a node from the last completed run.
+    /// @note Throws std::runtime_error if the graph is running or if the node did not run successfully.
+    template <class RET>
+    const RET& getResult(const TaskGraphNode<RET>& node) const;
+
+    /// @brief Gets the number of nodes in the graph.
+    size_t getNumNodes() const;
+
+    /// @brief Indicates if the graph is currently running.
+    bool isRunning() const;
+
+private:
+    friend class TaskGraphInputs;
+    using NodeFunc = std::function<std::shared_ptr<void>(VoidContextPtr, const TaskGraphInputs&)>;
+
+    struct Node
+    {
+        NodeFunc                    _func;
+        IQueue::QueueType           _queueType;
+        int                         _queueId;
+        bool                        _isHighPriority;
+        std::vector<size_t>         _predecessors;
+        std::vector<size_t>         _successors;
+        std::atomic<size_t>         _pending{0};
+        std::atomic_bool            _isSkipped{false}; //set when a predecessor failed or was skipped
+        std::shared_ptr<void>       _result;
+    };
+
+    template <class RET>
+    TaskGraphNode<RET> addNodeImpl(NodeFunc func, IQueue::QueueType queueType, int queueId, bool isHighPriority);
+    template <class RET, class FUNC>
+    static NodeFunc wrap(FUNC&& func, std::true_type);  //void result
+    template <class RET, class FUNC>
+    static NodeFunc wrap(FUNC&& func, std::false_type);
+    void checkNode(size_t id) const;
+    void checkIdle() const;
+    void validate();
+    PromisePtr<int> start(std::vector<size_t>& roots);
+    void schedule(size_t id);
+    void execute(VoidContextPtr ctx, size_t id);
+
+    Dispatcher&                         _dispatcher;
+    std::vector<std::unique_ptr<Node>>  _nodes;
+    std::vector<size_t>                 _roots;
+    bool                                _isValidated{false};
+    mutable std::mutex                  _runMutex;
+    std::atomic_bool                    _isRunning{false};
+    std::atomic_bool                    _isFailed{false}; //records the first error only
+    std::atomic<size_t>                 _remaining{0};
+    std::exception_ptr                  _error;
+    PromisePtr<int>                     _promise;
+};
+
+}}
+
+#include <quantum/util/impl/quantum_task_graph_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_TASK_GRAPH_H
@@ -0,0 +1,84 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#ifndef BLOOMBERG_QUANTUM_TILE_GRID_H
+#define BLOOMBERG_QUANTUM_TILE_GRID_H
+
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+namespace Bloomberg {
+namespace quantum {
+
+//==============================================================================================
+//                                      struct Tile2D
+//==============================================================================================
+/// @struct Tile2D
+/// @brief Bounds of a rectangular tile of a 2-D range. Rows are in [rowBegin, rowEnd) and columns
+///        are in [colBegin, colEnd).
+struct Tile2D
+{
+    size_t rowBegin;
+    size_t rowEnd;
+    size_t colBegin;
+    size_t colEnd;
+};
+
+//==============================================================================================
+//                                      class TileGrid
+//==============================================================================================
+/// @class TileGrid
+/// @brief Splits a 2-D range of rows x cols into tiles and enumerates them along a Z-order curve.
+/// @details Consecutive tile indexes are spatial neighbours, so a worker which processes a contiguous
+///          run of indexes (e.g. a StealingRange share) stays within one region of the range and reuses
+///          the cache lines loaded for the previous tile.
+/// @note For internal use only.
+class TileGrid
+{
+public:
+    /// @brief Tile size used along a dimension when 0 is requested.
+    static constexpr size_t DefaultTileSize = 64;
+    
+    /// @brief Constructor.
+    /// @param[in] rows The number of rows in the range.
+    /// @param[in] cols The number of columns in the range.
+    /// @param[in] tileRows The number of rows per tile. Set to 0 to use DefaultTileSize.
+    /// @param[in] tileCols The number of columns per tile. Set to 0 to use DefaultTileSize.
+    TileGrid(size_t rows, size_t cols, size_t tileRows, size_t tileCols);
+    
+    /// @brief Get the number of tiles.
+    size_t size() const;
+    
+    /// @brief Get the bounds of a tile.
+    /// @param[in] index The tile index in Z-order, in the range [0, size()).
+    Tile2D tile(size_t index) const;
+    
+private:
+    static uint64_t mortonCode(uint32_t row, uint32_t col);
+    
+    //Members
+    size_t                                      _rows;
+    size_t                                      _cols;
+    size_t                                      _tileRows;
+    size_t                                      _tileCols;
+    std::vector<std::pair<uint32_t, uint32_t>>  _order; //tile row, tile column
+};
+
+}}
+
+#include <quantum/util/impl/quantum_tile_grid_impl.h>
+
+#endif //BLOOMBERG_QUANTUM_TILE_GRID_H
@@ -28,6 +28,7 @@
 #include <quantum/interface/quantum_icontext.h>
 #include <quantum/interface/quantum_ipromise.h>
 #include <quantum/quantum_capture.h>
+#include <quantum/util/quantum_map_reduce_output.h>
 
 namespace Bloomberg {
 namespace quantum {
@@ -79,29 +80,191 @@ struct Util
                                 FUNC&& func,
                                 size_t numCoroutineThreads);
     
+    template <class RET, class INPUT_IT, class FUNC>
+    static std::vector<RET> parallelForCoro(VoidContextPtr ctx,
+                                            INPUT_IT first,
+                                            size_t num,
+                                            FUNC&& func,
+                                            size_t grainSize);
+    
+    template <class FUNC>
+    static int parallelFor2DCoro(VoidContextPtr ctx,
+                                 size_t rows,
+                                 size_t cols,
+                                 size_t tileRows,
+                                 size_t tileCols,
+                                 FUNC&& func);
+    
+    template <class RET, class INPUT_IT, class FUNC>
+    static typename Traits::ChunkResults<RET>::Type
+    forEachChunkCoro(VoidContextPtr ctx,
+                     INPUT_IT first,
+                     size_t num,
+                     size_t chunkSize,
+                     FUNC&& func);
+    
+    template <class INPUT_IT, class OUTPUT_IT, class FUNC>
+    static int forEachChunkOutputCoro(VoidContextPtr ctx,
+                                      INPUT_IT first,
+                                      size_t num,
+                                      size_t chunkSize,
+                                      OUTPUT_IT outFirst,
+                                      FUNC&& func);
+    
+    /// @brief Runs 'body(ctx, chunk, begin, end)' on every chunk of [0, num) where chunkSize > 0. One worker is posted on each
+    ///        coroutine thread of the 'Any' queue range and workers claim chunks in order from a shared counter.
+    template <class BODY>
+    static void runChunks(VoidContextPtr ctx,
+                          size_t num,
+                          size_t chunkSize,
+                          const BODY& body);
+    
+    template <class RET, class INPUT_IT, class FUNC>
+    static typename Traits::ChunkResults<RET>::Type
+    forEachAsyncIoCoro(VoidContextPtr ctx,
+                       INPUT_IT first,
+                       size_t num,
+                       size_t chunkSize,
+                       FUNC&& func);
+    
+    /// @brief Same as runChunks() but runs 'body(chunk, begin, end)' on the IO threads. One worker is posted on each
+    ///        dedicated IO queue so that blocking calls never stall a coroutine thread.
+    template <class BODY>
+    static void runIoChunks(VoidContextPtr ctx,
+                            size_t num,
+                            size_t chunkSize,
+                            const BODY& body);
+    
+    //------------------------------------------------------------------------------------------
+    //                                      Reduce & Scan
+    //------------------------------------------------------------------------------------------
+    /// @brief Transform function used by reduce().
+    struct Identity
+    {
+        template <class V>
+        const V& operator()(const V& value) const { return value; }
+    };
+    
+    template <class T, class INPUT_IT, class REDUCE_FUNC, class TRANSFORM_FUNC>
+    static T transformReduceCoro(VoidContextPtr ctx,
+                                 INPUT_IT first,
+                                 size_t num,
+                                 T init,
+                                 const REDUCE_FUNC& reduceFunc,
+                                 const TRANSFORM_FUNC& transformFunc,
+                                 size_t grainSize);
+    
+    /// @brief Recursively splits [first, first+num) in two halves. The left half is reduced by a child coroutine
+    ///        while the right half is reduced by the current one, so partial results are combined in a tree.
+    /// @note 'num' must be greater than 0.
+    template <class T, class INPUT_IT, class REDUCE_FUNC, class TRANSFORM_FUNC>
+    static T treeReduceCoro(VoidContextPtr ctx,
+                            INPUT_IT first,
+                            size_t num,
+                            const REDUCE_FUNC& reduceFunc,
+                            const TRANSFORM_FUNC& transformFunc,
+                            size_t grainSize);
+    
+    template <class T, class INPUT_IT, class FUNC>
+    static std::vector<T> scanCoro(VoidContextPtr ctx,
+                                   INPUT_IT first,
+                                   size_t num,
+                                   T init,
+                                   const FUNC& func,
+                                   bool isInclusive);
+    
+    //------------------------------------------------------------------------------------------
+    //                                      Sort
+    //------------------------------------------------------------------------------------------
+    /// @brief Sorts each of the chunks of [first, first+num) in parallel, then merges pairs of sorted runs
+    ///        until a single one is left. Each merge is split in independent pieces so that all coroutine
+    ///        threads participate until the last round.
+    template <class RANDOM_IT, class COMPARE>
+    static int sortCoro(VoidContextPtr ctx,
+                        RANDOM_IT first,
+                        size_t num,
+                        const COMPARE& compare,
+                        bool isStable);
+    
     //------------------------------------------------------------------------------------------
     //                                      MapReduce
     //------------------------------------------------------------------------------------------
     template <class KEY,
               class MAPPED_TYPE,
               class REDUCED_TYPE,
-              class INPUT_IT>
-    static std::map<KEY, REDUCED_TYPE>
+              class INPUT_IT,
+              class OUTPUT = MapReduceOutput::Ordered>
+    static typename OUTPUT::template Container<KEY, REDUCED_TYPE>
     mapReduceCoro(VoidContextPtr ctx,
-                             INPUT_IT inputIt,
-                             size_t num,
-                             const Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
-                             const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer);
+                  INPUT_IT inputIt,
+                  size_t num,
+                  const Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
+                  const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                  const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner);
+    
+    template <class KEY,
+              class MAPPED_TYPE,
+              class REDUCED_TYPE,
+              class INPUT_IT,
+              class OUTPUT = MapReduceOutput::Ordered>
+    static typename OUTPUT::template Container<KEY, REDUCED_TYPE>
+    mapReduceBatchCoro(VoidContextPtr ctx,
+                       INPUT_IT inputIt,
+                       size_t num,
+                       const Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
+                       const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                       const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner);
+    
+    /// @brief Map-reduce where both the mapper and the reducer run on the IO threads.
+    /// @details The input is mapped in chunks, each chunk being combined and scattered into hash partitions by the
+    ///          IO worker which mapped it. Each partition is then indexed and reduced by a single IO worker.
+    template <class KEY,
+              class MAPPED_TYPE,
+              class REDUCED_TYPE,
+              class INPUT_IT,
+              class OUTPUT = MapReduceOutput::Ordered>
+    static typename OUTPUT::template Container<KEY, REDUCED_TYPE>
+    mapReduceAsyncIoCoro(VoidContextPtr ctx,
+                         INPUT_IT inputIt,
+                         size_t num,
+                         const Functions::IoMapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
+                         const Functions::IoReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                         const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner,
+                         size_t chunkSize);
+    
+    /// @brief Streaming map-reduce over a buffered future.
+    /// @details Records are pulled as they arrive and handed out in batches to one slot per coroutine thread.
+    ///          Each slot maps its batch and folds the mapped values into its own hash-partitioned aggregates with
+    ///          the combiner. A slot only accepts a new batch once the previous one is done, so memory is bounded
+    ///          by the number of distinct keys rather than by the length of the stream. When the buffer closes,
+    ///          the aggregates of all slots are merged one partition at a time in parallel.
+    template <class KEY,
+              class MAPPED_TYPE,
+              class RECORD,
+              class SOURCE,
+              class OUTPUT = MapReduceOutput::Ordered>
+    static typename OUTPUT::template Container<KEY, MAPPED_TYPE>
+    mapReduceStreamCoro(VoidContextPtr ctx,
+                        SOURCE source,
+                        const Functions::StreamMapFunc<KEY, MAPPED_TYPE, RECORD>& mapper,
+                        const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner,
+                        size_t batchSize);
     
+    /// @brief Shuffle and reduce stages of map-reduce.
+    /// @details Each chunk of mapper outputs is scattered in parallel into hash partitions (after being optionally
+    ///          combined). Each partition is then indexed and reduced in parallel, so the only serial step left
+    ///          is assembling the reduced values into the output container.
     template <class KEY,
               class MAPPED_TYPE,
               class REDUCED_TYPE,
-              class INPUT_IT>
-    static std::map<KEY, REDUCED_TYPE> mapReduceBatchCoro(VoidContextPtr ctx,
-                                  INPUT_IT inputIt,
-                                  size_t num,
-                                  const Functions::MapFunc<KEY, MAPPED_TYPE, INPUT_IT>& mapper,
-                                  const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer);
+              class OUTPUT,
+              class MAPPER_OUTPUT_IT>
+    static typename OUTPUT::template Container<KEY, REDUCED_TYPE>
+    shuffleReduceCoro(VoidContextPtr ctx,
+                      const std::vector<std::pair<MAPPER_OUTPUT_IT, MAPPER_OUTPUT_IT>>& mapperOutputs,
+                      const Functions::ReduceFunc<KEY, MAPPED_TYPE, REDUCED_TYPE>& reducer,
+                      const Functions::CombineFunc<KEY, MAPPED_TYPE>& combiner,
+                      bool reduceInBatch);
     
 #ifdef __QUANTUM_PRINT_DEBUG
     //Synchronize logging
@@ -0,0 +1,433 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#include <quantum_fixture.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace quantum;
+
+DispatcherSingleton::DispatcherMap DispatcherSingleton::_dispatchers;
+
+//==============================================================================
+// TEST FIXTURES
+//==============================================================================
+
+struct CoTaskTest: public DispatcherFixture
+{};
+
+INSTANTIATE_TEST_CASE_P(CoTaskTest_Default,
+                        CoTaskTest,
+                        ::testing::Values(TestConfiguration(false, false),
+                                          TestConfiguration(false, true)));
+
+struct CoCleanupTest: public DispatcherFixture
+{};
+
+INSTANTIATE_TEST_CASE_P(CoCleanupTest_Default,
+                        CoCleanupTest,
+                        ::testing::Values(TestConfiguration(false, false),
+                                          TestConfiguration(false, true)));
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+
+co::Task<int> square(int value)
+{
+    co_return value * value;
+}
+
+co::Task<int> sumOfSquares(int count)
+{
+    int sum = 0;
+    for (int i = 1; i <= count; ++i)
+    {
+        sum += co_await square(i);
+    }
+    co_return sum;
+}
+
+co::Task<int> throwing()
+{
+    throw std::runtime_error("co error");
+    co_return 0;
+}
+
+co::Generator<int> squares(int max)
+{
+    for (int i = 1; i <= max; ++i)
+    {
+        co_yield i * i;
+    }
+}
+
+//==============================================================================
+// TEST CASES
+//==============================================================================
+
+TEST_P(CoTaskTest, SpawnReturnsValue)
+{
+    auto future = co::spawn(getDispatcher(), square(7));
+    EXPECT_EQ(49, future->get());
+}
+
+TEST_P(CoTaskTest, SpawnVoidTask)
+{
+    std::atomic_int counter{0};
+    auto task = [&counter]()->co::Task<>
+    {
+        ++counter;
+        co_return;
+    };
+    auto future = co::spawn(getDispatcher(), task(), 0, true);
+    future->get();
+    EXPECT_EQ(1, counter);
+}
+
+TEST_P(CoTaskTest, NestedTasks)
+{
+    auto future = co::spawn(getDispatcher(), sumOfSquares(10));
+    EXPECT_EQ(385, future->get());
+}
+
+TEST_P(CoTaskTest, ExceptionPropagation)
+{
+    auto outer = []()->co::Task<std::string>
+    {
+        try
+        {
+            co_await throwing();
+        }
+        catch (const std::runtime_error& ex)
+        {
+            co_return std::string("caught ") + ex.what();
+        }
+        co_return "not caught";
+    };
+    EXPECT_EQ("caught co error", co::spawn(getDispatcher(), outer())->get());
+    EXPECT_THROW(co::spawn(getDispatcher(), throwing())->get(), std::runtime_error);
+}
+
+TEST_P(CoTaskTest, AwaitFutures)
+{
+    Dispatcher& dispatcher = getDispatcher();
+    auto task = [&dispatcher]()->co::Task<int>
+    {
+        int a = co_await dispatcher.post([](VoidContextPtr ctx)->int
+        {
+            ctx->sleep(std::chrono::milliseconds(10));
+            return 1;
+        });
+        int b = co_await dispatcher.postAsyncIo2([]()->int
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            return 2;
+        });
+        Promise<int>::Ptr promise(new Promise<int>(), Promise<int>::deleter);
+        dispatcher.post([promise](VoidContextPtr ctx)->int
+        {
+            return promise->set(ctx, 3);
+        });
+        int c = co_await promise->getICoroFuture();
+        co_return a + b + c;
+    };
+    EXPECT_EQ(6, co::spawn(dispatcher, task())->get());
+}
+
+TEST_P(CoTaskTest, AwaitFutureException)
+{
+    Dispatcher& dispatcher = getDispatcher();
+    auto task = [&dispatcher]()->co::Task<int>
+    {
+        co_return co_await dispatcher.post([](VoidContextPtr)->int
+        {
+            throw std::logic_error("post error");
+        });
+    };
+    EXPECT_THROW(co::spawn(dispatcher, task())->get(), std::logic_error);
+}
+
+TEST_P(CoTaskTest, MutexAndConditionVariable)
+{
+    Dispatcher& dispatcher = getDispatcher();
+    Mutex mutex;
+    ConditionVariable cond;
+    std::vector<int> produced;
+    bool done = false;
+
+    auto consumer = [&]()->co::Task<int>
+    {
+        int sum = 0;
+        co::LockGuard guard = co_await co::lock(mutex);
+        while (true)
+        {
+            co_await co::wait(cond, mutex, [&]{ return done || !produced.empty(); });
+            for (int value : produced)
+            {
+                sum += value;
+            }
+            produced.clear();
+            if (done)
+            {
+                break;
+            }
+        }
+        co_return sum;
+    };
+    auto producer = [&]()->co::Task<>
+    {
+        for (int i = 1; i <= 10; ++i)
+        {
+            {
+                co::LockGuard guard = co_await co::lock(mutex);
+                produced.push_back(i);
+                done = (i == 10);
+            }
+            cond.notifyAll();
+            co_await co::yield();
+        }
+    };
+    auto sum = co::spawn(dispatcher, consumer(), 0);
+    auto finished = co::spawn(dispatcher, producer(), 1);
+    finished->get();
+    EXPECT_EQ(55, sum->get());
+}
+
+TEST_P(CoTaskTest, DestroyWaitingTask)
+{
+    Mutex mutex;
+    ConditionVariable cond;
+    auto waiter = [&]()->co::Task<>
+    {
+        co_await co::wait(cond, mutex);
+        mutex.unlock();
+    };
+    //Drive the tasks inline so that the order of the waiters is deterministic. The second frame is allocated
+    //first so that it cannot reuse the memory of the destroyed one.
+    co::Runner<void> notified(getDispatcher(), waiter());
+    mutex.lock();
+    {
+        co::Runner<void> destroyed(getDispatcher(), waiter());
+        EXPECT_NE(0, destroyed.step()); //suspended on the condition variable
+    } //destroys the suspended coroutine frame
+    mutex.lock();
+    EXPECT_NE(0, notified.step());
+    cond.notifyOne(); //must not be consumed by the destroyed coroutine
+    EXPECT_EQ(0, notified.step());
+    EXPECT_TRUE(mutex.tryLock());
+    mutex.unlock();
+}
+
+TEST_P(CoTaskTest, LockGuard)
+{
+    Mutex mutex;
+    auto task = [&]()->co::Task<int>
+    {
+        co::LockGuard moved;
+        {
+            co::LockGuard guard = co_await co::lock(mutex);
+            EXPECT_TRUE(guard.ownsLock());
+            moved = std::move(guard);
+            EXPECT_FALSE(guard.ownsLock());
+        }
+        EXPECT_TRUE(moved.ownsLock());
+        EXPECT_FALSE(mutex.tryLock()); //still held after the original guard went out of scope
+        moved.unlock();
+        EXPECT_FALSE(moved.ownsLock());
+        {
+            co::LockGuard guard = co_await co::lock(mutex); //lock was released by unlock()
+        }
+        co::LockGuard last = co_await co::lock(mutex); //and by the guard destructor
+        co_return 0;
+    };
+    EXPECT_EQ(0, co::spawn(getDispatcher(), task())->get());
+    EXPECT_TRUE(mutex.tryLock()); //released when the coroutine frame was destroyed
+    mutex.unlock();
+}
+
+TEST_P(CoTaskTest, MixedWithStackfulCoroutines)
+{
+    Dispatcher& dispatcher = getDispatcher();
+    Mutex mutex;
+    int counter = 0;
+    auto stackless = [&]()->co::Task<>
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            {
+                co::LockGuard guard = co_await co::lock(mutex);
+                ++counter;
+            }
+            co_await co::yield();
+        }
+    };
+    std::vector<ThreadContextPtr<int>> stackful;
+    std::vector<ThreadFuturePtr<Void>> futures;
+    for (int i = 0; i < 4; ++i)
+    {
+        futures.push_back(co::spawn(dispatcher, stackless(), i));
+        stackful.push_back(dispatcher.post(i, false, [&](VoidContextPtr ctx)->int
+        {
+            for (int j = 0; j < 100; ++j)
+            {
+                Mutex::Guard guard(ctx, mutex);
+                ++counter;
+                ctx->yield();
+            }
+            return 0;
+        }));
+    }
+    for (auto& future : futures) future->get();
+    for (auto& context : stackful) context->get();
+    EXPECT_EQ(800, counter);
+}
+
+TEST_P(CoTaskTest, SleepAndYield)
+{
+    auto task = []()->co::Task<long>
+    {
+        auto start = std::chrono::steady_clock::now();
+        co_await co::yield();
+        co_await co::sleep(std::chrono::milliseconds(50));
+        co_return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+    EXPECT_GE(co::spawn(getDispatcher(), task())->get(), 50);
+}
+
+TEST_P(CoTaskTest, PostAsyncIo)
+{
+    std::atomic_int counter{0};
+    auto task = [&counter]()->co::Task<std::string>
+    {
+        std::string prefix = "io";
+        auto text = co_await co::postAsyncIo([](const std::string& p, int n)->std::string
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            return p + std::to_string(n);
+        }, prefix, 42);
+        co_await co::postAsyncIo(0, true, [&counter]{ ++counter; });
+        co_return text;
+    };
+    EXPECT_EQ("io42", co::spawn(getDispatcher(), task())->get());
+    EXPECT_EQ(1, counter);
+}
+
+TEST_P(CoTaskTest, AwaitFromStackfulCoroutine)
+{
+    Dispatcher& dispatcher = getDispatcher();
+    auto ctx = dispatcher.post([&dispatcher](VoidContextPtr ctx)->int
+    {
+        auto future = co::spawn(ctx, dispatcher, sumOfSquares(3));
+        return future->get(ctx);
+    });
+    EXPECT_EQ(14, ctx->get());
+}
+
+TEST_P(CoTaskTest, ManyConcurrentTasks)
+{
+    Dispatcher& dispatcher = getDispatcher();
+    std::vector<ThreadFuturePtr<int>> futures;
+    for (int i = 0; i < 1000; ++i)
+    {
+        futures.push_back(co::spawn(dispatcher, [](int value)->co::Task<int>
+        {
+            co_await co::yield();
+            co_return co_await square(value);
+        }(i)));
+    }
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(i * i, futures[i]->get());
+    }
+}
+
+TEST_P(CoTaskTest, GeneratorIteration)
+{
+    auto generator = squares(10);
+    EXPECT_FALSE(generator.done());
+    std::vector<int> values;
+    for (int& value : generator)
+    {
+        values.push_back(value);
+    }
+    EXPECT_EQ((std::vector<int>{1, 4, 9, 16, 25, 36, 49, 64, 81, 100}), values);
+    EXPECT_TRUE(generator.done());
+    EXPECT_FALSE(generator.next());
+}
+
+TEST_P(CoTaskTest, GeneratorValuesAndExceptions)
+{
+    //lvalues are read and moved from inside the coroutine frame, read-only values are copied
+    const std::string text("text");
+    auto strings = [](const std::string& text)->co::Generator<std::string>
+    {
+        std::string local("local");
+        co_yield local;
+        if (!local.empty()) throw std::logic_error("not moved");
+        co_yield text;
+        throw std::runtime_error("generator error");
+    }(text);
+    ASSERT_TRUE(strings.next());
+    std::string taken = std::move(strings.value());
+    EXPECT_EQ("local", taken);
+    ASSERT_TRUE(strings.next());
+    EXPECT_NE(&text, &strings.value());
+    EXPECT_EQ(text, strings.value());
+    EXPECT_THROW(strings.next(), std::runtime_error);
+    EXPECT_TRUE(strings.done());
+    
+    //destroying a suspended generator destroys its locals
+    struct Unwinder
+    {
+        ~Unwinder() { ++numUnwound; }
+        int& numUnwound;
+    };
+    int numUnwound = 0;
+    {
+        auto naturals = [](int& numUnwound)->co::Generator<int>
+        {
+            Unwinder unwinder{numUnwound};
+            for (int i = 0; ; ++i) co_yield i;
+        }(numUnwound);
+        ASSERT_TRUE(naturals.next());
+        ASSERT_TRUE(naturals.next());
+        EXPECT_EQ(1, naturals.value());
+    }
+    EXPECT_EQ(1, numUnwound);
+}
+
+TEST_P(CoTaskTest, GeneratorConsumedByTask)
+{
+    auto task = []()->co::Task<int>
+    {
+        int sum = 0;
+        for (int value : squares(10))
+        {
+            sum += value;
+            co_await co::yield();
+        }
+        co_return sum;
+    };
+    EXPECT_EQ(385, co::spawn(getDispatcher(), task())->get());
+}
+
+TEST_P(CoCleanupTest, DeleteDispatcherInstance)
+{
+    DispatcherSingleton::deleteInstances();
+}
@@ -0,0 +1,233 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#include <quantum_fixture.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+using namespace quantum;
+
+//==============================================================================
+// TEST FIXTURES
+//==============================================================================
+
+struct PipelineTest: public DispatcherFixture
+{};
+
+INSTANTIATE_TEST_CASE_P(PipelineTest_Default,
+                        PipelineTest,
+                        ::testing::Values(TestConfiguration(false, false),
+                                          TestConfiguration(false, true)));
+
+PipelineStageConfiguration makeStageConfig(const std::string& name,
+                                           size_t parallelism,
+                                           size_t capacity = 64)
+{
+    PipelineStageConfiguration config;
+    config.setName(name);
+    config.setParallelism(parallelism);
+    config.setQueueCapacity(capacity);
+    return config;
+}
+
+//==============================================================================
+// TEST CASES
+//==============================================================================
+
+TEST(PipelineConfigurationTest, InvalidValues)
+{
+    PipelineStageConfiguration config;
+    EXPECT_EQ(1u, config.getParallelism());
+    EXPECT_THROW(config.setParallelism(0), std::invalid_argument);
+    EXPECT_THROW(config.setQueueCapacity(0), std::invalid_argument);
+    EXPECT_THROW(config.setQueueId(-10), std::invalid_argument);
+}
+
+TEST_P(PipelineTest, MultiStageUnordered)
+{
+    const int num = 500;
+    auto pipeline = PipelineBuilder<int>(getDispatcher())
+        .addStage([](VoidContextPtr, int&& v)->int { return v * 2; }, makeStageConfig("double", 3, 8))
+        .addStage([](VoidContextPtr ctx, int&& v)->std::string
+        {
+            ctx->yield();
+            return std::to_string(v);
+        }, makeStageConfig("format", 2, 8))
+        .build(16);
+
+    std::vector<int> results;
+    auto consumer = getDispatcher().post([&](VoidContextPtr ctx)->int
+    {
+        std::string value;
+        while (pipeline->pull(ctx, value))
+        {
+            results.push_back(std::stoi(value));
+        }
+        return 0;
+    });
+    for (int i = 0; i < num; ++i)
+    {
+        EXPECT_TRUE(pipeline->push(i));
+    }
+    pipeline->close();
+    pipeline->wait();
+    consumer->get();
+    EXPECT_FALSE(pipeline->push(0)); //closed
+
+    std::vector<int> expected(num);
+    std::iota(expected.begin(), expected.end(), 0);
+    std::transform(expected.begin(), expected.end(), expected.begin(), [](int v){ return v * 2; });
+    std::sort(results.begin(), results.end());
+    EXPECT_EQ(expected, results);
+
+    auto stats = pipeline->getStatistics();
+    ASSERT_EQ(2u, stats.size());
+    EXPECT_EQ("double", stats[0].getName());
+    EXPECT_EQ(3u, stats[0].getParallelism());
+    EXPECT_EQ((size_t)num, stats[0].getProcessedCount());
+    EXPECT_EQ((size_t)num, stats[1].getProcessedCount());
+    EXPECT_EQ(0u, stats[1].getQueueDepth());
+    EXPECT_LE(stats[1].getMaxQueueDepth(), 8u);
+}
+
+TEST_P(PipelineTest, OrderedOutput)
+{
+    const int num = 300;
+    auto pipeline = PipelineBuilder<int>(getDispatcher(), PipelineOrdering::Ordered)
+        .addStage([](VoidContextPtr ctx, int&& v)->int
+        {
+            //uneven processing times to force reordering inside the stage
+            for (int i = 0; i < v % 5; ++i)
+            {
+                ctx->yield();
+            }
+            return v + 1;
+        }, makeStageConfig("increment", 4, 4))
+        .addIoStage([](int&& v)->int { return v * 10; }, makeStageConfig("scale", 2, 4))
+        .build(4);
+
+    auto producer = getDispatcher().post([&](VoidContextPtr ctx)->int
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            pipeline->push(ctx, i);
+        }
+        pipeline->close(ctx);
+        return 0;
+    });
+    std::vector<int> results;
+    int value;
+    while (pipeline->pull(value))
+    {
+        results.push_back(value);
+    }
+    producer->get();
+    pipeline->wait();
+    ASSERT_EQ((size_t)num, results.size());
+    for (int i = 0; i < num; ++i)
+    {
+        EXPECT_EQ((i + 1) * 10, results[i]);
+    }
+}
+
+TEST_P(PipelineTest, SinkStageAndBackpressure)
+{
+    const int num = 100;
+    std::atomic<int> sum{0};
+    auto pipeline = PipelineBuilder<int>(getDispatcher())
+        .addStage([](VoidContextPtr, int&& v)->int { return v; }, makeStageConfig("fast", 2, 4))
+        .addIoStage([&sum](int&& v)->void
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            sum += v;
+        }, makeStageConfig("slow", 1, 2))
+        .build();
+    for (int i = 0; i < num; ++i)
+    {
+        pipeline->push(i);
+    }
+    pipeline->close();
+    pipeline->wait();
+    EXPECT_EQ(num * (num - 1) / 2, sum);
+
+    auto stats = pipeline->getStatistics();
+    ASSERT_EQ(2u, stats.size());
+    EXPECT_EQ((size_t)num, stats[1].getProcessedCount());
+    EXPECT_LE(stats[1].getMaxQueueDepth(), 2u);
+    EXPECT_GT(stats[1].getBlockedPushCount(), 0u); //slow stage throttles the fast one
+    EXPECT_GT(stats[1].getBusyTime().count(), 0);
+    EXPECT_GT(stats[1].getThroughput(), 0);
+}
+
+TEST_P(PipelineTest, StageException)
+{
+    std::atomic<int> processed{0};
+    auto pipeline = PipelineBuilder<int>(getDispatcher(), PipelineOrdering::Ordered)
+        .addStage([](VoidContextPtr, int&& v)->int
+        {
+            if (v == 50)
+            {
+                throw std::runtime_error("bad item");
+            }
+            return v;
+        }, makeStageConfig("validate", 3, 4))
+        .addStage([&processed](VoidContextPtr, int&&)->void { ++processed; }, makeStageConfig("sink", 2, 4))
+        .build();
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (!pipeline->push(i))
+        {
+            break; //pipeline aborted
+        }
+    }
+    pipeline->close();
+    EXPECT_THROW(pipeline->wait(), std::runtime_error);
+    EXPECT_LT(processed, 1000);
+}
+
+TEST_P(PipelineTest, AbortAndDestroy)
+{
+    auto pipeline = PipelineBuilder<int>(getDispatcher())
+        .addStage([](VoidContextPtr ctx, int&& v)->int
+        {
+            ctx->sleep(std::chrono::milliseconds(1));
+            return v;
+        }, makeStageConfig("sleep", 2, 2))
+        .build(2);
+    for (int i = 0; i < 6; ++i)
+    {
+        pipeline->push(i);
+    }
+    pipeline->abort();
+    EXPECT_FALSE(pipeline->push(0));
+    int value;
+    EXPECT_FALSE(pipeline->pull(value));
+    EXPECT_NO_THROW(pipeline->wait());
+    pipeline.reset(); //never drained
+}
+
+TEST_P(PipelineTest, BuildErrors)
+{
+    PipelineBuilder<int> empty(getDispatcher());
+    EXPECT_THROW(empty.build(), std::runtime_error);
+    auto builder = PipelineBuilder<int>(getDispatcher())
+        .addStage([](VoidContextPtr, int&&)->void {});
+    auto pipeline = builder.build();
+    EXPECT_THROW(builder.build(), std::runtime_error);
+    pipeline->close();
+    pipeline->wait();
+}
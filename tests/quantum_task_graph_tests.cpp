@@ -0,0 +1,192 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+#include <quantum_fixture.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace quantum;
+
+//==============================================================================
+// TEST FIXTURES
+//==============================================================================
+
+struct TaskGraphTest: public DispatcherFixture
+{};
+
+INSTANTIATE_TEST_CASE_P(TaskGraphTest_Default,
+                        TaskGraphTest,
+                        ::testing::Values(TestConfiguration(false, false),
+                                          TestConfiguration(false, true)));
+
+//==============================================================================
+// TEST CASES
+//==============================================================================
+
+TEST_P(TaskGraphTest, DiamondWithResults)
+{
+    //Diamond: a feeds b and c, which both feed d
+    TaskGraph graph(getDispatcher());
+    auto a = graph.addNode([](VoidContextPtr, const TaskGraphInputs& in)->int
+    {
+        EXPECT_EQ(0u, in.size());
+        return 10;
+    });
+    auto b = graph.addNode([a](VoidContextPtr ctx, const TaskGraphInputs& in)->int
+    {
+        ctx->yield();
+        return in.get(a) + 1;
+    });
+    auto c = graph.addIoNode([a](const TaskGraphInputs& in)->std::string
+    {
+        return std::to_string(in.get(a) * 2);
+    });
+    auto d = graph.addNode([b, c](VoidContextPtr, const TaskGraphInputs& in)->std::string
+    {
+        EXPECT_EQ(2u, in.size());
+        return std::to_string(in.get(b)) + "/" + in.get(c);
+    });
+    graph.addEdge(a, b);
+    graph.addEdge(a, c);
+    graph.addEdge(b, d);
+    graph.addEdge(c, d);
+    graph.addEdge(c, d); //duplicate is ignored
+    EXPECT_EQ(4u, graph.getNumNodes());
+
+    EXPECT_EQ(0, graph.run()->get());
+    EXPECT_FALSE(graph.isRunning());
+    EXPECT_EQ("11/20", graph.getResult(d));
+    EXPECT_EQ(10, graph.getResult(a));
+}
+
+TEST_P(TaskGraphTest, DependencyOrderAndReRun)
+{
+    //Fan-out of 20 nodes each depending on the root and feeding a single sink
+    const int width = 20;
+    std::atomic<int> rootRuns{0};
+    std::atomic<int> middleRuns{0};
+    std::atomic<int> sinkRuns{0};
+    TaskGraph graph(getDispatcher());
+    auto root = graph.addNode([&](VoidContextPtr, const TaskGraphInputs&)->void
+    {
+        EXPECT_EQ(middleRuns, rootRuns * width);
+        ++rootRuns;
+    });
+    auto sink = graph.addNode([&](VoidContextPtr, const TaskGraphInputs& in)->int
+    {
+        EXPECT_EQ(middleRuns, rootRuns * width);
+        EXPECT_EQ((size_t)width, in.size());
+        return ++sinkRuns;
+    });
+    for (int i = 0; i < width; ++i)
+    {
+        auto middle = graph.addNode([&](VoidContextPtr, const TaskGraphInputs&)->int
+        {
+            EXPECT_EQ(sinkRuns + 1, rootRuns);
+            return ++middleRuns;
+        });
+        graph.addEdge(root, middle);
+        graph.addEdge(middle, sink);
+    }
+    for (int run = 1; run <= 10; ++run)
+    {
+        graph.run()->get();
+        EXPECT_EQ(run, graph.getResult(sink));
+    }
+    EXPECT_EQ(10, rootRuns);
+    EXPECT_EQ(10 * width, middleRuns);
+}
+
+TEST_P(TaskGraphTest, RunFromCoroutine)
+{
+    TaskGraph graph(getDispatcher());
+    auto a = graph.addNode([](VoidContextPtr, const TaskGraphInputs&)->int { return 3; });
+    auto b = graph.addNode([a](VoidContextPtr, const TaskGraphInputs& in)->int { return in.get(a) * 3; });
+    graph.addEdge(a, b);
+    int result = getDispatcher().post([&](VoidContextPtr ctx)->int
+    {
+        graph.run(ctx)->get(ctx);
+        return graph.getResult(b);
+    })->get();
+    EXPECT_EQ(9, result);
+}
+
+TEST_P(TaskGraphTest, NodeException)
+{
+    std::atomic<int> skipped{0};
+    TaskGraph graph(getDispatcher());
+    auto a = graph.addNode([](VoidContextPtr, const TaskGraphInputs&)->int
+    {
+        throw std::runtime_error("failed node");
+    });
+    auto b = graph.addNode([&](VoidContextPtr, const TaskGraphInputs&)->int { return ++skipped; });
+    auto c = graph.addNode([](VoidContextPtr, const TaskGraphInputs&)->int { return 1; });
+    graph.addEdge(a, b);
+    graph.addEdge(c, b);
+    EXPECT_THROW(graph.run()->get(), std::runtime_error);
+    EXPECT_EQ(0, skipped);
+    EXPECT_THROW(graph.getResult(b), std::runtime_error);
+    EXPECT_THROW(graph.run()->get(), std::runtime_error); //can be run again
+}
+
+TEST_P(TaskGraphTest, IndependentBranchRunsAfterFailure)
+{
+    //a -> b -> c fails at a, x -> y is independent and starts once a has already failed
+    std::atomic_bool hasFailed{false};
+    std::atomic<int> numSkipped{0};
+    TaskGraph graph(getDispatcher());
+    auto a = graph.addNode([&](VoidContextPtr, const TaskGraphInputs&)->int
+    {
+        hasFailed = true;
+        throw std::runtime_error("failed node");
+    });
+    auto b = graph.addNode([&](VoidContextPtr, const TaskGraphInputs&)->int { return ++numSkipped; });
+    auto c = graph.addNode([&](VoidContextPtr, const TaskGraphInputs&)->int { return ++numSkipped; });
+    auto x = graph.addNode([&](VoidContextPtr ctx, const TaskGraphInputs&)->int
+    {
+        while (!hasFailed) ctx->yield();
+        return 1;
+    });
+    auto y = graph.addIoNode([x](const TaskGraphInputs& in)->int { return in.get(x) + 1; });
+    graph.addEdge(a, b);
+    graph.addEdge(b, c);
+    graph.addEdge(x, y);
+    EXPECT_THROW(graph.run()->get(), std::runtime_error);
+    EXPECT_EQ(0, numSkipped);
+    EXPECT_THROW(graph.getResult(c), std::runtime_error);
+    EXPECT_EQ(1, graph.getResult(x));
+    EXPECT_EQ(2, graph.getResult(y));
+}
+
+TEST_P(TaskGraphTest, InvalidGraphs)
+{
+    TaskGraph graph(getDispatcher());
+    EXPECT_EQ(0, graph.run()->get()); //empty graph completes immediately
+
+    auto a = graph.addNode([](VoidContextPtr, const TaskGraphInputs&)->int { return 0; });
+    auto b = graph.addNode([](VoidContextPtr, const TaskGraphInputs&)->int { return 0; });
+    auto c = graph.addNode([a](VoidContextPtr, const TaskGraphInputs& in)->int { return in.get(a); });
+    EXPECT_THROW(graph.addEdge(a, a), std::invalid_argument);
+    graph.addEdge(a, b);
+    graph.addEdge(b, a);
+    EXPECT_THROW(graph.run(), std::runtime_error); //cycle
+
+    TaskGraph other(getDispatcher());
+    auto d = other.addNode([](VoidContextPtr, const TaskGraphInputs&)->int { return 0; });
+    auto e = other.addNode([c](VoidContextPtr, const TaskGraphInputs& in)->int { return in.get(c); });
+    other.addEdge(d, e);
+    EXPECT_THROW(other.run()->get(), std::invalid_argument); //c is not a predecessor of e
+    EXPECT_THROW(other.addEdge(d, c), std::invalid_argument); //c belongs to another graph
+}
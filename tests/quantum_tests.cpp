@@ -22,6 +22,11 @@
 #include <list>
 #include <memory>
 #include <functional>
+#include <numeric>
+#include <random>
+#include <algorithm>
+#include <sstream>
+#include <limits>
 
 using namespace quantum;
 using ms = std::chrono::milliseconds;
@@ -114,6 +119,15 @@ INSTANTIATE_TEST_CASE_P(MapReduce_Default,
                                           TestConfiguration(false, true)));
 
 
+struct SortTest: public DispatcherFixture
+{};
+
+INSTANTIATE_TEST_CASE_P(SortTest_Default,
+                        SortTest,
+                        ::testing::Values(TestConfiguration(false, false),
+                                          TestConfiguration(false, true)));
+
+
 struct FutureJoinerTest: public DispatcherFixture
 {};
 
@@ -130,6 +144,14 @@ INSTANTIATE_TEST_CASE_P(CoroLocalStorageTest_Default,
                         ::testing::Values(TestConfiguration(false, false),
                                           TestConfiguration(false, true)));
 
+struct GeneratorTest: public DispatcherFixture
+{};
+
+INSTANTIATE_TEST_CASE_P(GeneratorTest_Default,
+                        GeneratorTest,
+                        ::testing::Values(TestConfiguration(false, false),
+                                          TestConfiguration(false, true)));
+
 struct CleanupTest: public DispatcherFixture
 {};
 
@@ -321,6 +343,680 @@ TEST_P(CoreTest, CheckCoroutineQueuing)
     EXPECT_EQ((size_t)0, getDispatcher().size(IQueue::QueueType::Coro));
 }
 
+TEST(WatchdogTest, ReportsLongSlices)
+{
+    struct Report
+    {
+        int _queueId;
+        uint64_t _taskId;
+        std::chrono::nanoseconds _elapsed;
+    };
+    std::mutex mutex;
+    std::vector<Report> reports;
+    Configuration config;
+    config.setNumCoroutineThreads(2);
+    config.setNumIoThreads(1);
+    config.setWatchdogThreshold(ms(20));
+    config.setWatchdogCallback([&](int queueId, uint64_t taskId, std::chrono::nanoseconds elapsed)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        reports.push_back({queueId, taskId, elapsed});
+    });
+    {
+        Dispatcher dispatcher(config);
+        //monopolizes its thread
+        auto hog = dispatcher.post(0, false, [](VoidContextPtr)->int
+        {
+            std::this_thread::sleep_for(ms(150));
+            return 0;
+        });
+        //runs for just as long but yields regularly
+        auto polite = dispatcher.post(1, false, [](VoidContextPtr ctx)->int
+        {
+            auto end = std::chrono::steady_clock::now() + ms(150);
+            while (std::chrono::steady_clock::now() < end)
+            {
+                std::this_thread::sleep_for(ms(1));
+                ctx->yield();
+            }
+            return 0;
+        });
+        hog->get();
+        polite->get();
+    }
+    ASSERT_EQ(1u, reports.size()); //reported once per slice
+    EXPECT_EQ(0, reports[0]._queueId);
+    EXPECT_NE(0u, reports[0]._taskId);
+    EXPECT_GE(reports[0]._elapsed, ms(20));
+}
+
+TEST(CoroutineReuseTest, TasksOnPooledCoroutines)
+{
+    Configuration config;
+    config.setNumCoroutineThreads(2);
+    config.setNumIoThreads(1);
+    config.setReuseCoroutines(true);
+    config.setMaxIdleCoroutines(4); //fewer than the number of concurrent tasks
+    std::atomic_int numLeaked{0};
+    {
+        Dispatcher dispatcher(config);
+        std::vector<ThreadContextPtr<int>> contexts;
+        for (int i = 0; i < 200; ++i)
+        {
+            contexts.push_back(dispatcher.post(i % 2, false, [i, &numLeaked](VoidContextPtr ctx)->int
+            {
+                //coroutine-local variables belong to the task and not to the coroutine running it
+                if (local::variable<int>("reuse") != nullptr)
+                {
+                    ++numLeaked;
+                }
+                int value = i;
+                local::variable<int>("reuse") = &value;
+                if (i % 3 == 0)
+                {
+                    ctx->yield();
+                }
+                if (i % 7 == 0)
+                {
+                    ctx->sleep(ms(1));
+                }
+                if (i % 10 == 0)
+                {
+                    throw std::runtime_error("error");
+                }
+                return ctx->post([i](VoidContextPtr)->int { return i; })->get(ctx) + *local::variable<int>("reuse");
+            }));
+        }
+        for (int i = 0; i < 200; ++i)
+        {
+            if (i % 10 == 0)
+            {
+                EXPECT_THROW(contexts[i]->get(), std::runtime_error);
+            }
+            else
+            {
+                EXPECT_EQ(2 * i, contexts[i]->get());
+            }
+        }
+
+        //continuations
+        std::vector<int> v;
+        dispatcher.postFirst([&v](VoidContextPtr)->int { v.push_back(1); return 0; })->
+                   then([&v](VoidContextPtr)->int { v.push_back(2); return 0; })->
+                   finally([&v](VoidContextPtr)->int { v.push_back(3); return 0; })->end();
+        dispatcher.drain();
+        EXPECT_EQ((std::vector<int>{1, 2, 3}), v);
+    }
+    EXPECT_EQ(0, numLeaked);
+}
+
+TEST(CoroutineReuseTest, DestroyingSuspendedCoroutineUnwindsTask)
+{
+    struct Unwinder
+    {
+        ~Unwinder() { ++numUnwound; }
+        int& numUnwound;
+    };
+    int numUnwound = 0;
+    CoroutinePool pool(2, 1);
+    int rc = 0;
+    {
+        CoroutinePool::Handle coro = pool.acquire(1, [&numUnwound](Traits::Yield& yield)->int
+        {
+            Unwinder unwinder{numUnwound};
+            while (true) yield();
+            return 0;
+        });
+        coro->resume(rc);
+        EXPECT_FALSE(coro->isIdle());
+    }
+    EXPECT_EQ(1, numUnwound);
+    
+    //a completed task leaves the coroutine idle and ready for the next one
+    CoroutinePool::Handle coro = pool.acquire(1, [](Traits::Yield& yield)->int { return yield.get() = 5; });
+    coro->resume(rc);
+    EXPECT_TRUE(coro->isIdle());
+    EXPECT_EQ(5, rc);
+    pool.release(std::move(coro));
+    EXPECT_EQ(1u, pool.size());
+    coro = pool.acquire(1, [](Traits::Yield& yield)->int { return yield.get() = 6; });
+    EXPECT_EQ(0u, pool.size());
+    coro->resume(rc);
+    EXPECT_EQ(6, rc);
+}
+
+TEST_P(CoreTest, DeadlockDetection)
+{
+    using Report = DeadlockDetector::Report;
+    std::mutex reportMutex;
+    std::vector<Report> reports;
+    auto getReports = [&]()->std::vector<Report>
+    {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        return reports;
+    };
+    auto waitForReports = [&](size_t num)->bool
+    {
+        for (int i = 0; (i < 5000) && (getReports().size() < num); ++i)
+        {
+            std::this_thread::sleep_for(ms(1));
+        }
+        return getReports().size() >= num;
+    };
+    struct Disabler
+    {
+        ~Disabler() { DeadlockDetector::disable(); }
+    } disabler;
+    DeadlockDetector::enable(ms(50), [&](const Report& report)
+    {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        reports.push_back(report);
+    });
+    
+    //Two coroutines acquiring the same mutexes in opposite order
+    Mutex m1, m2;
+    std::atomic_int numLocked{0};
+    auto a = getDispatcher().post([&](VoidContextPtr ctx)->int
+    {
+        Mutex::Guard lock1(ctx, m1);
+        ++numLocked;
+        while (numLocked < 2) ctx->yield();
+        Mutex::Guard lock2(ctx, m2);
+        return 0;
+    });
+    auto b = getDispatcher().post([&](VoidContextPtr ctx)->int
+    {
+        Mutex::Guard lock2(ctx, m2);
+        ++numLocked;
+        while (numLocked < 2) ctx->yield();
+        Mutex::Guard lock1(ctx, m1);
+        return 0;
+    });
+    EXPECT_TRUE(waitForReports(1));
+    EXPECT_EQ(2u, DeadlockDetector::getWaits().size());
+    std::this_thread::sleep_for(ms(100));
+    std::vector<Report> deadlocks = getReports();
+    m1.unlock(); //break the cycle
+    a->get();
+    b->get();
+    ASSERT_EQ(1u, deadlocks.size()); //each wait is reported once
+    EXPECT_EQ(Report::Type::Deadlock, deadlocks[0]._type);
+    ASSERT_EQ(2u, deadlocks[0]._waits.size());
+    const DeadlockDetector::Wait& w0 = deadlocks[0]._waits[0];
+    const DeadlockDetector::Wait& w1 = deadlocks[0]._waits[1];
+    EXPECT_TRUE(w0._isCoroutine && w1._isCoroutine);
+    EXPECT_EQ(DeadlockDetector::Resource::Mutex, w0._resource);
+    EXPECT_EQ(DeadlockDetector::Resource::Mutex, w1._resource);
+    EXPECT_NE(w0._object, w1._object);
+    EXPECT_EQ(w1._waiterId, w0._ownerId);
+    EXPECT_EQ(w0._waiterId, w1._ownerId);
+    std::ostringstream out;
+    out << deadlocks[0];
+    EXPECT_EQ(0u, out.str().find("deadlock"));
+    EXPECT_NE(std::string::npos, out.str().find("waits on mutex"));
+    EXPECT_TRUE(DeadlockDetector::getWaits().empty());
+    
+    //A thread blocked on a mutex owned by a coroutine waiting on a future which is never set
+    Promise<int> promise;
+    Mutex m3;
+    std::atomic_bool isLocked{false};
+    auto holder = getDispatcher().post([&](VoidContextPtr ctx)->int
+    {
+        Mutex::Guard lock(ctx, m3);
+        isLocked = true;
+        return promise.getICoroFuture()->get(ctx);
+    });
+    while (!isLocked) std::this_thread::sleep_for(ms(1));
+    std::thread waiter([&]()
+    {
+        Mutex::Guard lock(m3);
+    });
+    EXPECT_TRUE(waitForReports(3));
+    promise.set(5);
+    waiter.join();
+    EXPECT_EQ(5, holder->get());
+    std::vector<Report> longWaits = getReports();
+    ASSERT_EQ(3u, longWaits.size());
+    longWaits.erase(longWaits.begin());
+    if (longWaits[0]._waits[0]._isCoroutine)
+    {
+        std::swap(longWaits[0], longWaits[1]);
+    }
+    //the thread wait includes the wait of the mutex owner
+    EXPECT_EQ(Report::Type::LongWait, longWaits[0]._type);
+    ASSERT_EQ(2u, longWaits[0]._waits.size());
+    EXPECT_EQ(DeadlockDetector::Resource::Mutex, longWaits[0]._waits[0]._resource);
+    EXPECT_EQ(&m3, longWaits[0]._waits[0]._object);
+    EXPECT_GE(longWaits[0]._waits[0]._elapsed, ms(50));
+    EXPECT_EQ(longWaits[0]._waits[1]._waiterId, longWaits[0]._waits[0]._ownerId);
+    EXPECT_TRUE(longWaits[0]._waits[1]._isCoroutine);
+    EXPECT_EQ(DeadlockDetector::Resource::Future, longWaits[0]._waits[1]._resource);
+    //the coroutine wait
+    EXPECT_EQ(Report::Type::LongWait, longWaits[1]._type);
+    ASSERT_EQ(1u, longWaits[1]._waits.size());
+    EXPECT_EQ(DeadlockDetector::Resource::Future, longWaits[1]._waits[0]._resource);
+    EXPECT_EQ(0u, longWaits[1]._waits[0]._ownerId);
+}
+
+#ifdef __QUANTUM_ENABLE_LOCK_PROFILING
+TEST_P(CoreTest, LockProfiling)
+{
+    LockProfiler::reset();
+    const int numThreads = 4;
+    const int numIterations = 10000;
+    SpinLock spinlock("LockProfilingTest::spinlock");
+    int counter = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = 0; i < numIterations; ++i)
+            {
+                SpinLock::Guard guard(spinlock);
+                ++counter;
+            }
+        });
+    }
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(numThreads * numIterations, counter);
+    const LockProfile& spinProfile = LockProfiler::get("LockProfilingTest::spinlock");
+    EXPECT_EQ((size_t)(numThreads * numIterations), spinProfile.acquisitions());
+    EXPECT_EQ(spinProfile.acquisitions(), spinProfile.holdTime().count());
+    EXPECT_LE(spinProfile.contendedAcquisitions(), spinProfile.spinCount());
+    
+    //coroutines yield while holding the mutex so that the others have to wait
+    Mutex mutex("LockProfilingTest::mutex");
+    std::vector<ThreadContextPtr<int>> contexts;
+    for (int i = 0; i < 10; ++i)
+    {
+        contexts.push_back(getDispatcher().post([&mutex](VoidContextPtr ctx)->int
+        {
+            Mutex::Guard guard(ctx, mutex);
+            ctx->yield();
+            return 0;
+        }));
+    }
+    for (auto&& ctx : contexts)
+    {
+        ctx->get();
+    }
+    const LockProfile& mutexProfile = LockProfiler::get("LockProfilingTest::mutex");
+    EXPECT_EQ(10u, mutexProfile.acquisitions());
+    EXPECT_EQ(10u, mutexProfile.holdTime().count());
+    EXPECT_EQ(0u, mutexProfile.spinCount());
+    EXPECT_GT(mutexProfile.yieldCount(), 0u);
+    EXPECT_GT(mutexProfile.contendedAcquisitions(), 0u);
+    
+    ReadWriteSpinLock rwlock("LockProfilingTest::rwlock");
+    rwlock.lockRead();
+    rwlock.lockRead();
+    rwlock.unlockRead();
+    rwlock.unlockRead();
+    rwlock.lockWrite();
+    rwlock.unlockWrite();
+    const LockProfile& rwProfile = LockProfiler::get("LockProfilingTest::rwlock");
+    EXPECT_EQ(3u, rwProfile.acquisitions());
+    EXPECT_EQ(1u, rwProfile.holdTime().count()); //only write locks are timed
+    
+    //internal locks are registered by name
+    LockProfiler::ProfileMap profiles = LockProfiler::getProfiles();
+    ASSERT_NE(profiles.end(), profiles.find("TaskQueue::runQueue"));
+    EXPECT_GT(profiles["TaskQueue::runQueue"]->acquisitions(), 0u);
+    std::ostringstream report;
+    LockProfiler::print(report);
+    EXPECT_NE(std::string::npos, report.str().find("LockProfilingTest::mutex: acquisitions=10"));
+    
+    LockProfiler::reset();
+    EXPECT_EQ(0u, spinProfile.acquisitions());
+    EXPECT_EQ(0u, spinProfile.holdTime().count());
+}
+#endif
+
+TEST(QueueStatisticsTest, ConcurrentCounters)
+{
+    const int numThreads = 2 * QueueStatistics::numShards + 1; //several threads per shard
+    const int numIterations = 10000;
+    QueueStatistics stats;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&stats, numIterations]()
+        {
+            for (int i = 0; i < numIterations; ++i)
+            {
+                stats.incPostedCount();
+                stats.incNumElements();
+                stats.incCompletedCount();
+                stats.decNumElements();
+                if (i % 2 == 0)
+                {
+                    stats.incErrorCount();
+                }
+            }
+        });
+    }
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+    const size_t total = numThreads * numIterations;
+    EXPECT_EQ(0u, stats.numElements());
+    EXPECT_EQ(total, stats.postedCount());
+    EXPECT_EQ(total, stats.completedCount());
+    EXPECT_EQ(total / 2, stats.errorCount());
+    EXPECT_EQ(0u, stats.highPriorityCount());
+    
+    QueueStatistics copy(stats);
+    copy += stats;
+    EXPECT_EQ(2 * total, copy.postedCount());
+    EXPECT_EQ(total, copy.errorCount());
+    stats.decNumElements(); //does not go below zero
+    EXPECT_EQ(0u, stats.numElements());
+    stats.reset();
+    EXPECT_EQ(0u, stats.postedCount());
+    EXPECT_EQ(0u, stats.completedCount());
+}
+
+TEST(HistogramTest, PercentilesAndMerge)
+{
+    Histogram histogram;
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.percentile(50));
+    for (uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value);
+    }
+    EXPECT_EQ(1000u, histogram.count());
+    EXPECT_EQ(1u, histogram.min());
+    EXPECT_EQ(1000u, histogram.max());
+    EXPECT_DOUBLE_EQ(500.5, histogram.mean());
+    EXPECT_EQ(1u, histogram.percentile(0));
+    EXPECT_EQ(10u, histogram.percentile(1)); //exact below 16
+    EXPECT_EQ(1000u, histogram.percentile(100));
+    //values above 16 are within 1/16th of their magnitude
+    EXPECT_NEAR(500.0, (double)histogram.percentile(50), 500.0/16);
+    EXPECT_NEAR(990.0, (double)histogram.percentile(99), 990.0/16);
+    EXPECT_GE(histogram.percentile(50), 500u);
+    
+    Histogram other;
+    other.record(std::numeric_limits<uint64_t>::max());
+    other.record(0);
+    histogram += other;
+    EXPECT_EQ(1002u, histogram.count());
+    EXPECT_EQ(0u, histogram.min());
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), histogram.max());
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(), histogram.percentile(100));
+    
+    Histogram copy(histogram);
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(1002u, copy.count());
+}
+
+#ifdef __QUANTUM_ENABLE_TASK_TIMING
+TEST_P(CoreTest, TaskTimingStats)
+{
+    const size_t numTasks = 10;
+    for (size_t i = 0; i < numTasks; ++i)
+    {
+        getDispatcher().post(1, false, [](VoidContextPtr ctx)->int
+        {
+            for (int y = 0; y < 3; ++y)
+            {
+                ctx->yield();
+            }
+            //burn some cpu
+            auto end = std::chrono::steady_clock::now() + ms(1);
+            while (std::chrono::steady_clock::now() < end);
+            return 0;
+        });
+        getDispatcher().postAsyncIo(2, false, []()->int
+        {
+            std::this_thread::sleep_for(ms(2));
+            return 0;
+        });
+    }
+    //timings are recorded right after the task completes
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (((getDispatcher().stats(IQueue::QueueType::Coro, 1).totalTime().count() < numTasks) ||
+            (getDispatcher().stats(IQueue::QueueType::IO, 2).totalTime().count() < numTasks)) &&
+           (std::chrono::steady_clock::now() < deadline))
+    {
+        std::this_thread::sleep_for(ms(1));
+    }
+    
+    QueueStatistics coroStats = getDispatcher().stats(IQueue::QueueType::Coro, 1);
+    EXPECT_EQ(numTasks, coroStats.queueWaitTime().count());
+    EXPECT_EQ(numTasks, coroStats.executionTime().count());
+    EXPECT_EQ(numTasks, coroStats.resumeCount().count());
+    EXPECT_EQ(3u, coroStats.resumeCount().min());
+    EXPECT_EQ(3u, coroStats.resumeCount().max());
+    EXPECT_GE(coroStats.executionTime().min(), (uint64_t)std::chrono::nanoseconds(ms(1)).count());
+    EXPECT_GE(coroStats.totalTime().min(), coroStats.executionTime().min());
+    
+    QueueStatistics ioStats = getDispatcher().stats(IQueue::QueueType::IO, 2);
+    EXPECT_EQ(numTasks, ioStats.executionTime().count());
+    EXPECT_EQ(0u, ioStats.resumeCount().max());
+    EXPECT_GE(ioStats.executionTime().min(), (uint64_t)std::chrono::nanoseconds(ms(2)).count());
+    //tasks queue up behind each other on a single IO thread
+    EXPECT_GT(ioStats.queueWaitTime().max(), ioStats.executionTime().min());
+    
+    //aggregated over all queues
+    EXPECT_GE(getDispatcher().stats().totalTime().count(), 2 * numTasks);
+    getDispatcher().resetStats();
+    EXPECT_EQ(0u, getDispatcher().stats().totalTime().count());
+}
+#endif
+
+TEST_P(CoreTest, TracerLifecycle)
+{
+    Tracer::enable();
+    getDispatcher().post(1, false, [](VoidContextPtr ctx)->int
+    {
+        ctx->yield();
+        ctx->sleep(ms(2));
+        return ctx->postAsyncIo([]()->int
+        {
+            std::this_thread::sleep_for(ms(5));
+            return 0;
+        })->get(ctx);
+    });
+    getDispatcher().drain();
+    Tracer::disable();
+    
+    std::vector<Tracer::Event> events = Tracer::getEvents();
+    auto start = std::find_if(events.begin(), events.end(), [](const Tracer::Event& event)
+    {
+        return (event._type == Tracer::EventType::Start) && (event._queueId == 1);
+    });
+    ASSERT_NE(events.end(), start);
+    std::vector<Tracer::EventType> coroEvents;
+    size_t numIoEvents = 0;
+    for (const Tracer::Event& event : events)
+    {
+        if (event._taskId == start->_taskId)
+        {
+            coroEvents.push_back(event._type);
+        }
+        else if ((event._type == Tracer::EventType::IoPost) ||
+                 (event._type == Tracer::EventType::IoStart) ||
+                 (event._type == Tracer::EventType::IoComplete))
+        {
+            ++numIoEvents;
+        }
+    }
+    ASSERT_LE(4u, coroEvents.size());
+    EXPECT_EQ(Tracer::EventType::Post, coroEvents.front());
+    EXPECT_EQ(Tracer::EventType::Start, coroEvents[1]);
+    EXPECT_EQ(Tracer::EventType::YieldRunning, coroEvents[2]);
+    EXPECT_EQ(Tracer::EventType::Complete, coroEvents.back());
+    auto contains = [&coroEvents](Tracer::EventType type)
+    {
+        return std::find(coroEvents.begin(), coroEvents.end(), type) != coroEvents.end();
+    };
+    EXPECT_TRUE(contains(Tracer::EventType::Resume));
+    EXPECT_TRUE(contains(Tracer::EventType::YieldSleeping));
+    EXPECT_TRUE(contains(Tracer::EventType::YieldBlocked));
+    EXPECT_EQ(3u, numIoEvents);
+    
+    std::ostringstream trace;
+    Tracer::dump(trace);
+    std::string json = trace.str();
+    EXPECT_EQ(0u, json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_EQ('}', json.back());
+    EXPECT_NE(std::string::npos, json.find("\"reason\":\"Blocked\""));
+    EXPECT_NE(std::string::npos, json.find("\"reason\":\"Sleeping\""));
+    EXPECT_NE(std::string::npos, json.find("\"cat\":\"io\""));
+    auto countOf = [&json](const std::string& pattern)
+    {
+        size_t count = 0;
+        for (size_t pos = json.find(pattern); pos != std::string::npos; pos = json.find(pattern, pos + 1))
+        {
+            ++count;
+        }
+        return count;
+    };
+    EXPECT_EQ(countOf("\"ph\":\"B\""), countOf("\"ph\":\"E\""));
+    EXPECT_EQ(countOf("\"ph\":\"s\""), countOf("\"ph\":\"f\""));
+    
+    //nothing is recorded while disabled
+    Tracer::clear();
+    getDispatcher().post(1, false, DummyCoro);
+    getDispatcher().drain();
+    EXPECT_TRUE(Tracer::getEvents().empty());
+}
+
+TEST_P(CoreTest, TracerRingBufferOverflow)
+{
+    const size_t capacity = 8;
+    Tracer::enable(capacity);
+    for (int i = 0; i < 100; ++i)
+    {
+        getDispatcher().post(1, false, DummyCoro);
+    }
+    getDispatcher().drain();
+    Tracer::disable();
+    std::map<uint32_t, size_t> eventsPerThread;
+    for (const Tracer::Event& event : Tracer::getEvents())
+    {
+        ++eventsPerThread[event._threadId];
+    }
+    ASSERT_FALSE(eventsPerThread.empty());
+    for (auto&& entry : eventsPerThread)
+    {
+        EXPECT_EQ(capacity, entry.second); //only the latest events are kept
+    }
+    Tracer::clear();
+    EXPECT_THROW(Tracer::enable(0), std::invalid_argument);
+}
+
+TEST_P(CoreTest, DispatcherSnapshot)
+{
+    std::atomic_bool release{false};
+    struct Releaser
+    {
+        ~Releaser() { _release = true; } //unblock all the tasks even if an assertion fails
+        std::atomic_bool& _release;
+    } releaser{release};
+    auto blocked = getDispatcher().post(1, false, [&release](VoidContextPtr ctx)->int
+    {
+        local::setTag("blocked");
+        return ctx->postAsyncIo([&release]()->int
+        {
+            while (!release)
+            {
+                std::this_thread::sleep_for(ms(1));
+            }
+            return 0;
+        })->get(ctx);
+    });
+    auto sleeping = getDispatcher().post(1, false, [](VoidContextPtr ctx)->int
+    {
+        local::setTag("sleeping");
+        ctx->sleep(ms(300));
+        return 0;
+    });
+    //hogs its thread so that the next task on the same queue cannot start
+    auto running = getDispatcher().post(3, false, [&release](VoidContextPtr)->int
+    {
+        local::setTag("running");
+        while (!release)
+        {
+            std::this_thread::sleep_for(ms(1));
+        }
+        return 0;
+    });
+    
+    auto findTag = [](const DispatcherSnapshot& snapshot, const char* tag)->const TaskSnapshot*
+    {
+        for (const TaskSnapshot& task : snapshot.getTasks())
+        {
+            if (task._tag && (std::string(task._tag) == tag))
+            {
+                return &task;
+            }
+        }
+        return nullptr;
+    };
+    auto isSettled = [&](const DispatcherSnapshot& snapshot)->bool
+    {
+        const TaskSnapshot* b = findTag(snapshot, "blocked");
+        const TaskSnapshot* s = findTag(snapshot, "sleeping");
+        const TaskSnapshot* r = findTag(snapshot, "running");
+        return b && (b->_state == TaskSnapshot::State::Blocked) &&
+               s && (s->_state == TaskSnapshot::State::Sleeping) &&
+               r && (r->_state == TaskSnapshot::State::Running);
+    };
+    DispatcherSnapshot snapshot = getDispatcher().snapshot();
+    for (int i = 0; (i < 200) && !isSettled(snapshot); ++i)
+    {
+        std::this_thread::sleep_for(ms(5));
+        snapshot = getDispatcher().snapshot();
+    }
+    ASSERT_TRUE(isSettled(snapshot));
+    auto pending = getDispatcher().post(3, true, [](VoidContextPtr)->int { return 0; });
+    snapshot = getDispatcher().snapshot();
+    ASSERT_TRUE(isSettled(snapshot));
+    EXPECT_EQ(1, findTag(snapshot, "blocked")->_queueId);
+    EXPECT_EQ(IQueue::QueueType::Coro, findTag(snapshot, "blocked")->_queueType);
+    EXPECT_EQ(ITask::Type::Standalone, findTag(snapshot, "sleeping")->_type);
+    EXPECT_EQ(3, findTag(snapshot, "running")->_queueId);
+    EXPECT_GT(findTag(snapshot, "running")->_age.count(), 0);
+    
+    auto notStarted = std::find_if(snapshot.getTasks().begin(), snapshot.getTasks().end(), [](const TaskSnapshot& task)
+    {
+        return (task._queueId == 3) && (task._state == TaskSnapshot::State::NotStarted);
+    });
+    ASSERT_NE(snapshot.getTasks().end(), notStarted);
+    EXPECT_TRUE(notStarted->_isHighPriority);
+    EXPECT_EQ(nullptr, notStarted->_tag);
+    
+    //summaries are consistent with the task list
+    size_t total = 0;
+    for (int state = 0; state < (int)TaskSnapshot::State::Max; ++state)
+    {
+        size_t count = snapshot.getCount((TaskSnapshot::State)state);
+        EXPECT_EQ(count, snapshot.getAgeHistogram((TaskSnapshot::State)state).count());
+        total += count;
+    }
+    EXPECT_EQ(snapshot.getTasks().size(), total);
+    EXPECT_GE(snapshot.getCount(TaskSnapshot::State::Blocked), 1u);
+    std::ostringstream out;
+    out << snapshot;
+    EXPECT_NE(std::string::npos, out.str().find("tag=sleeping"));
+    
+    release = true;
+    blocked->get();
+    sleeping->get();
+    running->get();
+    pending->get();
+    local::setTag("ignored"); //no effect outside of a coroutine
+}
+
 TEST_P(CoreTest, CheckIoQueuing)
 {
     //IO (10 tasks)
@@ -418,6 +1114,48 @@ TEST_P(CoreTest, CheckIoQueuingFromACoroutine)
     EXPECT_EQ((size_t)0, getDispatcher().size());
 }
 
+TEST_P(CoreTest, CheckLiteTasks)
+{
+    std::vector<ThreadFuturePtr<int>> futures;
+    for (int i = 0; i < 10; ++i)
+    {
+        futures.push_back(getDispatcher().postLite2([i]()->int
+        {
+            int value = i;
+            // run-to-completion tasks have no coroutine context but can use coro-local storage
+            EXPECT_EQ(nullptr, local::context());
+            local::variable<int>("liteTask") = &value;
+            EXPECT_EQ(&value, local::variable<int>("liteTask"));
+            return value * 2;
+        }));
+    }
+    futures.push_back(getDispatcher().postLite(1, true, [](ThreadPromisePtr<int> promise)->int
+    {
+        return promise->set(100);
+    }));
+    futures.push_back(getDispatcher().postLite2(2, false, []()->int
+    {
+        throw std::runtime_error("lite task error");
+    }));
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_EQ(i * 2, futures[i]->get());
+    }
+    EXPECT_EQ(100, futures[10]->get());
+    EXPECT_THROW(futures[11]->get(), std::runtime_error);
+    getDispatcher().drain();
+    
+    //Posted
+    EXPECT_EQ((size_t)1, getDispatcher().stats(IQueue::QueueType::Coro, 1).highPriorityCount());
+    EXPECT_EQ((size_t)12, getDispatcher().stats(IQueue::QueueType::Coro).postedCount());
+    EXPECT_EQ((size_t)0, getDispatcher().stats(IQueue::QueueType::IO).postedCount());
+    
+    //Completed and errors
+    EXPECT_EQ((size_t)11, getDispatcher().stats(IQueue::QueueType::Coro).completedCount());
+    EXPECT_EQ((size_t)1, getDispatcher().stats(IQueue::QueueType::Coro, 2).errorCount());
+    EXPECT_EQ((size_t)0, getDispatcher().size());
+}
+
 TEST_P(CoreTest, CheckCoroutineErrors)
 {
     std::string s("original"); //string must remain unchanged
@@ -1045,6 +1783,21 @@ TEST_P(PromiseTest, FutureWithoutTimeout)
     EXPECT_EQ(status, std::future_status::ready);
 }
 
+TEST_P(PromiseTest, FutureTimeoutWithException)
+{
+    Dispatcher& dispatcher = getDispatcher();
+    Promise<int> promise;
+    promise.setException(std::make_exception_ptr(std::runtime_error("error")));
+
+    //an exception is a ready state, hence waiting does not time out
+    EXPECT_EQ(std::future_status::ready, promise.getIThreadFuture()->waitFor(ms(100)));
+    ThreadContext<int>::Ptr ctx = dispatcher.post([&promise](CoroContext<int>::Ptr ctx)->int{
+        return ctx->set((int)promise.getICoroFuture()->waitFor(ctx, ms(100)));
+    });
+    EXPECT_EQ((int)std::future_status::ready, ctx->get());
+    EXPECT_THROW(promise.getIThreadFuture()->get(), std::runtime_error);
+}
+
 TEST_P(PromiseTest, WaitForAllFutures)
 {
     Dispatcher& dispatcher = getDispatcher();
@@ -1335,35 +2088,431 @@ TEST_P(ForEachTest, LargeBatchFromCoroutine)
     })->get();
 }
 
-TEST_P(MapReduce, OccuranceCount)
+TEST_P(ForEachTest, ParallelFor)
 {
-    //count the number of times a word of a specific length occurs
-    std::vector<std::vector<std::string>> input = {
-        {"a", "b", "aa", "aaa", "cccc" },
-        {"bb", "bbb", "bbbb", "a", "bb"},
-        {"aaa", "bb", "eee", "cccc", "d", "ddddd"},
-        {"eee", "d", "a" }
-    };
-    
-    std::map<std::string, size_t> result = getDispatcher().mapReduce(input.begin(), input.size(),
-        //mapper
-        [](VoidContextPtr, const std::vector<std::string>& input)->std::vector<std::pair<std::string, size_t>>
-        {
-            std::vector<std::pair<std::string, size_t>> out;
-            for (auto&& i : input) {
-                out.push_back({i, 1});
-            }
-            return out;
-        },
-        //reducer
-        [](VoidContextPtr, std::pair<std::string, std::vector<size_t>>&& input)->std::pair<std::string, size_t>
-        {
-            size_t sum = 0;
-            for (auto&& i : input.second) {
-                sum += i;
-            }
-            return {std::move(input.first), sum};
-        })->get();
+    std::vector<int> start(batchNum);
+    for (int i = 0; i < batchNum; ++i) {
+        start[i]=i;
+    }
+    
+    std::vector<int> results = getDispatcher().parallelFor(start.begin(), start.end(),
+        [](VoidContextPtr, int val)->int {
+        return val*2; //double the value
+    })->get();
+    
+    ASSERT_EQ(start.size(), results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i], start[i]*2);
+    }
+}
+
+TEST_P(ForEachTest, ParallelForUnevenCost)
+{
+    //The first elements are much more expensive than the rest so idle workers must steal them.
+    std::vector<int> start(200);
+    std::iota(start.begin(), start.end(), 0);
+    std::set<std::thread::id> threadIds;
+    std::mutex m;
+    
+    std::vector<int> results = getDispatcher().parallelFor(start.cbegin(), start.cend(),
+        [&](VoidContextPtr, const int& val)->int {
+        if (val < 50) {
+            std::this_thread::sleep_for(us(500));
+            std::lock_guard<std::mutex> lock(m);
+            threadIds.insert(std::this_thread::get_id());
+        }
+        return val+1;
+    }, 1)->get();
+    
+    ASSERT_EQ(start.size(), results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i], start[i]+1);
+    }
+    //the expensive elements were all assigned to the first worker
+    EXPECT_GT(threadIds.size(), 1UL);
+}
+
+TEST_P(ForEachTest, ParallelForFromCoroutine)
+{
+    getDispatcher().post([this](CoroContext<int>::Ptr ctx)->int {
+        std::vector<std::string> start{"a", "bb", "ccc", "dddd", "eeeee"};
+        std::vector<size_t> results = ctx->parallelFor(start.begin(), start.end(),
+            [](VoidContextPtr, const std::string& val)->size_t {
+            return val.size();
+        })->get(ctx);
+        EXPECT_EQ(std::vector<size_t>({1,2,3,4,5}), results);
+        
+        //empty range
+        EXPECT_TRUE(ctx->parallelFor(start.begin(), start.begin(),
+            [](VoidContextPtr, const std::string& val)->size_t {
+            return val.size();
+        })->get(ctx).empty());
+        return ctx->set(0);
+    })->get();
+}
+
+TEST_P(ForEachTest, ParallelForException)
+{
+    std::vector<int> start(batchNum);
+    std::iota(start.begin(), start.end(), 0);
+    auto ctx = getDispatcher().parallelFor(start.begin(), start.end(),
+        [](VoidContextPtr, int val)->int {
+        if (val == 500) {
+            throw std::runtime_error("bad element");
+        }
+        return val;
+    });
+    EXPECT_THROW(ctx->get(), std::runtime_error);
+}
+
+TEST_P(ForEachTest, ParallelFor2DCoverage)
+{
+    struct Shape { size_t rows, cols, tileRows, tileCols; };
+    std::vector<Shape> shapes{{1, 1, 0, 0},
+                              {7, 1000, 3, 64},
+                              {1000, 7, 64, 3},
+                              {513, 1031, 0, 0},
+                              {513, 1031, 17, 33},
+                              {2048, 2048, 128, 128}};
+    for (const Shape& shape : shapes) {
+        size_t tileRows = shape.tileRows ? shape.tileRows : TileGrid::DefaultTileSize;
+        size_t tileCols = shape.tileCols ? shape.tileCols : TileGrid::DefaultTileSize;
+        std::vector<std::atomic<int>> visits(shape.rows * shape.cols);
+        std::atomic<size_t> numTiles{0};
+        getDispatcher().parallelFor2D(shape.rows, shape.cols, shape.tileRows, shape.tileCols,
+            [&](VoidContextPtr, const Tile2D& tile) {
+            EXPECT_LT(tile.rowBegin, tile.rowEnd);
+            EXPECT_LT(tile.colBegin, tile.colEnd);
+            EXPECT_LE(tile.rowEnd, shape.rows);
+            EXPECT_LE(tile.colEnd, shape.cols);
+            EXPECT_EQ(0u, tile.rowBegin % tileRows);
+            EXPECT_EQ(0u, tile.colBegin % tileCols);
+            EXPECT_LE(tile.rowEnd - tile.rowBegin, tileRows);
+            EXPECT_LE(tile.colEnd - tile.colBegin, tileCols);
+            for (size_t row = tile.rowBegin; row < tile.rowEnd; ++row) {
+                for (size_t col = tile.colBegin; col < tile.colEnd; ++col) {
+                    ++visits[row * shape.cols + col];
+                }
+            }
+            ++numTiles;
+        })->get();
+        EXPECT_EQ(((shape.rows + tileRows - 1) / tileRows) * ((shape.cols + tileCols - 1) / tileCols), numTiles);
+        EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v){ return v == 1; }));
+    }
+    
+    //empty ranges
+    EXPECT_EQ(0, getDispatcher().parallelFor2D(0, 100, 8, 8, [](VoidContextPtr, const Tile2D&) {
+        ADD_FAILURE();
+    })->get());
+}
+
+TEST_P(ForEachTest, ParallelFor2DLocality)
+{
+    //Consecutive Z-order tiles are neighbours, so each contiguous share covers a compact block of the grid
+    TileGrid grid(64 * 8, 64 * 8, 64, 64);
+    ASSERT_EQ(64u, grid.size());
+    for (size_t quarter = 0; quarter < 4; ++quarter) {
+        size_t minRow = SIZE_MAX, maxRow = 0, minCol = SIZE_MAX, maxCol = 0;
+        for (size_t i = quarter * 16; i < (quarter + 1) * 16; ++i) {
+            Tile2D tile = grid.tile(i);
+            minRow = std::min(minRow, tile.rowBegin);
+            maxRow = std::max(maxRow, tile.rowEnd);
+            minCol = std::min(minCol, tile.colBegin);
+            maxCol = std::max(maxCol, tile.colEnd);
+        }
+        EXPECT_EQ(256u, maxRow - minRow);
+        EXPECT_EQ(256u, maxCol - minCol);
+    }
+}
+
+TEST_P(ForEachTest, ParallelFor2DTransposeFromCoroutine)
+{
+    const size_t rows = 1024, cols = 768;
+    std::vector<double> input(rows * cols);
+    std::iota(input.begin(), input.end(), 0.0);
+    std::vector<double> output(rows * cols, -1.0);
+    getDispatcher().post([&](VoidContextPtr ctx)->int {
+        return ctx->parallelFor2D(rows, cols, 32, 32, [&](VoidContextPtr, const Tile2D& tile) {
+            for (size_t row = tile.rowBegin; row < tile.rowEnd; ++row) {
+                for (size_t col = tile.colBegin; col < tile.colEnd; ++col) {
+                    output[col * rows + row] = input[row * cols + col];
+                }
+            }
+        })->get(ctx);
+    })->get();
+    std::vector<double> expected(rows * cols);
+    for (size_t row = 0; row < rows; ++row) {
+        for (size_t col = 0; col < cols; ++col) {
+            expected[col * rows + row] = input[row * cols + col];
+        }
+    }
+    EXPECT_EQ(expected, output);
+}
+
+TEST_P(ForEachTest, ParallelFor2DException)
+{
+    std::atomic<int> numTiles{0};
+    auto ctx = getDispatcher().parallelFor2D(1000, 1000, 10, 10, [&](VoidContextPtr, const Tile2D& tile) {
+        if (tile.rowBegin == 500 && tile.colBegin == 500) {
+            throw std::runtime_error("bad tile");
+        }
+        ++numTiles;
+    });
+    EXPECT_THROW(ctx->get(), std::runtime_error);
+    EXPECT_LT(numTiles, 10000);
+}
+
+TEST_P(ForEachTest, ForEachChunk)
+{
+    std::vector<int> start(batchNum);
+    std::iota(start.begin(), start.end(), 0);
+    using It = std::vector<int>::const_iterator;
+    
+    //one partial sum per chunk
+    std::vector<long> sums = getDispatcher().forEachChunk(start.cbegin(), start.cend(), 64,
+        [](VoidContextPtr, It begin, It end)->long {
+        return std::accumulate(begin, end, 0L);
+    })->get();
+    ASSERT_EQ((size_t)(batchNum + 63)/64, sums.size());
+    for (size_t i = 0; i < sums.size(); ++i) {
+        auto begin = start.begin() + i*64;
+        EXPECT_EQ(std::accumulate(begin, std::min(begin + 64, start.end()), 0L), sums[i]);
+    }
+    
+    //default chunking produces at most one chunk per coroutine thread
+    EXPECT_LE(getDispatcher().forEachChunk(start.cbegin(), start.cend(), 0,
+        [](VoidContextPtr, It begin, It end)->size_t {
+        return std::distance(begin, end);
+    })->get().size(), (size_t)getDispatcher().getNumCoroutineThreads());
+}
+
+TEST_P(ForEachTest, ForEachChunkVoidAndOutput)
+{
+    std::vector<double> start(batchNum);
+    std::iota(start.begin(), start.end(), 0.0);
+    using It = std::vector<double>::iterator;
+    
+    //void callback modifying the input in place
+    std::atomic_int numChunks{0};
+    EXPECT_EQ(0, getDispatcher().forEachChunk(start.begin(), start.end(), 100,
+        [&numChunks](VoidContextPtr, It begin, It end) {
+        ++numChunks;
+        for (; begin != end; ++begin) {
+            *begin *= 2;
+        }
+    })->get());
+    EXPECT_EQ((batchNum + 99)/100, numChunks);
+    
+    //in-place output range
+    std::vector<double> output(batchNum);
+    getDispatcher().post([&start, &output](VoidContextPtr ctx)->int {
+        return ctx->forEachChunk(start.begin(), start.end(), 33, output.begin(),
+            [](VoidContextPtr, It begin, It end, It out) {
+            std::transform(begin, end, out, [](double val) { return val + 1; });
+        })->get(ctx);
+    })->get();
+    for (int i = 0; i < batchNum; ++i) {
+        EXPECT_EQ(2.0*i + 1, output[i]);
+    }
+}
+
+TEST_P(ForEachTest, ForEachChunkEmptyAndException)
+{
+    std::vector<int> start(batchNum, 1);
+    using It = std::vector<int>::const_iterator;
+    
+    getDispatcher().post([&start](VoidContextPtr ctx)->int {
+        //empty range produces no chunks
+        EXPECT_TRUE(ctx->forEachChunk(start.cbegin(), start.cbegin(), 10,
+            [](VoidContextPtr, It, It)->int { return 1; })->get(ctx).empty());
+        return 0;
+    })->get();
+    
+    auto result = getDispatcher().forEachChunk(start.cbegin(), start.cend(), 10,
+        [](VoidContextPtr, It begin, It)->int {
+        if (*begin == 1) {
+            throw std::runtime_error("chunk error");
+        }
+        return 0;
+    });
+    EXPECT_THROW(result->get(), std::runtime_error);
+}
+
+TEST_P(ForEachTest, ForEachAsyncIo)
+{
+    std::vector<int> start(batchNum);
+    std::iota(start.begin(), start.end(), 0);
+    
+    //every element is processed on an IO thread and results are in range order
+    std::atomic_int numInCoroutine{0};
+    std::vector<long> results = getDispatcher().forEachAsyncIo(start.cbegin(), start.cend(),
+        [&numInCoroutine](const int& val)->long {
+        if (local::context()) {
+            ++numInCoroutine;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(10)); //blocking call
+        return 3L*val;
+    }, 7)->get();
+    EXPECT_EQ(0, numInCoroutine);
+    ASSERT_EQ((size_t)batchNum, results.size());
+    for (int i = 0; i < batchNum; ++i) {
+        EXPECT_EQ(3L*i, results[i]);
+    }
+}
+
+TEST_P(ForEachTest, ForEachAsyncIoVoidAndException)
+{
+    std::vector<int> start(batchNum, 1);
+    
+    getDispatcher().post([&start](VoidContextPtr ctx)->int {
+        //void callback with the default chunk size
+        std::atomic_int sum{0};
+        EXPECT_EQ(0, ctx->forEachAsyncIo(start.begin(), start.end(), [&sum](int& val) {
+            sum += val;
+            val = 2;
+        })->get(ctx));
+        EXPECT_EQ(batchNum, sum);
+        EXPECT_EQ(std::vector<int>(batchNum, 2), start);
+        
+        //empty range
+        EXPECT_TRUE(ctx->forEachAsyncIo(start.begin(), start.begin(), [](int)->int { return 0; })->get(ctx).empty());
+        return 0;
+    })->get();
+    
+    auto result = getDispatcher().forEachAsyncIo(start.begin(), start.end(), [](int val)->int {
+        if (val == 2) {
+            throw std::runtime_error("io error");
+        }
+        return 0;
+    }, 10);
+    EXPECT_THROW(result->get(), std::runtime_error);
+}
+
+TEST_P(ForEachTest, Reduce)
+{
+    std::vector<long> start(batchNum);
+    std::iota(start.begin(), start.end(), 0L);
+    long sum = getDispatcher().reduce(start.begin(), start.end(), 10L,
+        [](const long& lhs, const long& rhs)->long {
+        return lhs + rhs;
+    }, 7)->get();
+    EXPECT_EQ(std::accumulate(start.begin(), start.end(), 10L), sum);
+    
+    //non-commutative operation must preserve the element order
+    std::vector<std::string> letters;
+    for (char c = 'a'; c <= 'z'; ++c) {
+        letters.emplace_back(1, c);
+    }
+    std::string word = getDispatcher().reduce(letters.begin(), letters.end(), std::string(">"),
+        [](const std::string& lhs, const std::string& rhs)->std::string {
+        return lhs + rhs;
+    }, 1)->get();
+    EXPECT_EQ(">abcdefghijklmnopqrstuvwxyz", word);
+}
+
+TEST_P(ForEachTest, TransformReduce)
+{
+    std::vector<std::string> start(batchNum);
+    size_t expected = 0;
+    for (int i = 0; i < batchNum; ++i) {
+        start[i] = std::to_string(i);
+        expected += start[i].size();
+    }
+    size_t totalSize = getDispatcher().transformReduce(start.begin(), start.end(), size_t{0},
+        [](const size_t& lhs, const size_t& rhs)->size_t {
+        return lhs + rhs;
+    },
+        [](const std::string& val)->size_t {
+        return val.size();
+    })->get();
+    EXPECT_EQ(expected, totalSize);
+}
+
+TEST_P(ForEachTest, Scan)
+{
+    std::vector<int> start(batchNum);
+    std::iota(start.begin(), start.end(), 1);
+    auto plus = [](const int& lhs, const int& rhs)->int { return lhs + rhs; };
+    
+    std::vector<int> expected(batchNum);
+    std::partial_sum(start.begin(), start.end(), expected.begin());
+    EXPECT_EQ(expected, getDispatcher().inclusiveScan(start.begin(), start.end(), plus)->get());
+    
+    expected.insert(expected.begin(), 0);
+    expected.pop_back();
+    for (auto&& val : expected) {
+        val += 5;
+    }
+    EXPECT_EQ(expected, getDispatcher().exclusiveScan(start.begin(), start.end(), 5, plus)->get());
+}
+
+TEST_P(ForEachTest, ReduceAndScanFromCoroutine)
+{
+    getDispatcher().post([](VoidContextPtr ctx)->int {
+        std::vector<std::string> start{"a", "bb", "ccc", "dddd", "eeeee"};
+        auto concat = [](const std::string& lhs, const std::string& rhs)->std::string { return lhs + rhs; };
+        EXPECT_EQ("abbcccddddeeeee", ctx->reduce(start.begin(), start.end(), std::string(), concat)->get(ctx));
+        EXPECT_EQ(15UL, ctx->transformReduce(start.begin(), start.end(), size_t{0},
+            [](const size_t& lhs, const size_t& rhs)->size_t { return lhs + rhs; },
+            [](const std::string& val)->size_t { return val.size(); })->get(ctx));
+        EXPECT_EQ(std::vector<std::string>({"a", "abb", "abbccc", "abbcccdddd", "abbcccddddeeeee"}),
+                  ctx->inclusiveScan(start.begin(), start.end(), concat)->get(ctx));
+        EXPECT_EQ(std::vector<std::string>({"", "a", "abb", "abbccc", "abbcccdddd"}),
+                  ctx->exclusiveScan(start.begin(), start.end(), std::string(), concat)->get(ctx));
+        
+        //empty range
+        EXPECT_EQ("x", ctx->reduce(start.begin(), start.begin(), std::string("x"), concat)->get(ctx));
+        EXPECT_TRUE(ctx->inclusiveScan(start.begin(), start.begin(), concat)->get(ctx).empty());
+        return 0;
+    })->get();
+}
+
+TEST_P(ForEachTest, ReduceException)
+{
+    std::vector<int> start(batchNum);
+    std::iota(start.begin(), start.end(), 0);
+    auto ctx = getDispatcher().transformReduce(start.begin(), start.end(), 0,
+        [](const int& lhs, const int& rhs)->int {
+        return lhs + rhs;
+    },
+        [](const int& val)->int {
+        if (val == 3) {
+            throw std::runtime_error("bad element");
+        }
+        return val;
+    }, 2);
+    EXPECT_THROW(ctx->get(), std::runtime_error);
+}
+
+TEST_P(MapReduce, OccuranceCount)
+{
+    //count the number of times a word of a specific length occurs
+    std::vector<std::vector<std::string>> input = {
+        {"a", "b", "aa", "aaa", "cccc" },
+        {"bb", "bbb", "bbbb", "a", "bb"},
+        {"aaa", "bb", "eee", "cccc", "d", "ddddd"},
+        {"eee", "d", "a" }
+    };
+    
+    std::map<std::string, size_t> result = getDispatcher().mapReduce(input.begin(), input.size(),
+        //mapper
+        [](VoidContextPtr, const std::vector<std::string>& input)->std::vector<std::pair<std::string, size_t>>
+        {
+            std::vector<std::pair<std::string, size_t>> out;
+            for (auto&& i : input) {
+                out.push_back({i, 1});
+            }
+            return out;
+        },
+        //reducer
+        [](VoidContextPtr, std::pair<std::string, std::vector<size_t>>&& input)->std::pair<std::string, size_t>
+        {
+            size_t sum = 0;
+            for (auto&& i : input.second) {
+                sum += i;
+            }
+            return {std::move(input.first), sum};
+        })->get();
     
     ASSERT_EQ(result.size(), 11UL);
     EXPECT_EQ(result["a"], 3UL);
@@ -1453,6 +2602,365 @@ TEST_P(MapReduce, WordLengthFromCoroutine)
     })->get();
 }
 
+TEST_P(MapReduce, UnorderedOutputWithCombiner)
+{
+    //count word occurrences over a large input where most words repeat
+    std::vector<std::vector<std::string>> input(200);
+    std::map<std::string, size_t> expected;
+    for (size_t i = 0; i < input.size(); ++i) {
+        for (size_t j = 0; j < 50; ++j) {
+            std::string word(1 + (i*j)%7, 'a' + (char)((i+j)%5));
+            input[i].push_back(word);
+            ++expected[word];
+        }
+    }
+    std::atomic_int numCombines{0};
+    
+    std::unordered_map<std::string, size_t> result = getDispatcher().mapReduce(input.begin(), input.end(),
+        //mapper
+        [](VoidContextPtr, const std::vector<std::string>& input)->std::vector<std::pair<std::string, size_t>>
+        {
+            std::vector<std::pair<std::string, size_t>> out;
+            for (auto&& i : input) {
+                out.push_back({i, 1});
+            }
+            return out;
+        },
+        //reducer
+        [](VoidContextPtr, std::pair<std::string, std::vector<size_t>>&& input)->std::pair<std::string, size_t>
+        {
+            return {std::move(input.first), std::accumulate(input.second.begin(), input.second.end(), size_t{0})};
+        },
+        //combiner
+        [&numCombines](const std::string&, size_t&& lhs, size_t&& rhs)->size_t
+        {
+            ++numCombines;
+            return lhs + rhs;
+        },
+        MapReduceOutput::Unordered{})->get();
+    
+    EXPECT_GT(numCombines, 0);
+    ASSERT_EQ(result.size(), expected.size());
+    for (auto&& entry : expected) {
+        EXPECT_EQ(result[entry.first], entry.second);
+    }
+}
+
+TEST_P(MapReduce, SortedOutputFromCoroutine)
+{
+    std::vector<int> input(1000);
+    std::iota(input.begin(), input.end(), 0);
+    
+    getDispatcher().post([&input](VoidContextPtr ctx)->int
+    {
+        //group numbers by their remainder and sum each group
+        std::vector<std::pair<int, long>> result = ctx->mapReduceBatch(input.begin(), input.end(),
+        //mapper
+        [](VoidContextPtr, int val)->std::vector<std::pair<int, long>>
+        {
+            return {{val%37, (long)val}};
+        },
+        //reducer
+        [](VoidContextPtr, std::pair<int, std::vector<long>>&& input)->std::pair<int, long>
+        {
+            return {input.first, std::accumulate(input.second.begin(), input.second.end(), 0L)};
+        },
+        nullptr,
+        MapReduceOutput::Sorted{})->get(ctx);
+        
+        EXPECT_EQ(result.size(), 37UL);
+        for (size_t i = 0; i < result.size(); ++i) {
+            EXPECT_EQ(result[i].first, (int)i);
+            long sum = 0;
+            for (int val = (int)i; val < 1000; val += 37) {
+                sum += val;
+            }
+            EXPECT_EQ(result[i].second, sum);
+        }
+        return 0;
+    })->get();
+}
+
+TEST_P(MapReduce, NonHashableKey)
+{
+    //keys without a std::hash specialization are shuffled into a single partition
+    struct Key {
+        int _value;
+        bool operator<(const Key& other) const { return _value < other._value; }
+    };
+    static_assert(!MapReduceOutput::IsHashable<Key>::value, "Key should not be hashable");
+    std::vector<int> input(100);
+    std::iota(input.begin(), input.end(), 0);
+    
+    std::map<Key, int> result = getDispatcher().mapReduce(input.begin(), input.size(),
+        //mapper
+        [](VoidContextPtr, int val)->std::vector<std::pair<Key, int>>
+        {
+            return {{Key{val%10}, 1}};
+        },
+        //reducer
+        [](VoidContextPtr, std::pair<Key, std::vector<int>>&& input)->std::pair<Key, int>
+        {
+            return {input.first, (int)input.second.size()};
+        })->get();
+    
+    ASSERT_EQ(result.size(), 10UL);
+    int expectedKey = 0;
+    for (auto&& entry : result) {
+        EXPECT_EQ(entry.first._value, expectedKey++);
+        EXPECT_EQ(entry.second, 10);
+    }
+}
+
+TEST_P(MapReduce, AsyncIoWithCombiner)
+{
+    //count word occurrences where mapping and reducing make blocking calls
+    std::vector<std::vector<std::string>> input(200);
+    std::map<std::string, size_t> expected;
+    for (size_t i = 0; i < input.size(); ++i) {
+        for (size_t j = 0; j < 20; ++j) {
+            std::string word(1 + (i*j)%7, 'a' + (char)((i+j)%5));
+            input[i].push_back(word);
+            ++expected[word];
+        }
+    }
+    std::atomic_int numInCoroutine{0};
+    
+    std::unordered_map<std::string, size_t> result = getDispatcher().mapReduceAsyncIo(input.begin(), input.end(),
+        //mapper
+        [&numInCoroutine](const std::vector<std::string>& input)->std::vector<std::pair<std::string, size_t>>
+        {
+            if (local::context()) {
+                ++numInCoroutine;
+            }
+            std::vector<std::pair<std::string, size_t>> out;
+            for (auto&& i : input) {
+                out.push_back({i, 1});
+            }
+            return out;
+        },
+        //reducer
+        [&numInCoroutine](std::pair<std::string, std::vector<size_t>>&& input)->std::pair<std::string, size_t>
+        {
+            if (local::context()) {
+                ++numInCoroutine;
+            }
+            return {std::move(input.first), std::accumulate(input.second.begin(), input.second.end(), size_t{0})};
+        },
+        //combiner
+        [](const std::string&, size_t&& lhs, size_t&& rhs)->size_t
+        {
+            return lhs + rhs;
+        },
+        MapReduceOutput::Unordered{}, 16)->get();
+    
+    EXPECT_EQ(0, numInCoroutine);
+    ASSERT_EQ(result.size(), expected.size());
+    for (auto&& entry : expected) {
+        EXPECT_EQ(result[entry.first], entry.second);
+    }
+}
+
+TEST_P(MapReduce, AsyncIoFromCoroutine)
+{
+    std::vector<int> input(1000);
+    std::iota(input.begin(), input.end(), 0);
+    
+    getDispatcher().post([&input](VoidContextPtr ctx)->int
+    {
+        //group numbers by their remainder and sum each group
+        std::map<int, long> result = ctx->mapReduceAsyncIo(input.begin(), input.end(),
+        //mapper
+        [](int val)->std::vector<std::pair<int, long>>
+        {
+            return {{val%37, (long)val}};
+        },
+        //reducer
+        [](std::pair<int, std::vector<long>>&& input)->std::pair<int, long>
+        {
+            return {input.first, std::accumulate(input.second.begin(), input.second.end(), 0L)};
+        })->get(ctx);
+        
+        EXPECT_EQ(result.size(), 37UL);
+        for (auto&& entry : result) {
+            long sum = 0;
+            for (int val = entry.first; val < 1000; val += 37) {
+                sum += val;
+            }
+            EXPECT_EQ(entry.second, sum);
+        }
+        return 0;
+    })->get();
+    
+    auto result = getDispatcher().mapReduceAsyncIo(input.begin(), input.end(),
+        [](int val)->std::vector<std::pair<int, int>>
+        {
+            return {{val%3, 1}};
+        },
+        [](std::pair<int, std::vector<int>>&& input)->std::pair<int, int>
+        {
+            if (input.first == 1) {
+                throw std::runtime_error("reducer error");
+            }
+            return {input.first, 0};
+        });
+    EXPECT_THROW(result->get(), std::runtime_error);
+}
+
+TEST_P(MapReduce, StreamFromBuffer)
+{
+    //count word occurrences while the words are being produced
+    std::map<std::string, size_t> expected;
+    for (size_t i = 0; i < 5000; ++i) {
+        ++expected[std::string(1 + i%7, 'a' + (char)(i%5))];
+    }
+    auto produce = [](CoroContext<Buffer<std::string>>::Ptr ctx)->int {
+        for (size_t i = 0; i < 5000; ++i) {
+            ctx->push(std::string(1 + i%7, 'a' + (char)(i%5)));
+            if (i%100 == 0) {
+                ctx->yield();
+            }
+        }
+        return ctx->closeBuffer();
+    };
+    auto mapper = [](VoidContextPtr, const std::string& word)->std::vector<std::pair<std::string, size_t>> {
+        return {{word, 1}};
+    };
+    auto combiner = [](const std::string&, size_t&& lhs, size_t&& rhs)->size_t {
+        return lhs + rhs;
+    };
+    
+    std::map<std::string, size_t> result = getDispatcher().mapReduceStream(getDispatcher().post(produce),
+                                                                           mapper, combiner)->get();
+    EXPECT_EQ(expected, result);
+    
+    std::unordered_map<std::string, size_t> unordered = getDispatcher().mapReduceStream(
+        getDispatcher().post(produce), mapper, combiner, MapReduceOutput::Unordered{}, 7)->get();
+    ASSERT_EQ(expected.size(), unordered.size());
+    for (auto&& entry : expected) {
+        EXPECT_EQ(entry.second, unordered[entry.first]);
+    }
+}
+
+TEST_P(MapReduce, StreamFromPromiseFromCoroutine)
+{
+    //the promise is used as a channel fed by an external thread
+    Promise<Buffer<int>> promise;
+    ThreadContext<std::vector<std::pair<int, long>>>::Ptr ctx = getDispatcher().post(
+        [&promise](CoroContext<std::vector<std::pair<int, long>>>::Ptr ctx)->int {
+        return ctx->set(ctx->mapReduceStream(promise.getICoroFuture(),
+            [](VoidContextPtr, const int& val)->std::vector<std::pair<int, long>> {
+                return {{val%10, (long)val}};
+            },
+            [](const int&, long&& lhs, long&& rhs)->long {
+                return lhs + rhs;
+            },
+            MapReduceOutput::Sorted{})->get(ctx));
+    });
+    for (int i = 0; i < 1000; ++i) {
+        promise.push(i);
+    }
+    promise.closeBuffer();
+    
+    std::vector<std::pair<int, long>> result = ctx->get();
+    ASSERT_EQ(10UL, result.size());
+    for (int key = 0; key < 10; ++key) {
+        long sum = 0;
+        for (int val = key; val < 1000; val += 10) {
+            sum += val;
+        }
+        EXPECT_EQ(key, result[key].first);
+        EXPECT_EQ(sum, result[key].second);
+    }
+}
+
+TEST_P(MapReduce, StreamException)
+{
+    auto produce = [](CoroContext<Buffer<int>>::Ptr ctx)->int {
+        for (int i = 0; i < 1000; ++i) {
+            ctx->push(i);
+        }
+        return ctx->closeBuffer();
+    };
+    auto result = getDispatcher().mapReduceStream(getDispatcher().post(produce),
+        [](VoidContextPtr, const int& val)->std::vector<std::pair<int, int>> {
+            if (val == 500) {
+                throw std::runtime_error("mapper error");
+            }
+            return {{val%3, 1}};
+        },
+        [](const int&, int&& lhs, int&& rhs)->int {
+            return lhs + rhs;
+        });
+    EXPECT_THROW(result->get(), std::runtime_error);
+}
+
+TEST_P(SortTest, Sort)
+{
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int> dist(0, 1000000);
+    for (size_t size : {0, 1, 100, 4097, 100000}) {
+        std::vector<int> values(size);
+        std::generate(values.begin(), values.end(), [&]{ return dist(gen); });
+        std::vector<int> expected = values;
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(0, getDispatcher().sort(values.begin(), values.end())->get());
+        EXPECT_EQ(expected, values);
+    }
+}
+
+TEST_P(SortTest, SortCustomComparator)
+{
+    std::vector<std::string> values(20000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::to_string((i*7919)%values.size());
+    }
+    std::vector<std::string> expected = values;
+    auto longestFirst = [](const std::string& lhs, const std::string& rhs) {
+        return (lhs.size() == rhs.size()) ? lhs < rhs : lhs.size() > rhs.size();
+    };
+    std::sort(expected.begin(), expected.end(), longestFirst);
+    getDispatcher().sort(values.begin(), values.end(), longestFirst)->get();
+    EXPECT_EQ(expected, values);
+}
+
+TEST_P(SortTest, StableSort)
+{
+    //sort on the key only and check that values with the same key keep their original order
+    std::vector<std::pair<int, int>> values(50000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = {(int)((i*31)%97), (int)i};
+    }
+    std::vector<std::pair<int, int>> expected = values;
+    auto byKey = [](const std::pair<int, int>& lhs, const std::pair<int, int>& rhs) {
+        return lhs.first < rhs.first;
+    };
+    std::stable_sort(expected.begin(), expected.end(), byKey);
+    getDispatcher().stableSort(values.begin(), values.end(), byKey)->get();
+    EXPECT_EQ(expected, values);
+}
+
+TEST_P(SortTest, SortFromCoroutine)
+{
+    std::vector<double> values(30000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = (double)((i*104729)%values.size())/3;
+    }
+    std::vector<double> expected = values;
+    std::sort(expected.begin(), expected.end(), std::greater<double>());
+    
+    getDispatcher().post([&values](VoidContextPtr ctx)->int {
+        return ctx->sort(values.begin(), values.end(), std::greater<double>())->get(ctx);
+    })->get();
+    EXPECT_EQ(expected, values);
+    
+    getDispatcher().post([&values](VoidContextPtr ctx)->int {
+        return ctx->stableSort(values.begin(), values.end())->get(ctx);
+    })->get();
+    std::reverse(expected.begin(), expected.end());
+    EXPECT_EQ(expected, values);
+}
+
 TEST_P(FutureJoinerTest, JoinThreadFutures)
 {
     std::vector<ThreadContext<int>::Ptr> futures;
@@ -1602,6 +3110,228 @@ TEST_P(CoroLocalStorageTest, GetContext)
     })->get();
 }
 
+TEST_P(CoroLocalStorageTest, SlotAccess)
+{
+    static const local::Slot named = local::registerSlot("slotAccessNamed");
+    EXPECT_EQ(named, local::registerSlot("slotAccessNamed"));
+    // enough slots to spill over the inline storage
+    static const std::vector<local::Slot> slots = []()
+    {
+        std::vector<local::Slot> v;
+        for (int i = 0; i < 2 * __QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS; ++i)
+        {
+            v.push_back(local::registerSlot());
+        }
+        return v;
+    }();
+    EXPECT_EQ(slots.size(), std::set<local::Slot>(slots.begin(), slots.end()).size());
+    
+    // outside of coroutines the thread storage is used
+    int outside = 0;
+    local::set(slots.back(), &outside);
+    EXPECT_EQ(&outside, local::get<int>(slots.back()));
+    
+    for (int n = 0; n < 10; ++n)
+    {
+        getDispatcher().post([n](CoroContext<int>::Ptr ctx)->int
+        {
+            // the name and the slot refer to the same variable
+            EXPECT_EQ(nullptr, local::get<int>(named));
+            int v = n;
+            local::variable<int>("slotAccessNamed") = &v;
+            EXPECT_EQ(&v, local::get<int>(named));
+            
+            // references remain valid when the overflow grows
+            int*& first = local::variable<int>(slots[__QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS]);
+            std::vector<int> values(slots.size());
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                EXPECT_EQ(nullptr, local::get<int>(slots[i]));
+                values[i] = n * 100 + (int)i;
+                local::set(slots[i], &values[i]);
+            }
+            EXPECT_EQ(&values[__QUANTUM_CORO_LOCAL_STORAGE_INLINE_SLOTS], first);
+            ctx->yield();
+            {
+                local::VariableGuard<int> guard(slots.front(), &v);
+                EXPECT_EQ(&v, local::get<int>(slots.front()));
+                ctx->yield();
+            }
+            for (size_t i = 0; i < slots.size(); ++i)
+            {
+                EXPECT_EQ(&values[i], local::get<int>(slots[i]));
+            }
+            return ctx->set(0);
+        });
+    }
+    getDispatcher().drain();
+    EXPECT_EQ(&outside, local::get<int>(slots.back()));
+    local::set<int>(slots.back(), nullptr);
+}
+
+TEST_P(CoroLocalStorageTest, UnregisteredNames)
+{
+    const local::Slot before = local::registerSlot();
+    for (int n = 0; n < 10; ++n)
+    {
+        getDispatcher().post([n](CoroContext<int>::Ptr ctx)->int
+        {
+            std::vector<int> values(100);
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                std::string name = "unregistered_" + std::to_string(n) + "_" + std::to_string(i);
+                EXPECT_EQ(nullptr, local::variable<int>(name));
+                local::variable<int>(name) = &values[i];
+            }
+            ctx->yield();
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                std::string name = "unregistered_" + std::to_string(n) + "_" + std::to_string(i);
+                EXPECT_EQ(&values[i], local::variable<int>(name));
+            }
+            return ctx->set(0);
+        });
+    }
+    getDispatcher().drain();
+    // accessing variables by name does not register any slots
+    EXPECT_EQ(before + 1, local::registerSlot());
+}
+
+TEST_P(GeneratorTest, LazyIteration)
+{
+    int numProduced = 0;
+    Generator<int> squares([&numProduced](Generator<int>::Yield& yield, int max)
+    {
+        for (int i = 1; i <= max; ++i)
+        {
+            ++numProduced;
+            yield(i * i);
+        }
+    }, 10);
+    EXPECT_EQ(0, numProduced); //nothing runs until the first value is requested
+    EXPECT_FALSE(squares.done());
+    ASSERT_TRUE(squares.next());
+    EXPECT_EQ(1, squares.value());
+    EXPECT_EQ(1, numProduced);
+    
+    std::vector<int> values;
+    for (int& value : squares)
+    {
+        values.push_back(value);
+    }
+    EXPECT_EQ((std::vector<int>{4, 9, 16, 25, 36, 49, 64, 81, 100}), values);
+    EXPECT_TRUE(squares.done());
+    EXPECT_FALSE(squares.next());
+}
+
+TEST_P(GeneratorTest, ValuesHandedOffInPlace)
+{
+    //lvalues are read and moved from on the producer's stack
+    std::vector<const std::unique_ptr<int>*> addresses;
+    Generator<std::unique_ptr<int>> pointers([&addresses](Generator<std::unique_ptr<int>>::Yield& yield)
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            std::unique_ptr<int> value(new int(i));
+            addresses.push_back(&value);
+            yield(value);
+            EXPECT_FALSE(value); //moved by the consumer
+        }
+    });
+    int i = 0;
+    for (auto& value : pointers)
+    {
+        EXPECT_EQ(addresses.back(), &value);
+        std::unique_ptr<int> taken = std::move(value);
+        EXPECT_EQ(i++, *taken);
+    }
+    EXPECT_EQ(3, i);
+    
+    //read-only values are copied
+    const std::string text("text");
+    Generator<std::string> strings([&text](Generator<std::string>::Yield& yield)
+    {
+        yield(text);
+        yield(std::string("temporary"));
+    });
+    ASSERT_TRUE(strings.next());
+    EXPECT_NE(&text, &strings.value());
+    EXPECT_EQ(text, strings.value());
+    ASSERT_TRUE(strings.next());
+    EXPECT_EQ("temporary", strings.value());
+    EXPECT_FALSE(strings.next());
+}
+
+TEST_P(GeneratorTest, ExceptionAndEarlyDestruction)
+{
+    Generator<int> throwing([](Generator<int>::Yield& yield)
+    {
+        yield(1);
+        throw std::runtime_error("generator error");
+    });
+    EXPECT_TRUE(throwing.next());
+    EXPECT_THROW(throwing.next(), std::runtime_error);
+    EXPECT_TRUE(throwing.done());
+    EXPECT_FALSE(throwing.next());
+    
+    //destroying a suspended generator unwinds the producer
+    struct Unwinder
+    {
+        ~Unwinder() { ++numUnwound; }
+        int& numUnwound;
+    };
+    int numUnwound = 0;
+    {
+        Generator<int> naturals([&numUnwound](Generator<int>::Yield& yield)
+        {
+            Unwinder unwinder{numUnwound};
+            for (int i = 0; ; ++i) yield(i);
+        });
+        auto it = naturals.begin();
+        ++it; ++it;
+        EXPECT_EQ(2, *it);
+        EXPECT_EQ(0, numUnwound);
+    }
+    EXPECT_EQ(1, numUnwound);
+    
+    //a generator which was never started does not run its producer at all
+    bool hasRun = false;
+    {
+        Generator<int> unused([&hasRun](Generator<int>::Yield&){ hasRun = true; });
+    }
+    EXPECT_FALSE(hasRun);
+}
+
+TEST_P(GeneratorTest, ConsumeFromCoroutine)
+{
+    std::vector<ThreadContextPtr<long>> contexts;
+    for (int c = 0; c < 10; ++c)
+    {
+        contexts.push_back(getDispatcher().post([c](CoroContext<long>::Ptr ctx)->int
+        {
+            Generator<long> range([](Generator<long>::Yield& yield, long from, long to)
+            {
+                for (long i = from; i < to; ++i) yield(i);
+            }, c * 1000L, (c + 1) * 1000L);
+            long sum = 0;
+            for (long value : range)
+            {
+                sum += value;
+                if (value % 100 == 0)
+                {
+                    ctx->yield(); //the consumer may yield between values
+                }
+            }
+            return ctx->set(sum);
+        }));
+    }
+    for (int c = 0; c < 10; ++c)
+    {
+        long from = c * 1000L, to = (c + 1) * 1000L;
+        EXPECT_EQ((from + to - 1) * (to - from) / 2, contexts[c]->get());
+    }
+}
+
 //This test **must** come last to make Valgrind happy.
 TEST_P(CleanupTest, DeleteDispatcherInstance)
 {
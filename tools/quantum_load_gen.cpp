@@ -0,0 +1,604 @@
+/*
+** Copyright 2018 Bloomberg Finance L.P.
+**
+** Licensed under the Apache License, Version 2.0 (the "License");
+** you may not use this file except in compliance with the License.
+** You may obtain a copy of the License at
+**
+**     http://www.apache.org/licenses/LICENSE-2.0
+**
+** Unless required by applicable law or agreed to in writing, software
+** distributed under the License is distributed on an "AS IS" BASIS,
+** WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+** See the License for the specific language governing permissions and
+** limitations under the License.
+*/
+//==============================================================================
+// quantumLoadGen
+//
+// Drives a Dispatcher and a Sequencer with a configurable mix of coroutines,
+// IO tasks and sequenced tasks at a target rate, then reports the achieved
+// throughput, completion latency percentiles, CPU utilisation and object pool
+// fallbacks to the heap.
+//
+// Usage: quantumLoadGen [scenario file] [key=value ...]
+//==============================================================================
+#include <quantum/quantum.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Bloomberg::quantum;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+//==============================================================================
+//                                 Scenario
+//==============================================================================
+struct Scenario
+{
+    //Dispatcher configuration
+    int         coroutineThreads{4};
+    int         ioThreads{4};
+    bool        coroutineSharingForAny{false};
+    bool        loadBalanceSharedIoQueues{false};
+    //Load
+    int         durationMs{5000};
+    double      rate{10000};
+    int         maxInFlight{100000};
+    unsigned    seed{1};
+    //Mix
+    int         coroutinePercent{70};
+    int         ioPercent{20};
+    int         sequencedPercent{10};
+    //Coroutine tasks
+    int         coroutineWorkUs{5};
+    int         coroutineYields{1};
+    int         fanOutPercent{0};
+    int         fanOutWidth{8};
+    //IO tasks
+    int         ioWorkUs{50};
+    //Sequenced tasks
+    int         sequencedWorkUs{5};
+    int         sequenceKeys{1000};
+    double      zipfExponent{1.0};
+};
+
+struct Field
+{
+    const char*                                             _name;
+    const char*                                             _description;
+    std::function<void(Scenario&, const std::string&)>      _set;
+    std::function<void(const Scenario&, std::ostream&)>     _print;
+};
+
+template <class T>
+void parseValue(const std::string& text, T& value)
+{
+    std::istringstream in(text);
+    if (!(in >> value) || !(in >> std::ws).eof())
+    {
+        throw std::invalid_argument("Invalid value '" + text + "'");
+    }
+}
+
+void parseValue(const std::string& text, bool& value)
+{
+    if ((text == "true") || (text == "1"))
+    {
+        value = true;
+    }
+    else if ((text == "false") || (text == "0"))
+    {
+        value = false;
+    }
+    else
+    {
+        throw std::invalid_argument("Invalid boolean '" + text + "'");
+    }
+}
+
+template <class T>
+Field makeField(const char* name, const char* description, T Scenario::* member)
+{
+    return {name,
+            description,
+            [member](Scenario& scenario, const std::string& text) { parseValue(text, scenario.*member); },
+            [member](const Scenario& scenario, std::ostream& out) { out << std::boolalpha << scenario.*member; }};
+}
+
+const std::vector<Field>& fields()
+{
+    static const std::vector<Field> fields{
+        makeField("coroutineThreads", "Number of coroutine threads", &Scenario::coroutineThreads),
+        makeField("ioThreads", "Number of IO threads", &Scenario::ioThreads),
+        makeField("coroutineSharingForAny", "Configuration::setCoroutineSharingForAny()",
+                  &Scenario::coroutineSharingForAny),
+        makeField("loadBalanceSharedIoQueues", "Configuration::setLoadBalanceSharedIoQueues()",
+                  &Scenario::loadBalanceSharedIoQueues),
+        makeField("durationMs", "Time during which tasks are generated", &Scenario::durationMs),
+        makeField("rate", "Target number of top-level tasks per second. 0 posts as fast as possible",
+                  &Scenario::rate),
+        makeField("maxInFlight", "Generation pauses while this many top-level tasks are pending",
+                  &Scenario::maxInFlight),
+        makeField("seed", "Random seed", &Scenario::seed),
+        makeField("coroutinePercent", "Share of coroutine tasks", &Scenario::coroutinePercent),
+        makeField("ioPercent", "Share of IO tasks", &Scenario::ioPercent),
+        makeField("sequencedPercent", "Share of sequenced tasks", &Scenario::sequencedPercent),
+        makeField("coroutineWorkUs", "CPU time burnt by a coroutine before and after each yield",
+                  &Scenario::coroutineWorkUs),
+        makeField("coroutineYields", "Number of yields per coroutine", &Scenario::coroutineYields),
+        makeField("fanOutPercent", "Share of coroutines which post children and wait for them",
+                  &Scenario::fanOutPercent),
+        makeField("fanOutWidth", "Number of children per fan-out", &Scenario::fanOutWidth),
+        makeField("ioWorkUs", "Time an IO task blocks its thread", &Scenario::ioWorkUs),
+        makeField("sequencedWorkUs", "CPU time burnt by a sequenced task", &Scenario::sequencedWorkUs),
+        makeField("sequenceKeys", "Number of distinct sequence keys", &Scenario::sequenceKeys),
+        makeField("zipfExponent", "Skew of the sequence key distribution. 0 is uniform",
+                  &Scenario::zipfExponent)
+    };
+    return fields;
+}
+
+void set(Scenario& scenario, const std::string& key, const std::string& value)
+{
+    for (const Field& field : fields())
+    {
+        if (key == field._name)
+        {
+            field._set(scenario, value);
+            return;
+        }
+    }
+    throw std::invalid_argument("Unknown scenario key '" + key + "'");
+}
+
+std::string trim(const std::string& text)
+{
+    const char* blanks = " \t\r\n";
+    size_t begin = text.find_first_not_of(blanks);
+    if (begin == std::string::npos)
+    {
+        return std::string();
+    }
+    return text.substr(begin, text.find_last_not_of(blanks) - begin + 1);
+}
+
+void parseLine(Scenario& scenario, const std::string& line)
+{
+    std::string content = trim(line.substr(0, line.find('#')));
+    if (content.empty())
+    {
+        return;
+    }
+    size_t pos = content.find('=');
+    if (pos == std::string::npos)
+    {
+        throw std::invalid_argument("Expected 'key = value' but got '" + content + "'");
+    }
+    set(scenario, trim(content.substr(0, pos)), trim(content.substr(pos + 1)));
+}
+
+void load(Scenario& scenario, const std::string& fileName)
+{
+    std::ifstream file(fileName);
+    if (!file)
+    {
+        throw std::invalid_argument("Cannot open scenario file '" + fileName + "'");
+    }
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); ++lineNumber)
+    {
+        try
+        {
+            parseLine(scenario, line);
+        }
+        catch (const std::exception& ex)
+        {
+            throw std::invalid_argument(fileName + ":" + std::to_string(lineNumber) + ": " + ex.what());
+        }
+    }
+}
+
+void validate(const Scenario& scenario)
+{
+    if (scenario.coroutinePercent + scenario.ioPercent + scenario.sequencedPercent != 100)
+    {
+        throw std::invalid_argument("coroutinePercent, ioPercent and sequencedPercent must add up to 100");
+    }
+    if ((scenario.coroutinePercent < 0) || (scenario.ioPercent < 0) || (scenario.sequencedPercent < 0) ||
+        (scenario.fanOutPercent < 0) || (scenario.fanOutPercent > 100))
+    {
+        throw std::invalid_argument("Percentages must be in the range [0, 100]");
+    }
+    if ((scenario.durationMs <= 0) || (scenario.rate < 0) || (scenario.maxInFlight <= 0) ||
+        (scenario.sequenceKeys <= 0) || (scenario.fanOutWidth < 0) || (scenario.coroutineYields < 0))
+    {
+        throw std::invalid_argument("Invalid load parameters");
+    }
+}
+
+void usage(std::ostream& out)
+{
+    out << "Usage: quantumLoadGen [scenario file] [key=value ...]" << std::endl
+        << "Scenario files contain one 'key = value' pair per line. Values given on the command line override"
+        << std::endl << "the ones in the file. Available keys and their defaults:" << std::endl;
+    Scenario defaults;
+    for (const Field& field : fields())
+    {
+        out << "  " << std::left << std::setw(28) << field._name;
+        std::ostringstream value;
+        field._print(defaults, value);
+        out << std::setw(8) << value.str() << field._description << std::endl;
+    }
+}
+
+//==============================================================================
+//                                  Load
+//==============================================================================
+enum TaskKind : int { Coroutine, Io, Sequenced, NumKinds };
+const char* kindNames[NumKinds] = {"coroutine", "io", "sequenced"};
+
+/// @brief Inverse transform sampling of a Zipf distribution over [0, numKeys).
+class ZipfDistribution
+{
+public:
+    ZipfDistribution(int numKeys, double exponent) :
+        _cdf(numKeys)
+    {
+        double sum = 0;
+        for (int i = 0; i < numKeys; ++i)
+        {
+            sum += 1.0 / std::pow(i + 1, exponent);
+            _cdf[i] = sum;
+        }
+        for (double& value : _cdf)
+        {
+            value /= sum;
+        }
+    }
+
+    template <class GENERATOR>
+    int operator()(GENERATOR& generator)
+    {
+        double value = std::uniform_real_distribution<double>(0, 1)(generator);
+        auto it = std::lower_bound(_cdf.begin(), _cdf.end(), value);
+        return (int)std::min<ptrdiff_t>(it - _cdf.begin(), _cdf.size() - 1);
+    }
+
+private:
+    std::vector<double> _cdf;
+};
+
+struct Results
+{
+    Histogram               _latency[NumKinds];     //from scheduled post time to completion, in ns
+    std::atomic<size_t>     _numCompleted[NumKinds];
+    std::atomic<size_t>     _numInFlight{0};
+    std::atomic<size_t>     _numChildren{0};
+
+    Results()
+    {
+        for (auto&& num : _numCompleted)
+        {
+            num = 0;
+        }
+    }
+
+    void complete(TaskKind kind, Clock::time_point scheduled)
+    {
+        _latency[kind].record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - scheduled).count());
+        ++_numCompleted[kind];
+        --_numInFlight;
+    }
+};
+
+void burn(int us)
+{
+    auto end = Clock::now() + std::chrono::microseconds(us);
+    while (Clock::now() < end);
+}
+
+int runCoroutine(VoidContextPtr ctx, const Scenario& scenario, Results& results, bool fanOut)
+{
+    burn(scenario.coroutineWorkUs);
+    for (int i = 0; i < scenario.coroutineYields; ++i)
+    {
+        ctx->yield();
+        burn(scenario.coroutineWorkUs);
+    }
+    if (fanOut)
+    {
+        std::vector<CoroContextPtr<int>> children;
+        children.reserve(scenario.fanOutWidth);
+        for (int i = 0; i < scenario.fanOutWidth; ++i)
+        {
+            children.emplace_back(ctx->post([&scenario, &results](VoidContextPtr child)->int
+            {
+                ++results._numChildren;
+                return runCoroutine(child, scenario, results, false);
+            }));
+        }
+        for (auto&& child : children)
+        {
+            child->get(ctx);
+        }
+    }
+    return 0;
+}
+
+/// @brief Collects the largest number of objects allocated from the heap after their pool was exhausted.
+class PoolFallbackSampler
+{
+public:
+    struct Sample
+    {
+        const char*             _name;
+        std::function<size_t()> _get;
+        size_t                  _peak;
+    };
+
+    PoolFallbackSampler()
+    {
+#if !defined(__QUANTUM_BOOST_USE_SEGMENTED_STACKS) && \
+    !defined(__QUANTUM_BOOST_USE_PROTECTED_STACKS) && \
+    !defined(__QUANTUM_BOOST_USE_FIXEDSIZE_STACKS)
+        add<CoroStackAllocator>("coroutine stacks", AllocatorTraits::defaultCoroPoolAllocSize());
+#endif
+#ifndef __QUANTUM_USE_DEFAULT_ALLOCATOR
+        add<TaskAllocator>("coroutine tasks", AllocatorTraits::taskAllocSize());
+        add<IoTaskAllocator>("io tasks", AllocatorTraits::ioTaskAllocSize());
+        add<ContextAllocator>("contexts", AllocatorTraits::contextAllocSize());
+        add<PromiseAllocator>("promises", AllocatorTraits::promiseAllocSize());
+        add<FutureAllocator>("futures", AllocatorTraits::futureAllocSize());
+#endif
+        _thread = std::thread([this]()
+        {
+            while (!_stop)
+            {
+                sample();
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+        });
+    }
+
+    ~PoolFallbackSampler()
+    {
+        stop();
+    }
+
+    void stop()
+    {
+        _stop = true;
+        if (_thread.joinable())
+        {
+            _thread.join();
+            sample();
+        }
+    }
+
+    const std::vector<Sample>& getSamples() const { return _samples; }
+
+private:
+    template <class ALLOCATOR>
+    void add(const char* name, uint16_t size)
+    {
+        ALLOCATOR& allocator = Allocator<ALLOCATOR>::instance(size);
+        _samples.push_back({name, [&allocator]()->size_t { return allocator.allocatedHeapBlocks(); }, 0});
+    }
+
+    void sample()
+    {
+        for (Sample& sample : _samples)
+        {
+            sample._peak = std::max(sample._peak, sample._get());
+        }
+    }
+
+    std::vector<Sample> _samples;
+    std::atomic_bool    _stop{false};
+    std::thread         _thread;
+};
+
+double cpuSeconds()
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+void printLatency(std::ostream& out, const char* name, const Histogram& latency)
+{
+    auto us = [&latency](double percentile) { return latency.percentile(percentile) / 1000.0; };
+    out << "  " << std::left << std::setw(10) << name << std::right
+        << std::setw(10) << latency.count()
+        << std::setw(10) << us(50)
+        << std::setw(10) << us(90)
+        << std::setw(10) << us(99)
+        << std::setw(10) << us(99.9)
+        << std::setw(12) << latency.max() / 1000.0 << std::endl;
+}
+
+int run(const Scenario& scenario)
+{
+    Configuration config;
+    config.setNumCoroutineThreads(scenario.coroutineThreads);
+    config.setNumIoThreads(scenario.ioThreads);
+    config.setCoroutineSharingForAny(scenario.coroutineSharingForAny);
+    config.setLoadBalanceSharedIoQueues(scenario.loadBalanceSharedIoQueues);
+    Dispatcher dispatcher(config);
+    Sequencer<int> sequencer(dispatcher);
+    Results results;
+    PoolFallbackSampler sampler;
+
+    std::mt19937_64 generator(scenario.seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    ZipfDistribution keys(scenario.sequenceKeys, scenario.zipfExponent);
+    const std::chrono::nanoseconds interval(scenario.rate > 0 ? (int64_t)(1e9 / scenario.rate) : 0);
+    size_t numPosted = 0;
+    size_t numThrottled = 0;
+
+    const double cpuStart = cpuSeconds();
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point end = start + std::chrono::milliseconds(scenario.durationMs);
+    //Open loop: latencies are measured from the time a task was due so that a lagging generator is accounted for
+    for (Clock::time_point scheduled = start; scheduled < end; scheduled += interval)
+    {
+        Clock::time_point now = Clock::now();
+        if (interval.count() == 0)
+        {
+            scheduled = now;
+            if (scheduled >= end) break;
+        }
+        else if (scheduled > now + std::chrono::microseconds(100))
+        {
+            std::this_thread::sleep_until(scheduled);
+        }
+        else
+        {
+            while (Clock::now() < scheduled);
+        }
+        if (results._numInFlight >= (size_t)scenario.maxInFlight)
+        {
+            ++numThrottled;
+            while ((results._numInFlight >= (size_t)scenario.maxInFlight) && (Clock::now() < end))
+            {
+                std::this_thread::yield();
+            }
+        }
+        ++results._numInFlight;
+        ++numPosted;
+        int draw = percent(generator);
+        if (draw < scenario.coroutinePercent)
+        {
+            bool fanOut = percent(generator) < scenario.fanOutPercent;
+            dispatcher.post([&scenario, &results, scheduled, fanOut](VoidContextPtr ctx)->int
+            {
+                runCoroutine(ctx, scenario, results, fanOut);
+                results.complete(Coroutine, scheduled);
+                return 0;
+            });
+        }
+        else if (draw < scenario.coroutinePercent + scenario.ioPercent)
+        {
+            dispatcher.postAsyncIo([&scenario, &results, scheduled]()->int
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(scenario.ioWorkUs));
+                results.complete(Io, scheduled);
+                return 0;
+            });
+        }
+        else
+        {
+            sequencer.enqueue(keys(generator), [&scenario, &results, scheduled](VoidContextPtr)->int
+            {
+                burn(scenario.sequencedWorkUs);
+                results.complete(Sequenced, scheduled);
+                return 0;
+            });
+        }
+    }
+    const Clock::time_point generated = Clock::now();
+    while (results._numInFlight > 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    const Clock::time_point completed = Clock::now();
+    const double cpu = cpuSeconds() - cpuStart;
+    sampler.stop();
+
+    const double generationSeconds = std::chrono::duration<double>(generated - start).count();
+    const double elapsedSeconds = std::chrono::duration<double>(completed - start).count();
+    std::ostream& out = std::cout;
+    out << "Scenario:" << std::endl;
+    for (const Field& field : fields())
+    {
+        out << "  " << field._name << " = ";
+        field._print(scenario, out);
+        out << std::endl;
+    }
+    out << std::fixed << std::setprecision(1);
+    out << "Throughput:" << std::endl
+        << "  posted      " << numPosted << " tasks in " << generationSeconds << "s ("
+        << numPosted / generationSeconds << "/s, target " << scenario.rate << "/s)" << std::endl
+        << "  completed   " << numPosted << " tasks in " << elapsedSeconds << "s ("
+        << numPosted / elapsedSeconds << "/s) plus " << results._numChildren << " fan-out children" << std::endl
+        << "  throttled   " << numThrottled << " times by maxInFlight" << std::endl;
+    out << "Latency (us):" << std::endl
+        << "  " << std::left << std::setw(10) << "kind" << std::right
+        << std::setw(10) << "count" << std::setw(10) << "p50" << std::setw(10) << "p90"
+        << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(12) << "max" << std::endl;
+    Histogram total;
+    for (int kind = 0; kind < NumKinds; ++kind)
+    {
+        printLatency(out, kindNames[kind], results._latency[kind]);
+        total += results._latency[kind];
+    }
+    printLatency(out, "all", total);
+    const unsigned numCores = std::max(1u, std::thread::hardware_concurrency());
+    out << "CPU:" << std::endl
+        << "  " << cpu << "s user+system, " << 100 * cpu / elapsedSeconds << "% of one core, "
+        << 100 * cpu / elapsedSeconds / numCores << "% of " << numCores << " cores" << std::endl;
+    out << "Pool fallbacks (peak heap allocated objects):" << std::endl;
+    if (sampler.getSamples().empty())
+    {
+        out << "  none, object pools are disabled" << std::endl;
+    }
+    for (const PoolFallbackSampler::Sample& sample : sampler.getSamples())
+    {
+        out << "  " << std::left << std::setw(18) << sample._name << std::right << sample._peak << std::endl;
+    }
+    return 0;
+}
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+    Scenario scenario;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            if ((arg == "-h") || (arg == "--help"))
+            {
+                usage(std::cout);
+                return 0;
+            }
+            if (arg.find('=') != std::string::npos)
+            {
+                parseLine(scenario, arg);
+            }
+            else if (i == 1)
+            {
+                load(scenario, arg);
+            }
+            else
+            {
+                throw std::invalid_argument("Unexpected argument '" + arg + "'");
+            }
+        }
+        validate(scenario);
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        usage(std::cerr);
+        return 1;
+    }
+    return run(scenario);
+}